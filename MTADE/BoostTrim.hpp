@@ -4,15 +4,15 @@
 #include <string>
 using namespace std;
 
-//ƿռĺ˵
-//trimɾַ˵Ŀհ׷
-//trim_copyַɾ˿հ׷ַ֮ıԭַ
-//trim_copy_ifַɾ˷жϵַɾַ֮ıԭַ
-//rightֻɾҶ˵
-//leftֻɾ˵
+//此名称空间的函数说明
+//trim：删除字符串两端的空白符
+//trim_copy：返回字符串删除两端空白符之后的新字符串，不改变原字符串
+//trim_copy_if：返回字符串删除两端符合条件判断的字符，返回删除之后的新字符串，不改变原来字符串
+//right：只删除右端的
+//left：只删除左端的
 namespace BoostTrim
 {
-	//жһcharǷΪհ׷
+	//判断一个char是否为空白符
 	inline  bool is_space(char t)
 	{
 		return (t == char(9) /*HT*/ || t == char(10) || t == char(11) || t == char(13) || t == char(32)/*space*/);
@@ -0,0 +1,590 @@
+#ifndef DE_ASYNC_PROCESSORS_HPP_INCLUDED
+#define DE_ASYNC_PROCESSORS_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "boost_noncopyable.hpp"
+#include "boost_threadgroup.hpp"
+#include "evaluator.hpp"
+#include "processors.hpp"
+
+namespace de
+{
+
+	class async_promise;
+
+	/**
+	 * 异步目标函数返回的代价：在目标函数返回之后的某个时刻，由模拟器的回调、I/O线程等通过async_promise完成。
+	 *
+	 * 与std::future不同，可以用then注册完成时调用的函数，因此等待代价不需要占用线程。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class async_cost
+	{
+	private:
+		friend class async_promise;
+
+		struct state
+		{
+			std::mutex mx;
+			std::condition_variable cv;
+			bool ready;
+			double cost;
+			bool failed;
+			std::string error;
+			std::function< void(const async_cost&) > continuation;
+
+			state()
+				: ready(false), cost(0), failed(false)
+			{
+			}
+		};
+
+		std::shared_ptr< state > m_state;
+
+		explicit async_cost(std::shared_ptr< state > s)
+			: m_state(s)
+		{
+		}
+
+		void complete(double cost, bool failed, const std::string& error)
+		{
+			std::function< void(const async_cost&) > continuation;
+
+			{
+				std::lock_guard< std::mutex > lock(m_state->mx);
+
+				assert(!m_state->ready);
+
+				m_state->ready = true;
+				m_state->cost = cost;
+				m_state->failed = failed;
+				m_state->error = error;
+				continuation.swap(m_state->continuation);
+			}
+
+			m_state->cv.notify_all();
+
+			if (continuation)
+				continuation(*this);
+		}
+
+	public:
+		/**
+		 * 构造一个无效的对象
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		async_cost()
+		{
+		}
+
+		/**
+		 * 构造一个已经完成的代价，用于同步计算出代价的目标函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param cost 代价
+		 */
+		explicit async_cost(double cost)
+			: m_state(std::make_shared< state >())
+		{
+			m_state->ready = true;
+			m_state->cost = cost;
+		}
+
+		/**
+		 * 是否与一个计算关联
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool valid() const { return m_state != nullptr; }
+
+		/**
+		 * 代价是否已经完成
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool ready() const
+		{
+			assert(valid());
+
+			std::lock_guard< std::mutex > lock(m_state->mx);
+			return m_state->ready;
+		}
+
+		/**
+		 * 等待代价完成并返回它
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 *
+		 * @throw objective_function_exception 计算以错误结束
+		 */
+		double get() const
+		{
+			assert(valid());
+
+			std::unique_lock< std::mutex > lock(m_state->mx);
+			m_state->cv.wait(lock, [this]() { return m_state->ready; });
+
+			if (m_state->failed)
+				throw objective_function_exception(m_state->error);
+
+			return m_state->cost;
+		}
+
+		/**
+		 * 注册代价完成时调用的函数。已经完成时立即在调用线程中调用，否则在完成代价的线程中调用。
+		 * 只能注册一个函数。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param continuation 完成时调用的函数，参数是这个代价
+		 */
+		void then(std::function< void(const async_cost&) > continuation)
+		{
+			assert(valid());
+
+			{
+				std::lock_guard< std::mutex > lock(m_state->mx);
+
+				if (!m_state->ready)
+				{
+					assert(!m_state->continuation);
+					m_state->continuation = continuation;
+					return;
+				}
+			}
+
+			continuation(*this);
+		}
+	};
+
+	/**
+	 * 完成async_cost的一方：异步目标函数创建一个async_promise，返回get_cost()，在计算结束时调用set_cost或set_error。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class async_promise
+	{
+	private:
+		std::shared_ptr< async_cost::state > m_state;
+
+	public:
+		async_promise()
+			: m_state(std::make_shared< async_cost::state >())
+		{
+		}
+
+		/**
+		 * 返回与这个对象关联的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return async_cost
+		 */
+		async_cost get_cost() const { return async_cost(m_state); }
+
+		/**
+		 * 完成代价。完成时注册的函数在当前线程中调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param cost 代价
+		 */
+		void set_cost(double cost) { async_cost(m_state).complete(cost, false, std::string()); }
+
+		/**
+		 * 以错误结束计算，async_cost::get会抛出objective_function_exception
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param message 错误信息
+		 */
+		void set_error(const std::string& message) { async_cost(m_state).complete(0, true, message); }
+	};
+
+	inline async_cost to_async_cost(const async_cost& cost) { return cost; }
+
+	inline async_cost to_async_cost(double cost) { return async_cost(cost); }
+
+	/**
+	 * 异步目标函数的处理器集合，接口与processors< T >相同（push、start、wait、wait_until、cancel），
+	 * 可以通过async_evaluator< T >作为basic_differential_evolution的计算策略。
+	 *
+	 * 目标函数（或目标函数工厂生成的目标函数）返回async_cost，也可以接受evaluation_context；
+	 * 返回double的目标函数按同步计算处理。少数几个执行线程从队列中取出个体、调用目标函数后立即处理下一个，
+	 * 不等待代价完成，同时进行的计算最多为concurrency个。主要用于等待本地模拟器或文件的目标函数：
+	 * 几百个计算可以同时进行，而不需要同样多的阻塞线程。
+	 *
+	 * 处理器侦听器的索引是同时进行的计算的槽（0到concurrency - 1），同一个槽上的start_of和end_of不会交叠，
+	 * 因此processor_statistics_listener(concurrency)可以直接使用。start_of在执行线程中调用，end_of和error
+	 * 在完成代价的线程中调用；start和end在每一轮（start()到所有个体完成或被取消）的开始和结束时对每个槽调用。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T > class async_processors : boost::noncopyable
+	{
+	private:
+		typedef std::shared_ptr< boost::thread_group > thread_group_ptr;
+		typedef typename processor_traits< T >::value_type value_type;
+
+		std::vector< value_type > m_of;
+		const size_t m_concurrency;
+		processor_listener_ptr m_listener;
+
+		individual_queue m_indQueue;
+		thread_group_ptr m_threads;
+
+		std::mutex m_mx;
+		std::condition_variable m_cv;
+		std::vector< size_t > m_freeSlots;
+		size_t m_outstanding;
+		size_t m_generation;
+		bool m_round;
+		bool m_failed;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param executors 调用目标函数的执行线程数，每个线程有自己的目标函数（使用目标函数工厂时）
+		 * @param concurrency 同时进行的计算的最大个数
+		 * @param of 目标函数，或目标函数工厂
+		 * @param listener 处理器侦听器
+		 */
+		async_processors(size_t executors, size_t concurrency, T of, processor_listener_ptr listener)
+			: m_concurrency(concurrency), m_listener(listener), m_outstanding(0), m_generation(0), m_round(false), m_failed(false)
+		{
+			assert(executors > 0);
+			assert(concurrency > 0);
+			assert(listener);
+
+			for (size_t n = 0; n < executors; ++n)
+				m_of.push_back(processor_traits< T >::make(of));
+
+			for (size_t n = concurrency; n-- > 0;)
+				m_freeSlots.push_back(n);
+		}
+
+		/**
+		 * 等待所有进行中的计算完成（例如被放弃的计算）
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		virtual ~async_processors()
+		{
+			cancel();
+			drain();
+		}
+
+		/**
+		 * 将个体推入处理队列的底部
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param ind 个体
+		 */
+		void push(individual_ptr ind)
+		{
+			{
+				std::lock_guard< std::mutex > lock(m_mx);
+				++m_outstanding;
+			}
+
+			m_indQueue.push_back(ind);
+		}
+
+		/**
+		 * 将群体中的所有个体推入处理队列
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop
+		 */
+		void push(const population& pop)
+		{
+			for (population::size_type i = 0; i < pop.size(); ++i)
+				push(pop[i]);
+		}
+
+		/**
+		 * 启动执行线程，不等待计算完成。上一轮被放弃的计算先被等待完成。
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void start()
+		{
+			size_t generation;
+
+			// 上一轮的执行线程可能还在等待槽，不能让它们取走这一轮的个体
+			{
+				std::lock_guard< std::mutex > lock(m_mx);
+				generation = ++m_generation;
+			}
+
+			m_cv.notify_all();
+			idle();
+
+			bool abandoned;
+
+			{
+				std::lock_guard< std::mutex > lock(m_mx);
+				abandoned = m_round;
+				m_failed = false;
+				m_round = m_outstanding > 0;
+			}
+
+			// 上一轮被取消并放弃时，它的结束在这里报告
+			for (size_t n = 0; abandoned && n < m_concurrency; ++n)
+				m_listener->end(n);
+
+			for (size_t n = 0; n < m_concurrency; ++n)
+				m_listener->start(n);
+
+			if (!m_round)
+			{
+				for (size_t n = 0; n < m_concurrency; ++n)
+					m_listener->end(n);
+
+				return;
+			}
+
+			m_threads = std::make_shared< boost::thread_group >();
+
+			for (size_t n = 0; n < m_of.size(); ++n)
+				m_threads->add_thread(new std::thread([this, n, generation]() { execute(n, generation); }));
+		}
+
+		/**
+		 * 最多等待到deadline，参见processors< T >::wait_until
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param deadline 等待的截止时间
+		 *
+		 * @return bool 如果所有计算都已完成，则为true
+		 */
+		template< typename Clock, typename Duration > bool wait_until(const std::chrono::time_point< Clock, Duration >& deadline)
+		{
+			{
+				std::unique_lock< std::mutex > lock(m_mx);
+
+				if (!m_cv.wait_until(lock, deadline, [this]() { return m_outstanding == 0; }))
+					return false;
+			}
+
+			wait();
+			return true;
+		}
+
+		/**
+		 * 等待所有计算完成
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @throw processors_exception 有目标函数出错
+		 */
+		void wait()
+		{
+			drain();
+
+			if (m_failed)
+				throw processors_exception("objective function error");
+		}
+
+		/**
+		 * 删除队列中还没有开始计算的个体，进行中的计算继续，参见processors< T >::cancel
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t 被删除的个体数
+		 */
+		size_t cancel()
+		{
+			const size_t count(m_indQueue.clear());
+
+			finish(count);
+
+			return count;
+		}
+
+		/**
+		 * 返回同时进行的计算的最大个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t concurrency() const { return m_concurrency; }
+
+		/**
+		 * 指向处理器集合的智能指针。
+		 */
+		typedef std::shared_ptr< async_processors< T > > processors_ptr;
+
+	private:
+		// 等待上一轮进行中的计算完成（队列中新推入的个体不受影响），并等待执行线程结束
+		void idle()
+		{
+			{
+				std::unique_lock< std::mutex > lock(m_mx);
+				m_cv.wait(lock, [this]() { return m_freeSlots.size() == m_concurrency; });
+			}
+
+			if (m_threads)
+			{
+				m_threads->join_all();
+				m_threads.reset();
+			}
+		}
+
+		// 等待所有推入的个体完成或被取消，并等待执行线程结束
+		void drain()
+		{
+			{
+				std::unique_lock< std::mutex > lock(m_mx);
+				m_cv.wait(lock, [this]() { return m_outstanding == 0; });
+			}
+
+			if (m_threads)
+			{
+				m_threads->join_all();
+				m_threads.reset();
+			}
+		}
+
+		// count个个体完成或被取消；最后一个个体结束时这一轮结束。计数减少之后析构函数可能立即返回，
+		// 因此侦听器在计数减少之前调用，通知在持有锁时发出
+		void finish(size_t count)
+		{
+			if (count == 0)
+				return;
+
+			std::unique_lock< std::mutex > lock(m_mx);
+
+			assert(m_outstanding >= count);
+
+			// 最后的个体结束时没有其他个体可以结束，解锁调用侦听器是安全的
+			if (m_outstanding == count && m_round)
+			{
+				m_round = false;
+
+				lock.unlock();
+				for (size_t n = 0; n < m_concurrency; ++n)
+					m_listener->end(n);
+				lock.lock();
+			}
+
+			m_outstanding -= count;
+			m_cv.notify_all();
+		}
+
+		void release(size_t slot, bool failed)
+		{
+			std::lock_guard< std::mutex > lock(m_mx);
+
+			m_freeSlots.push_back(slot);
+			m_failed = m_failed || failed;
+		}
+
+		void execute(size_t n, size_t generation)
+		{
+			for (;;)
+			{
+				size_t slot;
+
+				// 先占用一个槽再取个体，同时进行的计算不会超过concurrency
+				{
+					std::unique_lock< std::mutex > lock(m_mx);
+					m_cv.wait(lock, [this, generation]() { return !m_freeSlots.empty() || m_outstanding == 0 || m_generation != generation; });
+
+					if (m_freeSlots.empty() || m_generation != generation)
+						return;
+
+					slot = m_freeSlots.back();
+					m_freeSlots.pop_back();
+				}
+
+				individual_ptr ind(m_indQueue.pop());
+
+				if (!ind)
+				{
+					{
+						std::lock_guard< std::mutex > lock(m_mx);
+						m_freeSlots.push_back(slot);
+					}
+
+					// 其他等待槽的执行线程也会发现队列已空
+					m_cv.notify_all();
+					return;
+				}
+
+				m_listener->start_of(slot, ind);
+
+				async_cost cost;
+
+				try
+				{
+					ind->context().start();
+					cost = to_async_cost(processor_traits< T >::run(m_of[n], ind->vars(), ind->context()));
+				}
+				catch (const objective_function_exception& e)
+				{
+					m_listener->error(slot, e.what());
+					release(slot, true);
+					finish(1);
+					continue;
+				}
+
+				cost.then([this, slot, ind](const async_cost& c)
+				{
+					bool failed(false);
+
+					try
+					{
+						ind->setCost(c.get());
+						m_listener->end_of(slot, ind);
+					}
+					catch (const objective_function_exception& e)
+					{
+						m_listener->error(slot, e.what());
+						failed = true;
+					}
+
+					release(slot, failed);
+					finish(1);
+				});
+			}
+		}
+	};
+
+	/**
+	 * 使用异步处理器集合的计算策略
+	 */
+	template< typename T > using async_evaluator = parallel_evaluator< T, async_processors< T > >;
+
+}
+
+#endif //DE_ASYNC_PROCESSORS_HPP_INCLUDED
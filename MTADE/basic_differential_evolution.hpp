@@ -0,0 +1,515 @@
+#ifndef DE_BASIC_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
+#define DE_BASIC_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include "BoostTrim.hpp"
+#include "random_generator.hpp"
+#include "multithread.hpp"
+#include "individual.hpp"
+#include "evaluator.hpp"
+#include "mutation_strategy.hpp"
+#include "population.hpp"
+#include "selection_strategy.hpp"
+#include "termination_strategy.hpp"
+#include "run_statistics.hpp"
+#include "constraint_table.hpp"
+#include "feasibility.hpp"
+#include "population_size_strategy.hpp"
+#include "listener.hpp"
+
+namespace de
+{
+
+	/**
+	 * 优化过程期间发生错误时将抛出异常。
+	 *
+	 * @author louiehan (11/11/2019)
+	 */
+	class differential_evolution_exception
+	{
+	};
+
+	template< typename M > selection_listener_ptr mutation_selection_listener(M& mutation, std::true_type)
+	{
+		// 别名构造：不拥有对象，变异策略的生存期由引擎管理
+		return selection_listener_ptr(selection_listener_ptr(), &mutation);
+	}
+
+	template< typename M > selection_listener_ptr mutation_selection_listener(M& mutation, std::false_type)
+	{
+		return selection_listener_ptr();
+	}
+
+	/**
+	 * 返回变异策略作为选择监听器的非拥有指针：变异策略派生自selection_listener（例如SHADE）时
+	 * 指向它本身，否则为空。运行时多态的变异策略（dynamic_mutation）重载了这个函数。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param mutation 变异策略
+	 *
+	 * @return selection_listener_ptr
+	 */
+	template< typename M > selection_listener_ptr mutation_selection_listener(M& mutation)
+	{
+		return mutation_selection_listener(mutation, std::is_base_of< selection_listener, M >());
+	}
+
+	template< typename L > void attach_statistics(L& listener, run_statistics_ptr stats, std::true_type)
+	{
+		listener.attach(stats);
+	}
+
+	template< typename L > void attach_statistics(L& listener, run_statistics_ptr stats, std::false_type)
+	{
+	}
+
+	/**
+	 * 侦听器派生自statistics_listener时把运行统计交给它。运行时多态的侦听器（dynamic_listener）重载了这个函数。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param listener 侦听器
+	 * @param stats 运行统计
+	 */
+	template< typename L > void attach_statistics(L& listener, run_statistics_ptr stats)
+	{
+		attach_statistics(listener, stats, std::is_base_of< statistics_listener, L >());
+	}
+
+	template< typename S > bool one_to_one_selection(const S& selection, std::true_type)
+	{
+		return selection.one_to_one();
+	}
+
+	template< typename S > bool one_to_one_selection(const S& selection, std::false_type)
+	{
+		return false;
+	}
+
+	/**
+	 * 选择策略是否是一对一的（见selection_strategy::one_to_one），是时差分进化为试验个体设定截断代价。
+	 * 不派生自selection_strategy的选择策略按不是一对一的处理；运行时多态的选择策略（dynamic_selection）重载了这个函数。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param selection 选择策略
+	 *
+	 * @return bool
+	 */
+	template< typename S > bool one_to_one_selection(const S& selection)
+	{
+		return one_to_one_selection(selection, std::is_base_of< selection_strategy, S >());
+	}
+
+	/**
+	 * 基于策略（policy）的差分进化引擎
+	 *
+	 * 变异、选择、终止、侦听和目标函数计算都是模板参数，以值的方式保存在引擎中，每代和每个个体的调用
+	 * 都是静态绑定的，可以被内联；例如quiet_listener的空函数在编译后不产生任何代码。交叉策略是变异策略的
+	 * 模板参数（见basic_mutation_strategy_1等）。
+	 *
+	 * 策略的接口与同名的运行时多态类相同：
+	 *   Mutation：start_generation(pop, minimize)、operator()(pop, best, i)、resize(popSize)、set_constraint_table(table)、repairs_trials()
+	 *   Selection：operator()(pop1, pop2, bestInd, minimize, listener)，派生自selection_strategy时还有one_to_one()
+	 *   Termination：event(const run_statistics&)
+	 *   Listener：listener的所有成员函数
+	 *   Evaluator：见serial_evaluator
+	 * 因此mutation_strategy_1、best_parent_child_selection_strategy、max_gen_termination_strategy、quiet_listener等
+	 * 可以直接作为策略使用。
+	 *
+	 * differential_evolution< T >是这个引擎的运行时多态版本：它的策略是转发到shared_ptr的适配器。
+	 *
+	 * 模板参数Objective是目标函数的类型，只用于缺省的计算策略（在调用线程中串行计算）。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename Objective, typename Mutation, typename Selection, typename Termination, typename Listener = quiet_listener, typename Evaluator = serial_evaluator< Objective > >
+	class basic_differential_evolution : boost::noncopyable
+	{
+	private:
+		const size_t m_varCount;
+		size_t m_popSize;
+
+		population_ptr m_pop1;
+		population_ptr m_pop2;
+		individual_ptr m_bestInd;
+
+		constraints_ptr m_constraints;
+		constraint_table_ptr m_constraintTable;
+		std::vector< de::DVectorPtr > m_origins;
+
+		Evaluator m_evaluator;
+		Termination m_termination;
+		Selection m_selection;
+		Mutation m_mutation;
+		Listener m_listener;
+
+		run_statistics_ptr m_statistics;
+		population_size_strategy_ptr m_populationSizeStrategy;
+
+		feasibility_rule_ptr m_feasibility;
+		population m_admitted;
+		size_t m_rejected;
+		const bool m_cutoffs;
+
+		const bool m_minimize;
+
+	public:
+		/**
+		 * 构造一个basic_differential_evolution对象，并计算初始种群
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param varCount 变量总数；
+		 * @param popSize 在一个种群中的所有个体的数量；
+		 * @param evaluator 计算策略；
+		 * @param constraints 约束向量；
+		 * @param minimize 如果为true，将尝试最小化成本；如果为false，则将尝试最大化成本；
+		 * @param termination 终止策略；
+		 * @param selection 选择策略；
+		 * @param mutation 变异策略；
+		 * @param listener 侦听器；
+		 * @param populationSizeStrategy 可选的种群规模策略，为空时种群规模保持不变。
+		 * @param feasibility 可选的可行性规则：计算非线性约束的违反程度，违反程度过大的个体不计算目标函数。
+		 *					  选择策略应该使用同一个规则（见feasibility_selection_strategy）。
+		 * @param initial 可选的初始种群，包含popSize个有变量的个体，为空时在约束范围内随机生成；例如重启时在已知的最佳个体附近播种。
+		 */
+		basic_differential_evolution(size_t varCount, size_t popSize, const Evaluator& evaluator, constraints_ptr constraints, bool minimize,
+			const Termination& termination, const Selection& selection, const Mutation& mutation, const Listener& listener = Listener(),
+			population_size_strategy_ptr populationSizeStrategy = population_size_strategy_ptr(), feasibility_rule_ptr feasibility = feasibility_rule_ptr(),
+			population_ptr initial = population_ptr())
+			try
+
+			: m_varCount(varCount), m_popSize(popSize), m_pop1(initial ? initial : std::make_shared< population >(popSize, varCount, constraints)),
+			m_pop2(std::make_shared< population >(popSize, varCount)), m_bestInd(m_pop1->best(minimize)),
+			m_constraints(constraints), m_constraintTable(std::make_shared< constraint_table >(*constraints)), m_origins(popSize),
+			m_evaluator(evaluator), m_termination(termination), m_selection(selection), m_mutation(mutation), m_listener(listener),
+			m_statistics(std::make_shared< run_statistics >(minimize, mutation_selection_listener(m_mutation))),
+			m_populationSizeStrategy(populationSizeStrategy), m_feasibility(feasibility), m_admitted(1, varCount), m_rejected(0),
+			m_cutoffs(one_to_one_selection(selection)), m_minimize(minimize)
+		{
+			assert(constraints);
+			assert(popSize > 0);
+			assert(varCount > 0);
+			assert(m_pop1->size() == popSize);
+
+			// 变异策略生成试验个体时只修复交叉改变了的变量
+			m_mutation.set_constraint_table(m_constraintTable);
+
+			//通过使用初始随机参数运行所有目标函数来初始化总体1。
+			size_t evaluated(0), cutoffs(0), censored(0);
+			evaluate(*m_pop1, population_ptr(), std::chrono::steady_clock::time_point::max(), stop_token(), cancellation::drain, evaluated, cutoffs, censored);
+
+			m_bestInd = m_feasibility ? m_feasibility->best(*m_pop1, minimize) : m_pop1->best(minimize);
+			m_statistics->init(*m_pop1, m_bestInd, evaluated);
+			attach_statistics(m_listener, m_statistics);
+		}
+		catch (const processors_exception&)
+		{
+			throw differential_evolution_exception();
+		}
+		catch (const objective_function_exception&)
+		{
+			throw differential_evolution_exception();
+		}
+
+		virtual ~basic_differential_evolution()
+		{
+		}
+
+		/**
+		 * 启动差分进化优化过程。
+		 *
+		 * 尽管处理是并行进行的，但此函数是同步的，并且在优化完成或错误触发异常之前不会返回。
+		 *
+		 * @author louiehan (11/11/2019)
+		 */
+		void run()
+		{
+			run_until(std::chrono::steady_clock::time_point::max());
+		}
+
+		/**
+		 * 在指定的时间内运行优化过程，参见run_until。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param duration 运行时间的上限
+		 * @param token 停止令牌
+		 * @param mode 停止时如何处理正在进行的计算
+		 *
+		 * @return bool 如果终止策略结束了优化过程，则为true；如果提前停止，则为false
+		 */
+		template< typename Rep, typename Period > bool run_for(const std::chrono::duration< Rep, Period >& duration, stop_token token = stop_token(), cancellation mode = cancellation::drain)
+		{
+			return run_until(std::chrono::steady_clock::now() + std::chrono::duration_cast< std::chrono::steady_clock::duration >(duration), token, mode);
+		}
+
+		/**
+		 * 运行优化过程，直到终止策略要求停止、到达截止时间或收到停止请求。
+		 *
+		 * 截止时间和停止请求在每一代开始之前以及计算期间检查。提前停止时不再开始新的计算，
+		 * 按mode等待或放弃正在进行的计算，丢弃未完成的一代；best()返回最后一个完整的代之后的最佳个体。
+		 * 之后可以再次调用run_until继续优化。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param deadline 截止时间
+		 * @param token 停止令牌
+		 * @param mode 停止时如何处理正在进行的计算
+		 *
+		 * @return bool 如果终止策略结束了优化过程，则为true；如果提前停止，则为false
+		 */
+		bool run_until(std::chrono::steady_clock::time_point deadline, stop_token token = stop_token(), cancellation mode = cancellation::drain)
+		{
+			try
+			{
+				m_listener.start();
+				m_statistics->start();
+				individual_ptr bestIndIteration(m_bestInd);
+				bool completed(true);
+
+				for (size_t genCount = 0; m_termination.event(*m_statistics); ++genCount)
+				{
+					if (token.stop_requested() || std::chrono::steady_clock::now() >= deadline)
+					{
+						completed = false;
+						break;
+					}
+
+					m_listener.startGeneration(genCount);
+					m_mutation.start_generation(*m_pop1, m_minimize);
+
+					for (size_t i = 0; i < m_popSize; ++i)
+					{
+						mutation_strategy::mutation_info mutationInfo(m_mutation(*m_pop1, bestIndIteration, i));
+
+						// 暂时将tempInd放在一个vector容器中（它们在处理之前是空的），在处理之后将被移动到正确的位置。
+						(*m_pop2)[i] = std::get< 0 >(mutationInfo);
+						m_origins[i] = std::get< 1 >(mutationInfo);
+					}
+
+					// 变异策略没有在生成时修复试验个体，用扁平的约束表成批修复整代的试验个体
+					if (!m_mutation.repairs_trials())
+						m_constraintTable->repair(*m_pop2, m_origins);
+
+					m_listener.startProcessors(genCount);
+
+					size_t evaluated(0), cutoffs(0), censored(0);
+					if (!evaluate(*m_pop2, m_pop1, deadline, token, mode, evaluated, cutoffs, censored))
+					{
+						completed = false;
+						break;
+					}
+
+					m_listener.endProcessors(genCount);
+
+					m_listener.startSelection(genCount);
+					m_selection(m_pop1, m_pop2, m_bestInd, m_minimize, m_statistics);
+					bestIndIteration = m_bestInd;
+
+					m_listener.endSelection(genCount);
+
+					m_statistics->end_generation(evaluated, m_bestInd, cutoffs, censored);
+					resize();
+
+					m_listener.endGeneration(genCount, bestIndIteration, m_bestInd);
+				}
+
+				m_listener.end();
+
+				return completed;
+			}
+			catch (const processors_exception&)
+			{
+				m_listener.error();
+				throw differential_evolution_exception();
+			}
+			catch (const objective_function_exception&)
+			{
+				m_listener.error();
+				throw differential_evolution_exception();
+			}
+		}
+
+		/**
+		 * 返回优化过程产生的最佳个体。
+		 *
+		 * @author louiehan (11/11/2019)
+		 *
+		 * @return individual_ptr
+		 */
+		individual_ptr best() const { return m_bestInd; }
+
+		/**
+		 * 返回当前的种群规模
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t population_size() const { return m_popSize; }
+
+		/**
+		 * 返回到目前为止目标函数的计算次数，包括初始种群
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t evaluations() const { return m_statistics->evaluations(); }
+
+		/**
+		 * 返回被可行性规则拒绝、没有计算目标函数的个体数，包括初始种群；提前停止时被丢弃的一代不计入
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t rejected() const { return m_rejected; }
+
+		/**
+		 * 返回增量维护的运行统计
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const run_statistics&
+		 */
+		const run_statistics& statistics() const { return *m_statistics; }
+
+		/**
+		 * 返回变异策略
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return Mutation&
+		 */
+		Mutation& mutation() { return m_mutation; }
+
+		/**
+		 * 返回侦听器
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return Listener&
+		 */
+		Listener& listener() { return m_listener; }
+
+	private:
+		/**
+		 * 计算种群中个体的代价。设置了可行性规则时，先在当前线程中计算每个个体的违反程度，
+		 * 只把规则接受的个体交给计算策略，其余的个体的代价设为最差值。
+		 *
+		 * 选择策略是一对一的时，同一索引的父个体的代价是试验个体的截断代价；可行性规则不接受父个体时，
+		 * 试验个体无论代价如何都会胜出，不设截断代价。
+		 *
+		 * @param evaluated 返回计算了目标函数的个体数
+		 * @param cutoffs 返回其中有截断代价的个体数
+		 * @param censored 返回其中代价被截断的个体数
+		 *
+		 * @return bool 与计算策略相同，提前停止时为false
+		 */
+		bool evaluate(population& pop, population_ptr parents, std::chrono::steady_clock::time_point deadline, const stop_token& token, cancellation mode,
+			size_t& evaluated, size_t& cutoffs, size_t& censored)
+		{
+			if (m_feasibility)
+				m_feasibility->start_generation(m_statistics->generation());
+
+			for (population::size_type i = 0; i < pop.size(); ++i)
+			{
+				if (m_cutoffs && parents && (!m_feasibility || m_feasibility->admits(*(*parents)[i])))
+					pop[i]->context().set_cutoff((*parents)[i]->cost(), m_minimize);
+				else
+					pop[i]->context().clear_cutoff();
+			}
+
+			population* targets(&pop);
+			size_t rejected(0);
+
+			if (m_feasibility)
+			{
+				m_admitted.clear();
+
+				for (population::size_type i = 0; i < pop.size(); ++i)
+				{
+					m_feasibility->evaluate(*pop[i]);
+
+					if (m_feasibility->admits(*pop[i]))
+						m_admitted.push_back(pop[i]);
+					else
+					{
+						pop[i]->setCost(feasibility_rule::rejected_cost(m_minimize));
+						++rejected;
+					}
+				}
+
+				targets = &m_admitted;
+			}
+
+			evaluated = targets->size();
+			cutoffs = 0;
+			censored = 0;
+
+			if (!targets->empty() && !m_evaluator(*targets, deadline, token, mode))
+				return false;
+
+			for (population::size_type i = 0; i < targets->size(); ++i)
+			{
+				if ((*targets)[i]->context().has_cutoff())
+					++cutoffs;
+
+				if ((*targets)[i]->censored())
+					++censored;
+			}
+
+			// 只有完成的一代才计入，提前停止时这一代被丢弃
+			m_rejected += rejected;
+
+			return true;
+		}
+
+		/**
+		 * 按种群规模策略缩小两个种群：m_pop1保留最好的个体（有可行性规则时按它比较），m_pop2只截短，
+		 * 它的内容在下一代会被覆盖。两个容器都不会重新分配内存。变异策略随后缩小它与种群规模成比例的数据。
+		 */
+		void resize()
+		{
+			if (!m_populationSizeStrategy)
+				return;
+
+			size_t popSize(std::min(m_popSize, (*m_populationSizeStrategy)(m_statistics->evaluations())));
+
+			if (popSize < m_popSize)
+			{
+				if (m_feasibility)
+				{
+					const feasibility_rule_ptr rule(m_feasibility);
+					const bool minimize(m_minimize);
+					m_pop1->shrink(popSize, [rule, minimize](const individual_ptr& ind1, const individual_ptr& ind2) { return rule->better(ind1, ind2, minimize); });
+				}
+				else
+					m_pop1->shrink(popSize, m_minimize);
+
+				m_pop2->resize(popSize);
+				m_popSize = popSize;
+				m_statistics->resize(popSize);
+				m_mutation.resize(popSize);
+			}
+		}
+	};
+
+}
+
+#endif //DE_BASIC_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
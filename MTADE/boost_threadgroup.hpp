@@ -8,8 +8,8 @@
 
 namespace boost
 {
-	//boost::thread_group
-	//ʹstd::threadboost::thread,std::mutexboost::shared_mutex
+	//兼容boost::thread_group
+	//使用std::thread代替boost::thread,std::mutex代替boost::shared_mutex
 	class thread_group
 	{
 	private:
@@ -58,7 +58,8 @@ namespace boost
 			std::lock_guard<std::mutex> guard(m);
 			for (auto it = threads.begin(), end = threads.end(); it != end; ++it)
 			{
-				(*it)->join();
+				if ((*it)->joinable())
+					(*it)->join();
 			}
 		}
 
@@ -0,0 +1,395 @@
+#ifndef DE_CONSTRAINT_TABLE_HPP_INCLUDED
+#define DE_CONSTRAINT_TABLE_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "de_constraints.hpp"
+#include "population.hpp"
+
+namespace de
+{
+
+	/**
+	 * 由约束集合编译而成的扁平约束表，用于批量修复越界的变量。
+	 *
+	 * 约束类（real_constraint、int_constraint、set_constraint、boolean_constraint）仍然是约束的定义；
+	 * 构造时按类型把变量分到不同的通道：实数和整数通道保存连续的上下限数组，集合通道保存扁平的取值表，
+	 * 布尔通道只保存索引。修复时按通道成批处理，不再经过shared_ptr的虚函数调用、下标检查和字符串流；
+	 * 其它类型的约束放在通用通道中，仍然调用虚函数。
+	 *
+	 * 修复的规则与约束类相同：范围通道的越界值按每个约束的修复方式（repair_mode）修复（整数通道先取整），
+	 * 集合和布尔通道每次都随机取值。
+	 *
+	 * 约束表是约束集合的快照，编译之后对约束集合的修改不会反映到约束表中。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class constraint_table
+	{
+	private:
+		enum lane_kind : unsigned char { real_lane, int_lane, set_lane, bool_lane, generic_lane };
+
+		struct range_lane
+		{
+			std::vector< size_t > index;
+			std::vector< double > min;
+			std::vector< double > max;
+			std::vector< repair_mode > mode;
+
+			void add(size_t j, const range_constraint& c)
+			{
+				index.push_back(j);
+				min.push_back(c.min());
+				max.push_back(c.max());
+				mode.push_back(c.get_repair_mode());
+			}
+
+			// 所有的变量使用同一种修复方式时为true
+			bool uniform() const
+			{
+				return std::adjacent_find(mode.begin(), mode.end(), std::not_equal_to< repair_mode >()) == mode.end();
+			}
+		};
+
+		size_t m_size;
+
+		range_lane m_real;
+		range_lane m_int;
+
+		// 所有的变量都是实数约束并且修复方式相同时，实数通道的索引就是变量的索引，可以直接按变量顺序处理
+		bool m_dense;
+		repair_mode m_denseMode;
+
+		std::vector< size_t > m_setIndex;
+		std::vector< size_t > m_setOffset;
+		std::vector< size_t > m_setCount;
+		std::vector< double > m_setValues;
+
+		std::vector< size_t > m_boolIndex;
+
+		std::vector< size_t > m_genericIndex;
+		std::vector< constraint_ptr > m_generic;
+
+		// 每个变量所在的通道和在通道中的位置，用于修复单个变量
+		std::vector< lane_kind > m_lane;
+		std::vector< size_t > m_slot;
+
+	public:
+		/**
+		 * 编译约束集合
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param c 约束集合
+		 */
+		explicit constraint_table(const constraints& c)
+			: m_size(c.size()), m_dense(false), m_denseMode(repair_mode::random), m_lane(c.size()), m_slot(c.size())
+		{
+			for (constraints::size_type j = 0; j < c.size(); ++j)
+			{
+				const constraint_ptr& ct(c[j]);
+				assert(ct);
+
+				if (const int_constraint* ic = dynamic_cast< const int_constraint* >(ct.get()))
+				{
+					m_lane[j] = int_lane;
+					m_slot[j] = m_int.index.size();
+					m_int.add(j, *ic);
+				}
+				else if (const real_constraint* rc = dynamic_cast< const real_constraint* >(ct.get()))
+				{
+					m_lane[j] = real_lane;
+					m_slot[j] = m_real.index.size();
+					m_real.add(j, *rc);
+				}
+				else if (const set_constraint* sc = dynamic_cast< const set_constraint* >(ct.get()))
+				{
+					if (sc->values().empty())
+						throw constraints_exception("could not compile an empty set constraint");
+
+					m_lane[j] = set_lane;
+					m_slot[j] = m_setIndex.size();
+					m_setIndex.push_back(j);
+					m_setOffset.push_back(m_setValues.size());
+					m_setCount.push_back(sc->values().size());
+					m_setValues.insert(m_setValues.end(), sc->values().begin(), sc->values().end());
+				}
+				else if (dynamic_cast< const boolean_constraint* >(ct.get()))
+				{
+					m_lane[j] = bool_lane;
+					m_slot[j] = m_boolIndex.size();
+					m_boolIndex.push_back(j);
+				}
+				else
+				{
+					m_lane[j] = generic_lane;
+					m_slot[j] = m_genericIndex.size();
+					m_genericIndex.push_back(j);
+					m_generic.push_back(ct);
+				}
+			}
+
+			m_dense = m_real.index.size() == m_size && m_real.uniform();
+
+			if (m_dense && m_size > 0)
+				m_denseMode = m_real.mode.front();
+		}
+
+		/**
+		 * 返回变量的个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t size() const { return m_size; }
+
+		/**
+		 * 返回实数通道中的变量个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t real_count() const { return m_real.index.size(); }
+
+		/**
+		 * 返回整数通道中的变量个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t int_count() const { return m_int.index.size(); }
+
+		/**
+		 * 返回集合通道中的变量个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t set_count() const { return m_setIndex.size(); }
+
+		/**
+		 * 返回布尔通道中的变量个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t bool_count() const { return m_boolIndex.size(); }
+
+		/**
+		 * 返回通用通道（其它类型的约束）中的变量个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t generic_count() const { return m_genericIndex.size(); }
+
+		/**
+		 * 修复一个试验个体的变量
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param vars 要修复的变量
+		 * @param origin 原值，越界时新值在边界和原值之间
+		 */
+		void repair(DVector& vars, const DVector& origin) const
+		{
+			assert(vars.size() == m_size);
+			assert(origin.size() == m_size);
+
+			Double* v(vars.data());
+			const Double* o(origin.data());
+
+			if (m_dense)
+				repair_dense(v, o);
+			else
+			{
+				repair_real(v, o);
+				repair_int(v, o);
+				repair_set(v);
+				repair_bool(v);
+				repair_generic(v, o);
+			}
+		}
+
+		/**
+		 * 修复单个变量，用于只修复交叉改变了的变量（见mutation_strategy的试验个体生成核）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param j 变量的索引
+		 * @param value 变量的新值
+		 * @param origin 原值，越界时新值在边界和原值之间
+		 *
+		 * @return double 修复后的值，没有越界时就是value
+		 */
+		double repair(size_t j, double value, double origin) const
+		{
+			assert(j < m_size);
+
+			const size_t k(m_slot[j]);
+
+			switch (m_lane[j])
+			{
+			case real_lane:
+				return real_value(k, value, origin);
+			case int_lane:
+				return int_value(k, value, origin);
+			case set_lane:
+				return set_value(k);
+			case bool_lane:
+				return bool_value();
+			default:
+				return m_generic[k]->get_rand_value(value, origin);
+			}
+		}
+
+		/**
+		 * 修复一批试验个体的变量
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param trials 试验个体
+		 * @param origins 每个试验个体的原值，与trials一一对应
+		 */
+		void repair(const population& trials, const std::vector< DVectorPtr >& origins) const
+		{
+			assert(trials.size() <= origins.size());
+
+			for (population::size_type i = 0; i < trials.size(); ++i)
+				repair(*trials[i]->vars(), *origins[i]);
+		}
+
+	private:
+		void repair_dense(Double* v, const Double* o) const
+		{
+			const double* lo(m_real.min.data());
+			const double* hi(m_real.max.data());
+
+			// 截断不需要先检查，直接对所有的变量做没有分支的min/max
+			if (m_denseMode == repair_mode::clamp)
+			{
+				for (size_t j = 0; j < m_size; ++j)
+					v[j] = std::min(hi[j], std::max(lo[j], double(v[j])));
+
+				return;
+			}
+
+			// 先用没有分支的循环检查是否有越界的变量，大多数试验个体不需要修复
+			bool out(false);
+			for (size_t j = 0; j < m_size; ++j)
+				out |= (v[j] < lo[j]) | (v[j] > hi[j]);
+
+			if (!out)
+				return;
+
+			for (size_t j = 0; j < m_size; ++j)
+			{
+				if (v[j] < lo[j] || v[j] > hi[j])
+					v[j] = repair_range(m_denseMode, v[j], lo[j], hi[j], o[j]);
+			}
+		}
+
+		double real_value(size_t k, double value, double origin) const
+		{
+			if (value < m_real.min[k] || value > m_real.max[k])
+				return repair_range(m_real.mode[k], value, m_real.min[k], m_real.max[k], origin);
+
+			return value;
+		}
+
+		double int_value(size_t k, double value, double origin) const
+		{
+			const double lo(m_int.min[k]);
+			const double hi(m_int.max[k]);
+
+			value = std::round(value);
+
+			if (value < lo || value > hi)
+			{
+				value = std::round(repair_range(m_int.mode[k], value, lo, hi, origin));
+
+				// 取整后可能越过不是整数的边界
+				if (value < lo)
+					value = std::ceil(lo);
+				else if (value > hi)
+					value = std::floor(hi);
+			}
+
+			return value;
+		}
+
+		double set_value(size_t k) const
+		{
+			std::uniform_int_distribution< size_t > dist(0, m_setCount[k] - 1);
+			return m_setValues[m_setOffset[k] + dist(generator())];
+		}
+
+		static double bool_value()
+		{
+			return genrand() < 0.5;
+		}
+
+		void repair_real(Double* v, const Double* o) const
+		{
+			for (size_t k = 0; k < m_real.index.size(); ++k)
+			{
+				const size_t j(m_real.index[k]);
+				v[j] = real_value(k, v[j], o[j]);
+			}
+		}
+
+		void repair_int(Double* v, const Double* o) const
+		{
+			for (size_t k = 0; k < m_int.index.size(); ++k)
+			{
+				const size_t j(m_int.index[k]);
+				v[j] = int_value(k, v[j], o[j]);
+			}
+		}
+
+		void repair_set(Double* v) const
+		{
+			for (size_t k = 0; k < m_setIndex.size(); ++k)
+				v[m_setIndex[k]] = set_value(k);
+		}
+
+		void repair_bool(Double* v) const
+		{
+			for (size_t k = 0; k < m_boolIndex.size(); ++k)
+				v[m_boolIndex[k]] = bool_value();
+		}
+
+		void repair_generic(Double* v, const Double* o) const
+		{
+			for (size_t k = 0; k < m_genericIndex.size(); ++k)
+			{
+				const size_t j(m_genericIndex[k]);
+				v[j] = m_generic[k]->get_rand_value(v[j], o[j]);
+			}
+		}
+	};
+
+	/**
+	 * 指向约束表的智能指针
+	 */
+	typedef std::shared_ptr< constraint_table > constraint_table_ptr;
+
+}
+
+#endif //DE_CONSTRAINT_TABLE_HPP_INCLUDED
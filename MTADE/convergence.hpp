@@ -0,0 +1,205 @@
+#ifndef DE_CONVERGENCE_HPP_INCLUDED
+#define DE_CONVERGENCE_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "individual.hpp"
+#include "listener.hpp"
+#include "run_statistics.hpp"
+
+namespace de
+{
+
+	/**
+	 * 记录一组目标代价第一次被达到时的计算次数的监听器。
+	 *
+	 * 在每一代结束时检查当前最佳个体。计算次数取自差分进化的运行统计（见statistics_listener），
+	 * 种群规模缩小（population_size_strategy）时也是准确的；没有交给运行统计时按代计算：初始种群的
+	 * popSize次加上每一代的popSize次。目标代价在最小化时表示"代价小于或等于目标"，最大化时表示"大于或等于目标"。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class target_listener : public quiet_listener, public statistics_listener
+	{
+	private:
+		const std::vector< double > m_targets;
+		const size_t m_popSize;
+		const bool m_minimize;
+
+		std::vector< size_t > m_hits;
+		size_t m_evaluations;
+		run_statistics_ptr m_statistics;
+
+	public:
+		/**
+		 * 表示目标没有达到的计算次数
+		 */
+		static size_t not_reached() { return std::numeric_limits< size_t >::max(); }
+
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param targets 目标代价
+		 * @param popSize 种群规模，没有运行统计时用于计算次数
+		 * @param minimize 如果为true，代价越小越好，否则代价越大越好
+		 */
+		target_listener(const std::vector< double >& targets, size_t popSize, bool minimize)
+			: m_targets(targets), m_popSize(popSize), m_minimize(minimize), m_hits(targets.size(), not_reached()), m_evaluations(popSize)
+		{
+		}
+
+		virtual void endGeneration(size_t genCount, individual_ptr bestIndGen, individual_ptr bestInd)
+		{
+			assert(bestInd);
+
+			m_evaluations = m_statistics ? m_statistics->evaluations() : m_popSize * (genCount + 2);
+
+			for (size_t t = 0; t < m_targets.size(); ++t)
+			{
+				if (m_hits[t] == not_reached() && (m_minimize ? bestInd->cost() <= m_targets[t] : bestInd->cost() >= m_targets[t]))
+					m_hits[t] = m_evaluations;
+			}
+		}
+
+		virtual void attach(run_statistics_ptr stats)
+		{
+			m_statistics = stats;
+		}
+
+		/**
+		 * 返回目标的个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t targets() const { return m_targets.size(); }
+
+		/**
+		 * 返回第一次达到目标时的计算次数，没有达到时返回not_reached()
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param target 目标的索引
+		 *
+		 * @return size_t
+		 */
+		size_t hit(size_t target) const { return m_hits.at(target); }
+
+		/**
+		 * 返回到目前为止的总计算次数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t evaluations() const { return m_statistics ? m_statistics->evaluations() : m_evaluations; }
+	};
+
+	/**
+	 * 指向目标监听器的智能指针
+	 */
+	typedef std::shared_ptr< target_listener > target_listener_ptr;
+
+	/**
+	 * 计算一个目标的期望运行时间（ERT）。
+	 *
+	 * ERT = 所有运行的计算次数之和 / 成功的运行次数，其中成功的运行只计到第一次达到目标为止，
+	 * 失败的运行计入全部的计算次数。没有任何运行达到目标时返回无穷大。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param runs 每次运行的目标监听器
+	 * @param target 目标的索引
+	 *
+	 * @return double
+	 */
+	inline double expected_running_time(const std::vector< target_listener_ptr >& runs, size_t target)
+	{
+		double evaluations(0);
+		size_t successes(0);
+
+		for (size_t r = 0; r < runs.size(); ++r)
+		{
+			if (!runs[r])
+				continue;
+
+			if (runs[r]->hit(target) != target_listener::not_reached())
+			{
+				evaluations += runs[r]->hit(target);
+				++successes;
+			}
+			else
+				evaluations += runs[r]->evaluations();
+		}
+
+		return successes > 0 ? evaluations / successes : std::numeric_limits< double >::infinity();
+	}
+
+	/**
+	 * 返回达到一个目标的运行次数
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param runs 每次运行的目标监听器
+	 * @param target 目标的索引
+	 *
+	 * @return size_t
+	 */
+	inline size_t successes(const std::vector< target_listener_ptr >& runs, size_t target)
+	{
+		size_t count(0);
+
+		for (size_t r = 0; r < runs.size(); ++r)
+		{
+			if (runs[r] && runs[r]->hit(target) != target_listener::not_reached())
+				++count;
+		}
+
+		return count;
+	}
+
+	/**
+	 * 计算经验累积分布函数（ECDF）在一个计算次数上的值：在不超过budget次计算内达到的
+	 * （运行，目标）对占所有对的比例。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param runs 每次运行的目标监听器
+	 * @param budget 计算次数
+	 *
+	 * @return double 0-1之间的值
+	 */
+	inline double ecdf(const std::vector< target_listener_ptr >& runs, size_t budget)
+	{
+		size_t reached(0);
+		size_t pairs(0);
+
+		for (size_t r = 0; r < runs.size(); ++r)
+		{
+			if (!runs[r])
+				continue;
+
+			for (size_t t = 0; t < runs[r]->targets(); ++t, ++pairs)
+			{
+				if (runs[r]->hit(t) <= budget)
+					++reached;
+			}
+		}
+
+		return pairs > 0 ? double(reached) / pairs : 0;
+	}
+
+}
+
+#endif //DE_CONVERGENCE_HPP_INCLUDED
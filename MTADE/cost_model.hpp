@@ -0,0 +1,255 @@
+#ifndef DE_COST_MODEL_HPP_INCLUDED
+#define DE_COST_MODEL_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "de_types.hpp"
+
+namespace de
+{
+
+	/**
+	 * 预测目标函数计算耗时的模型，用于按耗时从长到短的顺序计算一代（见processors::set_cost_model）。
+	 *
+	 * 预测值只用于排序，单位不重要。observe在处理器线程中被同时调用，派生类必须是线程安全的。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class cost_model
+	{
+	public:
+		virtual ~cost_model() {}
+
+		/**
+		 * 预测一组参数的计算耗时
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param vars 参数向量
+		 *
+		 * @return double 预测的耗时，越大越先计算
+		 */
+		virtual double predict(DVectorPtr vars) = 0;
+
+		/**
+		 * 预测一组参数向量的计算耗时，缺省实现对每个向量调用predict。派生类可以重写它，例如一次加锁
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param vars 参数向量
+		 * @param costs 接收预测的耗时，与vars一一对应
+		 */
+		virtual void predict(const std::vector< DVectorPtr >& vars, std::vector< double >& costs)
+		{
+			costs.resize(vars.size());
+
+			for (size_t n = 0; n < vars.size(); ++n)
+				costs[n] = predict(vars[n]);
+		}
+
+		/**
+		 * 报告一次计算实际的耗时，缺省实现忽略它
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param vars 参数向量
+		 * @param seconds 耗时（秒）
+		 */
+		virtual void observe(DVectorPtr vars, double seconds) {}
+	};
+
+	/**
+	 * A smart pointer to a cost_model
+	 */
+	typedef std::shared_ptr< cost_model > cost_model_ptr;
+
+	/**
+	 * 由用户提供的函数预测耗时的模型，不学习
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class function_cost_model : public cost_model
+	{
+	private:
+		const std::function< double(DVectorPtr) > m_predict;
+
+	public:
+		/**
+		 * constructs a function_cost_model object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param predict 预测耗时的函数
+		 */
+		explicit function_cost_model(std::function< double(DVectorPtr) > predict)
+			: m_predict(predict)
+		{
+			assert(predict);
+		}
+
+		using cost_model::predict;
+
+		virtual double predict(DVectorPtr vars) { return m_predict(vars); }
+	};
+
+	/**
+	 * 从最近的计算中学习的模型：预测值是历史中k个最近（欧氏距离）的参数向量的平均耗时。
+	 *
+	 * 历史是最多capacity个样本的环形缓冲区，旧的样本被新的替换，因此耗时随时间的变化也能被跟上。
+	 * 缓冲区在第一个样本时按变量个数一次分配，样本被复制到缓冲区中，记录样本不分配内存。
+	 * observe在计算的路径上，不等待锁：另一个线程正在记录样本或预测时，这个样本被丢弃。
+	 * 距离在原始的变量空间中计算，各个变量的范围相差很大时范围大的变量起主要作用。
+	 * 没有历史时所有的预测都是0，一代保持原来的顺序。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class nearest_neighbor_cost_model : public cost_model
+	{
+	private:
+		const size_t m_capacity;
+		const size_t m_k;
+
+		std::mutex m_mx;
+		size_t m_varCount;
+		// 第n个样本的变量是m_vars[n * m_varCount]开始的m_varCount个值
+		std::vector< double > m_vars;
+		std::vector< double > m_seconds;
+		size_t m_count;
+		size_t m_next;
+		std::atomic< size_t > m_dropped;
+		// (距离的平方, 耗时)，预测时使用
+		std::vector< std::pair< double, double > > m_nearest;
+
+	public:
+		/**
+		 * constructs a nearest_neighbor_cost_model object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param capacity 保存的样本数
+		 * @param k 预测时平均的近邻数
+		 */
+		explicit nearest_neighbor_cost_model(size_t capacity = 256, size_t k = 4)
+			: m_capacity(capacity), m_k(k), m_varCount(0), m_count(0), m_next(0), m_dropped(0)
+		{
+			assert(capacity > 0);
+			assert(k > 0);
+
+			m_seconds.resize(capacity);
+			m_nearest.reserve(capacity);
+		}
+
+		using cost_model::predict;
+
+		virtual double predict(DVectorPtr vars)
+		{
+			std::lock_guard< std::mutex > lock(m_mx);
+			return nearest(*vars);
+		}
+
+		virtual void predict(const std::vector< DVectorPtr >& vars, std::vector< double >& costs)
+		{
+			costs.resize(vars.size());
+
+			std::lock_guard< std::mutex > lock(m_mx);
+
+			for (size_t n = 0; n < vars.size(); ++n)
+				costs[n] = nearest(*vars[n]);
+		}
+
+		virtual void observe(DVectorPtr vars, double seconds)
+		{
+			std::unique_lock< std::mutex > lock(m_mx, std::try_to_lock);
+
+			if (!lock.owns_lock())
+			{
+				++m_dropped;
+				return;
+			}
+
+			if (m_varCount == 0)
+			{
+				m_varCount = vars->size();
+				m_vars.resize(m_capacity * m_varCount);
+			}
+
+			// 复制参数向量，个体的参数以后可能被修改
+			const size_t base(m_next * m_varCount);
+			for (size_t j = 0; j < m_varCount; ++j)
+				m_vars[base + j] = j < vars->size() ? double((*vars)[j]) : 0;
+
+			m_seconds[m_next] = seconds;
+			m_count = std::min(m_count + 1, m_capacity);
+			m_next = (m_next + 1) % m_capacity;
+		}
+
+		/**
+		 * 返回保存的样本数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t samples()
+		{
+			std::lock_guard< std::mutex > lock(m_mx);
+			return m_count;
+		}
+
+		/**
+		 * 返回因为锁被占用而丢弃的样本数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t dropped() const { return m_dropped; }
+
+	private:
+		// 持有锁时调用
+		double nearest(const DVector& vars)
+		{
+			if (m_count == 0)
+				return 0;
+
+			m_nearest.clear();
+
+			const size_t size(std::min(m_varCount, vars.size()));
+			for (size_t n = 0; n < m_count; ++n)
+			{
+				const double* s(&m_vars[n * m_varCount]);
+				double d(0);
+
+				for (size_t j = 0; j < size; ++j)
+					d += (vars[j] - s[j]) * (vars[j] - s[j]);
+
+				m_nearest.push_back(std::make_pair(d, m_seconds[n]));
+			}
+
+			const size_t k(std::min(m_k, m_nearest.size()));
+			std::partial_sort(m_nearest.begin(), m_nearest.begin() + k, m_nearest.end());
+
+			double sum(0);
+			for (size_t n = 0; n < k; ++n)
+				sum += m_nearest[n].second;
+
+			return sum / k;
+		}
+	};
+
+}
+
+#endif //DE_COST_MODEL_HPP_INCLUDED
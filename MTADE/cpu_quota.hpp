@@ -0,0 +1,385 @@
+#ifndef DE_CPU_QUOTA_HPP_INCLUDED
+#define DE_CPU_QUOTA_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace de
+{
+
+	/**
+	 * cgroup的CPU限额计数器：经过的调度周期数、被限制（throttled）的周期数和被限制的总时间
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	struct cpu_throttling
+	{
+		uint64_t periods;
+		uint64_t throttled;
+		double throttledSeconds;
+
+		cpu_throttling()
+			: periods(0), throttled(0), throttledSeconds(0)
+		{
+		}
+
+		/**
+		 * 返回两次读取之间的差
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param before 之前读取的计数器
+		 *
+		 * @return cpu_throttling
+		 */
+		cpu_throttling since(const cpu_throttling& before) const
+		{
+			cpu_throttling delta;
+			delta.periods = periods - std::min(periods, before.periods);
+			delta.throttled = throttled - std::min(throttled, before.throttled);
+			delta.throttledSeconds = std::max(0.0, throttledSeconds - before.throttledSeconds);
+
+			return delta;
+		}
+	};
+
+	/**
+	 * 进程可以使用的CPU：亲和性掩码中的逻辑处理器数和cgroup的CPU限额。
+	 *
+	 * 在Linux上读取进程所在cgroup及其上级的cgroup v2 cpu.max（取最小的限额），没有cgroup v2时读取
+	 * cgroup v1的cpu.cfs_quota_us和cpu.cfs_period_us；亲和性来自sched_getaffinity。在Windows上只读取
+	 * 进程的亲和性掩码（第一个处理器组），不读取作业对象的CPU速率限制。
+	 *
+	 * workers()是不会被CFS限制的线程数：限额向下取整，至少为1，不超过亲和性掩码中的处理器数。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class cpu_quota
+	{
+	private:
+		size_t m_affinity;
+		double m_limit;
+		std::string m_statPath;
+		bool m_v2;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param affinity 亲和性掩码中的逻辑处理器数，至少为1
+		 * @param limit CPU限额（可以使用的CPU个数，可以是小数），0表示没有限额
+		 * @param statPath cgroup的cpu.stat文件，为空时没有限制计数器
+		 * @param v2 cpu.stat是否是cgroup v2的格式
+		 */
+		cpu_quota(size_t affinity, double limit, const std::string& statPath = std::string(), bool v2 = true)
+			: m_affinity(std::max< size_t >(1, affinity)), m_limit(limit), m_statPath(statPath), m_v2(v2)
+		{
+		}
+
+		/**
+		 * 读取当前进程的亲和性和CPU限额
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return cpu_quota
+		 */
+		static cpu_quota detect()
+		{
+			const size_t affinity(affinity_cpus());
+
+#if defined(__linux__)
+			std::ifstream is("/proc/self/cgroup");
+			std::string line;
+			std::string v1Path;
+
+			while (std::getline(is, line))
+			{
+				// hierarchy-ID:controller-list:cgroup-path
+				const std::string::size_type first(line.find(':'));
+				const std::string::size_type second(first == std::string::npos ? std::string::npos : line.find(':', first + 1));
+				if (second == std::string::npos)
+					continue;
+
+				const std::string controllers(line.substr(first + 1, second - first - 1));
+				const std::string path(line.substr(second + 1));
+
+				if (line.compare(0, first, "0") == 0 && controllers.empty())
+				{
+					double limit(0);
+					std::string stat;
+
+					// 从进程所在的cgroup向上直到根，限额取最小值
+					for (std::string p(path == "/" ? std::string() : path);; p = p.rfind('/') == std::string::npos ? std::string() : p.substr(0, p.rfind('/')))
+					{
+						const std::string dir("/sys/fs/cgroup" + p);
+						if (stat.empty() && std::ifstream((dir + "/cpu.stat").c_str()))
+							stat = dir + "/cpu.stat";
+
+						const double l(read_cpu_max(dir + "/cpu.max"));
+						if (l > 0 && (limit == 0 || l < limit))
+							limit = l;
+
+						if (p.empty())
+							break;
+					}
+
+					if (!stat.empty())
+						return cpu_quota(affinity, limit, stat, true);
+				}
+				else if (("," + controllers + ",").find(",cpu,") != std::string::npos)
+					v1Path = path;
+			}
+
+			if (!v1Path.empty())
+			{
+				// 在容器中cgroup命名空间的根就是挂载点，进程的路径不一定存在
+				const std::string candidates[] = { "/sys/fs/cgroup/cpu" + v1Path, "/sys/fs/cgroup/cpu", "/sys/fs/cgroup/cpu,cpuacct" + v1Path };
+
+				for (size_t n = 0; n < sizeof(candidates) / sizeof(candidates[0]); ++n)
+				{
+					if (!std::ifstream((candidates[n] + "/cpu.cfs_quota_us").c_str()))
+						continue;
+
+					const double quota(read_number(candidates[n] + "/cpu.cfs_quota_us"));
+					const double period(read_number(candidates[n] + "/cpu.cfs_period_us"));
+
+					return cpu_quota(affinity, quota > 0 && period > 0 ? quota / period : 0, candidates[n] + "/cpu.stat", false);
+				}
+			}
+#endif
+
+			return cpu_quota(affinity, 0);
+		}
+
+		/**
+		 * 返回进程的亲和性掩码中的逻辑处理器数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		static size_t affinity_cpus()
+		{
+#if defined(_WIN32)
+			DWORD_PTR process(0), system(0);
+			if (GetProcessAffinityMask(GetCurrentProcess(), &process, &system))
+			{
+				size_t count(0);
+				for (; process != 0; process &= process - 1)
+					++count;
+
+				if (count > 0)
+					return count;
+			}
+#elif defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+
+			if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0)
+				return CPU_COUNT(&set);
+#endif
+
+			return std::max< size_t >(1, std::thread::hardware_concurrency());
+		}
+
+		/**
+		 * 返回亲和性掩码中的逻辑处理器数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t affinity() const { return m_affinity; }
+
+		/**
+		 * 返回CPU限额（可以使用的CPU个数），0表示没有限额
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double limit() const { return m_limit; }
+
+		/**
+		 * 返回不会被限制的线程数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t workers() const
+		{
+			if (m_limit <= 0)
+				return m_affinity;
+
+			return std::min(m_affinity, std::max< size_t >(1, static_cast< size_t >(std::floor(m_limit))));
+		}
+
+		/**
+		 * 读取cgroup的限制计数器，没有cpu.stat时都是0
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return cpu_throttling
+		 */
+		cpu_throttling throttling() const
+		{
+			cpu_throttling t;
+			if (m_statPath.empty())
+				return t;
+
+			std::ifstream is(m_statPath.c_str());
+			std::string key;
+			uint64_t value(0);
+
+			while (is >> key >> value)
+			{
+				if (key == "nr_periods")
+					t.periods = value;
+				else if (key == "nr_throttled")
+					t.throttled = value;
+				else if (m_v2 && key == "throttled_usec")
+					t.throttledSeconds = value * 1e-6;
+				else if (!m_v2 && key == "throttled_time")
+					t.throttledSeconds = value * 1e-9;
+			}
+
+			return t;
+		}
+
+	private:
+		// cpu.max的格式是"$MAX $PERIOD"，$MAX为max表示没有限额
+		static double read_cpu_max(const std::string& path)
+		{
+			std::ifstream is(path.c_str());
+			std::string max;
+			double period(0);
+
+			if (!(is >> max >> period) || max == "max" || period <= 0)
+				return 0;
+
+			std::istringstream value(max);
+			double quota(0);
+
+			return value >> quota && quota > 0 ? quota / period : 0;
+		}
+
+		static double read_number(const std::string& path)
+		{
+			std::ifstream is(path.c_str());
+			double value(0);
+
+			return is >> value ? value : 0;
+		}
+	};
+
+	/**
+	 * 定期重新读取CPU限额，用于在运行时调整处理器集合的大小（见processors::set_quota_monitor）。
+	 *
+	 * 没有自己的线程：poll()由处理器集合在每次计算开始时调用，距离上次读取超过interval时才读取文件。
+	 * throttling()返回创建以来的限制计数器。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class cpu_quota_monitor
+	{
+	private:
+		const std::chrono::steady_clock::duration m_interval;
+		std::chrono::steady_clock::time_point m_last;
+		cpu_quota m_quota;
+		cpu_throttling m_baseline;
+
+	public:
+		/**
+		 * 构造函数，读取当前的限额和限制计数器
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param interval 两次读取之间的最短时间
+		 */
+		explicit cpu_quota_monitor(std::chrono::steady_clock::duration interval = std::chrono::seconds(1))
+			: m_interval(interval), m_last(std::chrono::steady_clock::now()), m_quota(cpu_quota::detect()), m_baseline(m_quota.throttling())
+		{
+		}
+
+		/**
+		 * 距离上次读取超过interval时重新读取限额
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool 不会被限制的线程数改变时为true
+		 */
+		bool poll()
+		{
+			const std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+			if (now - m_last < m_interval)
+				return false;
+
+			m_last = now;
+
+			const size_t workers(m_quota.workers());
+			m_quota = cpu_quota::detect();
+
+			return m_quota.workers() != workers;
+		}
+
+		/**
+		 * 返回最近一次读取的限额
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const cpu_quota&
+		 */
+		const cpu_quota& quota() const { return m_quota; }
+
+		/**
+		 * 返回不会被限制的线程数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t workers() const { return m_quota.workers(); }
+
+		/**
+		 * 返回创建以来的限制计数器
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return cpu_throttling
+		 */
+		cpu_throttling throttling() const { return m_quota.throttling().since(m_baseline); }
+	};
+
+	/**
+	 * A smart pointer to a cpu_quota_monitor
+	 */
+	typedef std::shared_ptr< cpu_quota_monitor > cpu_quota_monitor_ptr;
+
+}
+
+#endif //DE_CPU_QUOTA_HPP_INCLUDED
@@ -0,0 +1,163 @@
+#ifndef DE_CROSSOVER_STRATEGY_HPP_INCLUDED
+#define DE_CROSSOVER_STRATEGY_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "random_generator.hpp"
+
+namespace de
+{
+
+	/**
+	 * 交叉策略决定试验个体的哪些变量取变异值，其余的变量保留父个体的值。
+	 *
+	 * 交叉策略是模板参数而不是虚基类：变异策略（见basic_mutation_strategy_1等）以交叉策略为模板参数，
+	 * 在编译时组合，选中的每个变量调用一次apply(j)，不经过虚函数。交叉策略必须提供
+	 *
+	 *   template< typename F > void operator()(size_t varCount, double CR, F apply);
+	 *
+	 * 交叉策略可以有状态（例如缓冲区），每个变异策略对象拥有自己的交叉策略对象。
+	 *
+	 * 指数交叉：从随机的变量开始，连续选中L个变量（循环），P(L >= k) = CR^(k-1)。
+	 * 原来的实现每选中一个变量抽一次随机数，循环的每次迭代都依赖上一次的结果；这里直接按几何分布
+	 * 抽取长度L，只抽两次随机数（起点和长度），然后对一段或两段连续的变量调用apply。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class exponential_crossover
+	{
+	private:
+		double m_CR;
+		double m_logCR;
+
+	public:
+		exponential_crossover()
+			: m_CR(0), m_logCR(0)
+		{
+		}
+
+		/**
+		 * 选择变量
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param varCount 变量的个数
+		 * @param CR 交叉因子
+		 * @param apply 对每个选中的变量调用的函数对象，形如void(size_t j)
+		 */
+		template< typename F > void operator()(size_t varCount, double CR, F apply)
+		{
+			assert(varCount > 0);
+
+			const size_t start(genintrand(0, varCount, true));
+			size_t length(varCount);
+
+			if (CR < 1.0)
+			{
+				// 第一个变量总是选中，之后每个变量以概率CR继续：L - 1 = floor(log(u) / log(CR))，u在(0, 1]之内。
+				// u > CR时L = 1，不需要计算对数；CR通常在整个运行中不变，缓存它的对数
+				const double u(1.0 - genrand());
+
+				if (u > CR)
+					length = 1;
+				else
+				{
+					if (CR != m_CR)
+					{
+						m_CR = CR;
+						m_logCR = std::log(CR);
+					}
+
+					const double skip(std::floor(std::log(u) / m_logCR));
+					length = skip < varCount - 1 ? 1 + static_cast< size_t >(skip) : varCount;
+				}
+			}
+
+			const size_t end(std::min(varCount, start + length));
+
+			for (size_t j = start; j < end; ++j)
+				apply(j);
+
+			for (size_t j = 0; j < start + length - end; ++j)
+				apply(j);
+		}
+	};
+
+	/**
+	 * 二项交叉：每个变量以概率CR选中，并且至少选中一个随机的变量。
+	 *
+	 * 先从随机数引擎成批取出每个变量的32位随机整数，再用没有分支（可以向量化）的一次循环
+	 * 与按CR换算的整数阈值比较，得到整个选择掩码，最后对掩码中选中的变量调用apply。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class binomial_crossover
+	{
+	private:
+		std::vector< std::uint32_t > m_draws;
+		std::vector< unsigned char > m_mask;
+
+	public:
+		/**
+		 * 选择变量
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param varCount 变量的个数
+		 * @param CR 交叉因子
+		 * @param apply 对每个选中的变量调用的函数对象，形如void(size_t j)
+		 */
+		template< typename F > void operator()(size_t varCount, double CR, F apply)
+		{
+			assert(varCount > 0);
+
+			const size_t jrand(genintrand(0, varCount, true));
+
+			if (CR >= 1.0)
+			{
+				for (size_t j = 0; j < varCount; ++j)
+					apply(j);
+
+				return;
+			}
+
+			m_draws.resize(varCount);
+			m_mask.resize(varCount);
+
+			random_engine& gen(generator());
+			for (size_t j = 0; j < varCount; ++j)
+				m_draws[j] = static_cast< std::uint32_t >(gen());
+
+			// 随机整数均匀分布在[0, 2^32)之内，小于CR*2^32的概率为CR
+			const std::uint32_t threshold(CR > 0 ? static_cast< std::uint32_t >(CR * 4294967296.0) : 0);
+
+			const std::uint32_t* draws(m_draws.data());
+			unsigned char* mask(m_mask.data());
+
+			for (size_t j = 0; j < varCount; ++j)
+				mask[j] = draws[j] < threshold;
+
+			mask[jrand] = 1;
+
+			for (size_t j = 0; j < varCount; ++j)
+			{
+				if (mask[j])
+					apply(j);
+			}
+		}
+	};
+
+}
+
+#endif //DE_CROSSOVER_STRATEGY_HPP_INCLUDED
@@ -25,7 +25,7 @@ namespace de
 {
 
 	/**
-	 * Լ׳쳣
+	 * 在约束错误的情况下抛出异常
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -33,7 +33,7 @@ namespace de
 	{
 	public:
 		/**
-		 * ϢΪĹ캯
+		 * 将错误消息作为参数的构造函数
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -46,8 +46,8 @@ namespace de
 	};
 
 	/**
-	 * Լĳࡣ
-	 * һԼĿ꺯ĳЩԺơ
+	 * 具体约束类的抽象基类。
+	 * 一个约束类描述了输入变量对目标函数的某些特性和限制。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -57,7 +57,7 @@ namespace de
 		virtual ~constraint() {}
 
 		/**
-		 * һԼͺͷΧڵֵ
+		 * 返回一个限制在约束类型和范围内的随机值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -66,7 +66,7 @@ namespace de
 		virtual double get_rand_value() = 0;
 
 		/**
-		 * ǰֵԭ㷵һԼͺͷΧڵֵ(μеľʵ)
+		 * 根据先前的值和原点返回一个限制在约束的类型和范围内的随机值(参见派生类中的具体实现)
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -78,7 +78,7 @@ namespace de
 		virtual double get_rand_value(double value, double origin) = 0;
 
 		/**
-		 * طΧСơ
+		 * 返回范围的最小限制。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -87,7 +87,7 @@ namespace de
 		virtual double min() const = 0;
 
 		/**
-		 * طΧơ
+		 * 返回范围的最大限制。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -96,19 +96,19 @@ namespace de
 		virtual double max() const = 0;
 
 		/**
-		 * ȡΪԼõڵֵһԭ͸ԭΧĿȣܿȵİٷֱȣķΧڡ
+		 * 获取在为约束设置的限制内的随机值，但进一步限制在由其原点和该原点周围区域的宽度（以总宽度的百分比）定义的范围内。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param origin һԼԭ㣨ģ
-		 * @param zonePct Χԭȣܿȵİٷֱȱʾ
+		 * @param origin 进一步限制了约束区域的原点（中心）
+		 * @param zonePct 围绕原点的区域宽度，以总宽度的百分比表示
 		 *
 		 * @return double
 		 */
 		virtual double get_rand_value_in_zone(double origin, double zonePct) const = 0;
 
 		/**
-		 * ȡСֵֵ֮ĵ-ڷΧԼ
+		 * 获取介于最小值和最大值之间的点-仅适用于范围约束
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -118,12 +118,108 @@ namespace de
 	};
 
 	/**
-	 * ָĳԼָ
+	 * 指向某条约束的智能指针
 	 */
 	typedef std::shared_ptr< constraint > constraint_ptr;
 
 	/**
-	 * ڷΧԼĻࡣ ÿԼһСֵֵ
+	 * 范围约束的越界修复方式
+	 *
+	 * random：在越过的边界和原值之间随机取一个新值（只抽一次随机数）
+	 * reflect：以边界为镜面把越界的部分反射回范围之内
+	 * wrap：从另一侧的边界绕回范围之内
+	 * clamp：取越过的边界
+	 * midpoint：取越过的边界和原值的中点
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	enum class repair_mode { random, reflect, wrap, clamp, midpoint };
+
+	/**
+	 * 按修复方式把越界的值修复到[min, max]之内。
+	 *
+	 * 每种方式都只做常数次计算，多次越过范围的值（例如reflect和wrap）也用取模一次完成，
+	 * 结果最后再限制在范围之内，因此原值越界时也能得到合法的值。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param mode 修复方式
+	 * @param value 越界的值
+	 * @param min 范围的最小值
+	 * @param max 范围的最大值
+	 * @param origin 原值
+	 *
+	 * @return double
+	 */
+	inline double repair_range(repair_mode mode, double value, double min, double max, double origin)
+	{
+		const double width(max - min);
+		const double bound(value < min ? min : max);
+
+		double ret;
+
+		switch (mode)
+		{
+		case repair_mode::reflect:
+		{
+			// 以2*width为周期，折返的位置到min的距离为width - |t - width|
+			const double period(2.0 * width);
+			double t(period > 0 ? std::fmod(value - min, period) : 0);
+			t += t < 0 ? period : 0;
+			ret = min + width - std::fabs(t - width);
+			break;
+		}
+		case repair_mode::wrap:
+		{
+			double t(width > 0 ? std::fmod(value - min, width) : 0);
+			t += t < 0 ? width : 0;
+			ret = min + t;
+			break;
+		}
+		case repair_mode::clamp:
+			ret = bound;
+			break;
+		case repair_mode::midpoint:
+			ret = (bound + origin) / 2.0;
+			break;
+		case repair_mode::random:
+		default:
+			ret = bound + genrand() * (origin - bound);
+			break;
+		}
+
+		return std::min(max, std::max(min, ret));
+	}
+
+	/**
+	 * 按名字返回修复方式："random"、"reflect"、"wrap"、"clamp"或"midpoint"
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param name 修复方式的名字
+	 *
+	 * @return repair_mode
+	 */
+	inline repair_mode str_to_repair_mode(const std::string& name)
+	{
+		const std::string mode(udstr::tolower(name));
+
+		if (mode == "random")
+			return repair_mode::random;
+		else if (mode == "reflect")
+			return repair_mode::reflect;
+		else if (mode == "wrap")
+			return repair_mode::wrap;
+		else if (mode == "clamp")
+			return repair_mode::clamp;
+		else if (mode == "midpoint")
+			return repair_mode::midpoint;
+		else
+			throw constraints_exception("invalid repair mode \"" + name + "\"");
+	}
+
+	/**
+	 * 基于范围的约束的基类。 每个这样的约束都有一个最小值和最大值
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -132,25 +228,45 @@ namespace de
 	private:
 		double m_min;
 		double m_max;
+		repair_mode m_repairMode;
 
 	public:
 
 		/**
-		 * 캯ΧС
+		 * 构造函数，范围最小和最大限制
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
 		 * @param min
 		 * @param max
+		 * @param mode 越界的修复方式
 		 */
-		range_constraint(double min, double max)
-			: m_min(min), m_max(max)
+		range_constraint(double min, double max, repair_mode mode = repair_mode::random)
+			: m_min(min), m_max(max), m_repairMode(mode)
 		{
 			assert(min <= max);
 		}
 
 		/**
-		 * طΧС
+		 * 返回越界的修复方式
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return repair_mode
+		 */
+		repair_mode get_repair_mode() const { return m_repairMode; }
+
+		/**
+		 * 设置越界的修复方式
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param mode
+		 */
+		void set_repair_mode(repair_mode mode) { m_repairMode = mode; }
+
+		/**
+		 * 返回范围的最小限制
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -159,7 +275,7 @@ namespace de
 		double min() const { return m_min; }
 
 		/**
-		 * طΧ
+		 * 返回范围的最大限制
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -170,7 +286,7 @@ namespace de
 	};
 
 	/**
-	 * ʵࡣָָڿκ˫ֵ
+	 * 实数限制类。指定变量在指定的限制内可以有任何双精度值。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -179,21 +295,22 @@ namespace de
 	public:
 
 		/**
-		 * 캯ΧСֵ޶
+		 * 构造函数，范围最大最小值限定
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
 		 * @param min
 		 * @param max
+		 * @param mode 越界的修复方式
 		 */
-		real_constraint(double min, double max)
-			: range_constraint(min, max)
+		real_constraint(double min, double max, repair_mode mode = repair_mode::random)
+			: range_constraint(min, max, mode)
 		{
 			assert(min <= max);
 		}
 
 		/**
-		 * һԼͺͷΧֵ
+		 * 返回一个受限于约束类型和范围的随机值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -205,7 +322,7 @@ namespace de
 		}
 
 		/**
-		 * ǰֵԭ㣬ԼͺͷΧڵֵ
+		 * 根据先前的值和原点，返回限制在约束类型和范围内的随机值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -216,19 +333,10 @@ namespace de
 		 */
 		double get_rand_value(double value, double origin)
 		{
-			double ret = value;
-
-			while (ret < range_constraint::min())
-			{
-				ret = range_constraint::min() + genrand() * (origin - range_constraint::min());
-			}
-
-			while (ret > range_constraint::max())
-			{
-				ret = range_constraint::max() + genrand() * (origin - range_constraint::max());
-			}
+			if (value < range_constraint::min() || value > range_constraint::max())
+				return repair_range(get_repair_mode(), value, range_constraint::min(), range_constraint::max(), origin);
 
-			return ret;
+			return value;
 		}
 
 		virtual double get_rand_value_in_zone(double origin, double zonePct) const
@@ -263,7 +371,7 @@ namespace de
 	};
 
 	/**
-	 * Լ ָԾָڵκֵ
+	 * 整数约束。 指定变量可以具有指定限制内的任何整数值。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -271,21 +379,22 @@ namespace de
 	{
 	public:
 		/**
-		 * 캯ԼС
+		 * 构造函数，采用整数约束的最小和最大限制
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
 		 * @param min
 		 * @param max
+		 * @param mode 越界的修复方式
 		 */
-		int_constraint(double min, double max)
-			: range_constraint(min, max)
+		int_constraint(double min, double max, repair_mode mode = repair_mode::random)
+			: range_constraint(min, max, mode)
 		{
 			assert(min <= max);
 		}
 
 		/**
-		 * һԼͺͷΧֵ
+		 * 返回一个受限于约束类型和范围的随机值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -297,7 +406,7 @@ namespace de
 		}
 
 		/**
-		 * ǰֵԭ㣬ԼͺͷΧڵֵ
+		 * 根据先前的值和原点，返回限制在约束类型和范围内的随机值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -310,16 +419,15 @@ namespace de
 		{
 			double ret = round(value);
 
-			while (ret < range_constraint::min())
+			if (ret < range_constraint::min() || ret > range_constraint::max())
 			{
-				ret = range_constraint::min() + genrand() * (origin - range_constraint::min());
-				ret = round(ret);
-			}
+				ret = round(repair_range(get_repair_mode(), ret, range_constraint::min(), range_constraint::max(), origin));
 
-			while (ret > range_constraint::max())
-			{
-				ret = range_constraint::max() + genrand() * (origin - range_constraint::max());
-				ret = round(ret);
+				// 取整后可能越过不是整数的边界
+				if (ret < range_constraint::min())
+					ret = std::ceil(range_constraint::min());
+				else if (ret > range_constraint::max())
+					ret = std::floor(range_constraint::max());
 			}
 
 			return ret;
@@ -362,8 +470,8 @@ namespace de
 	};
 
 	/**
-	 * Լϡ ָԲԤ弯еκֵҪС
-	 * ע⣬ظֵɾ
+	 * 约束集合。 指定变量可以采用预定义集合中的任何值。不需要最小或最大。
+	 * 请注意，重复值将被删除。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -404,7 +512,7 @@ namespace de
 
 	public:
 		/**
-		 * Doubleֵvector켯ϣɾظȷľȷֲ
+		 * 根据Double值的vector对象构造集合，并删除重复项以确保随机分配的均匀分布
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -412,12 +520,14 @@ namespace de
 		 */
 		set_constraint(const de::DVector& values)
 		{
-			// ȷϡеֵΨһ
-			std::remove_copy_if(values.begin(), values.end(), std::back_inserter(m_values), m_unique);
+			// 确保“集合”中的值是唯一的。m_unique对首次出现的值返回true，
+			// 不能作为remove_copy_if的谓词（会删掉唯一值，而且谓词是按值复制的）
+			for (de::DVector::size_type n = 0; n < values.size(); ++n)
+				add_value(values[n]);
 		}
 
 		/**
-		 * һֵӵϡУᴴظֵ
+		 * 将一个单独的值添加到“集合”中，不会创建重复的值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -430,7 +540,16 @@ namespace de
 		}
 
 		/**
-		 * شӿֵѡֵ
+		 * 返回集合中所有的值（没有重复）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const de::DVector&
+		 */
+		const de::DVector& values() const { return m_values; }
+
+		/**
+		 * 返回从可用值集合中随机选择的值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -444,7 +563,7 @@ namespace de
 		}
 
 		/**
-		 * شӿֵѡֵ
+		 * 返回从可用值集中随机选择的值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -456,7 +575,7 @@ namespace de
 		}
 
 		/**
-		 * طΧС
+		 * 返回范围的最小限制
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -468,7 +587,7 @@ namespace de
 		}
 
 		/**
-		 * طΧ
+		 * 返回范围的最大限制
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -492,7 +611,7 @@ namespace de
 	};
 
 	/**
-	 * Լ ָԲòֵ-truefalse
+	 * 布尔约束。 指定变量可以采用布尔值-true或false。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -500,7 +619,7 @@ namespace de
 	{
 	public:
 		/**
-		 * һֵ
+		 * 返回一个随机布尔值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -512,7 +631,7 @@ namespace de
 		}
 
 		/**
-		 * һֵ
+		 * 返回一个随机布尔值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -524,7 +643,7 @@ namespace de
 		}
 
 		/**
-		 * طΧС
+		 * 返回范围的最小限制
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -536,7 +655,7 @@ namespace de
 		}
 
 		/**
-		 * طΧ
+		 * 返回范围的最大限制
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -562,7 +681,7 @@ namespace de
 	typedef std::vector< constraint_ptr > constraints_base;
 
 	/**
-	 * Լļϣvectorʵ֡ڶŻڼʹõбԼ
+	 * 约束条件的集合，用vector容器实现。用于定义优化进程期间使用的所有变量的约束。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -572,13 +691,13 @@ namespace de
 
 	public:
 		/**
-		 * ʹĬֵʼһԼϣеԼʵͣͬĬϴС
+		 * 使用默认值初始化一个约束集合，所有的约束是实数类型，且有相同的默认大小
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param varCount Լĸ
-		 * @param defMin ĬСֵ
-		 * @param defMax Ĭֵ
+		 * @param varCount 约束的个数
+		 * @param defMin 默认最小值
+		 * @param defMax 默认最大值
 		 */
 		constraints(size_t varCount, double defMin, double defMax)
 			: constraints_base(varCount, std::make_shared< real_constraint >(defMin, defMax))
@@ -586,16 +705,16 @@ namespace de
 		}
 
 		/**
-		 * ַгʼһԼϣĿǰֻڻڷΧԼ
-		 * һԼԱΪ"type;min;max" typeʵͣminmaxޡ
+		 * 从字符串描述中初始化一个约束集合，目前只适用于基于范围的约束；
+		 * 一条约束可以被描述为："type;min;max" 其中type可以是实数或整数类型，min，max是上下限。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param str һԼַϣÿַһ
-		 * @param var_count ĸ (Բַĸ).ĸַ࣬
-		 *  			   Լ趨ΪʵͣʹĬϵĴСֵ޶Χ
-		 * @param def_min ĬСֵָΪַԼ
-		 * @param def_max ĬСֵָΪַԼ
+		 * @param str 一个约束的描述字符串集合，每个字符串描述一个变量；
+		 * @param var_count 变量的个数 (可以不等于字符串的个数).如果变量的个数输入的字符串多，
+		 *  			   则多余的约束被设定为实数类型，并使用默认的大小值来限定范围；
+		 * @param def_min 默认最小值，如果变量的数量大于指定为字符串的约束的数量；
+		 * @param def_max 默认最小值，如果变量的数量大于指定为字符串的约束的数量。
 		 */
 		constraints(const std::vector< std::string >& str, size_t var_count, double def_min, double def_max)
 			: constraints_base(var_count, std::make_shared< real_constraint >(def_min, def_max))
@@ -604,7 +723,7 @@ namespace de
 
 			for (std::vector< std::string >::size_type i = 0; i < str.size(); ++i)
 			{
-				std::string delim{ "[\\s;,]+" };//ʽͨƥַ
+				std::string delim{ "[\\s;,]+" };//正则表达式通配符，用于匹配多余的字符
 				auto s_result = udstr::bs_split(str[i], delim);
 
 				std::string type;
@@ -647,11 +766,11 @@ namespace de
 		}
 
 		/**
-		 * һԼͺͷΧڵֵ
+		 * 返回一个限制在约束类型和范围内的随机值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index Լ
+		 * @param index 约束条件的索引
 		 *
 		 * @return double
 		 */
@@ -669,13 +788,13 @@ namespace de
 		}
 
 		/**
-		 * ǰֵԭ㣬ԼͺͷΧڵֵ
+		 * 根据先前的值和原点，返回限制在约束类型和范围内的随机值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index Լ
-		 * @param value ǰֵ
-		 * @param origin ԭ
+		 * @param index 约束条件的索引
+		 * @param value 先前的值
+		 * @param origin 原点
 		 *
 		 * @return double
 		 */
@@ -692,12 +811,12 @@ namespace de
 		}
 
 		/**
-		 * ԭͱʾΪΧٷֱȵġ塱һֵ
+		 * 在由原点和表示为整个范围百分比的区域定义的“超立方体”区域内生成一组随机值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param origin ԭ
-		 * @param sidePct ıռߵİٷֱ
+		 * @param origin 区域的原点坐标
+		 * @param sidePct 超立方体的边占整个边的百分比
 		 *
 		 * @return DVectorPtr
 		 */
@@ -720,6 +839,24 @@ namespace de
 				throw constraints_exception("The origin vector must have the same number of elements as there are constraints");
 		}
 
+		/**
+		 * 设置所有范围约束的越界修复方式，其它类型的约束不受影响。
+		 *
+		 * 约束表（constraint_table）是约束的快照，需要在创建引擎之前设置。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param mode 越界的修复方式
+		 */
+		void set_repair_mode(repair_mode mode)
+		{
+			for (constraints_base::size_type n = 0; n < constraints_base::size(); ++n)
+			{
+				if (range_constraint* rc = dynamic_cast< range_constraint* >((*this)[n].get()))
+					rc->set_repair_mode(mode);
+			}
+		}
+
 		DVectorPtr get_middle_point()
 		{
 			DVectorPtr r(std::make_shared< DVector >(constraints_base::size()));
@@ -732,7 +869,7 @@ namespace de
 		}
 
 		/**
-		 * ԼõƷΧڻȡһֵ
+		 * 在约束设置的限制范围内获取一组随机值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
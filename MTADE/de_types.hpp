@@ -13,7 +13,7 @@
 namespace de
 {
 	/**
-	 * װһdoubleͣҪڵԺ
+	 * 封装一个double类型，主要用于调试和诊断
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -35,7 +35,7 @@ namespace de
 		}
 
 		/**
-		 * ظֵ
+		 * 重载赋值运算符
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -51,7 +51,7 @@ namespace de
 		}
 
 		/**
-		 * תΪdoubleĲ
+		 * 定义转换为double的操作符
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -75,7 +75,7 @@ namespace de
 
 
 	/**
-	 *  C++׼DE쳣 (std::exceptionMSʵзǱ׼캯)
+	 * 定义符合 C++标准的DE异常类 (std::exception的MS实现有非标准构造函数)
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -89,7 +89,7 @@ namespace de
 		{
 		}
 		/**
-		 * 캯CַΪò쳣Ϣ
+		 * 构造函数以C字符串作为参数，该参数是与异常相关联的消息
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -101,11 +101,11 @@ namespace de
 		}
 
 		/**
-		 * Сʹá쳣󳬳Χ˺صָЧ
+		 * 小心使用——如果异常对象超出范围，则此函数返回的指针无效
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @return const char* ָ쳣Ϣַָ
+		 * @return const char* 指向与异常信息相关联的字符串的指针
 		 */
 		virtual const char* what() const throw()
 		{
@@ -8,176 +8,208 @@
 #define DE_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
 
 #include <memory>
-#include <tuple>
 
-#include "random_generator.hpp"
-#include "multithread.hpp"
-#include "individual.hpp"
+#include "basic_differential_evolution.hpp"
+#include "fixed_differential_evolution.hpp"
 #include "processors.hpp"
-#include "mutation_strategy.hpp"
-#include "population.hpp"
-#include "selection_strategy.hpp"
-#include "termination_strategy.hpp"
-#include "listener.hpp"
 
 namespace de
 {
 
 	/**
-	 * Żڼ䷢ʱ׳쳣
+	 * 转发到运行时多态的变异策略（mutation_strategy_ptr）的变异策略适配器，用于differential_evolution< T >
 	 *
-	 * @author louiehan (11/11/2019)
+	 * @author louiehan (10/19/2026)
 	 */
-	class differential_evolution_exception
+	class dynamic_mutation
 	{
+	private:
+		mutation_strategy_ptr m_strategy;
+
+	public:
+		explicit dynamic_mutation(mutation_strategy_ptr strategy)
+			: m_strategy(strategy)
+		{
+			assert(strategy);
+		}
+
+		void start_generation(const population& pop, bool minimize) { m_strategy->start_generation(pop, minimize); }
+
+		void resize(size_t popSize) { m_strategy->resize(popSize); }
+
+		mutation_strategy::mutation_info operator()(const population& pop, individual_ptr bestIt, size_t i) { return (*m_strategy)(pop, bestIt, i); }
+
+		void set_constraint_table(constraint_table_ptr table) { m_strategy->set_constraint_table(table); }
+
+		bool repairs_trials() const { return m_strategy->repairs_trials(); }
+
+		mutation_strategy_ptr get() const { return m_strategy; }
 	};
 
 	/**
-	 * ֽ㷨
-	 *
-	 * ݸŻ̡
+	 * 运行时多态的变异策略本身是否是选择监听器只能在运行时确定
+	 */
+	inline selection_listener_ptr mutation_selection_listener(dynamic_mutation& mutation)
+	{
+		return std::dynamic_pointer_cast< selection_listener >(mutation.get());
+	}
+
+	/**
+	 * 转发到运行时多态的选择策略（selection_strategy_ptr）的选择策略适配器
 	 *
-	 * @author louiehan (11/11/2019)
+	 * @author louiehan (10/19/2026)
 	 */
-	template< typename T > class differential_evolution
+	class dynamic_selection
 	{
 	private:
-		const size_t m_varCount;
-		const size_t m_popSize;
-
-		population_ptr m_pop1;
-		population_ptr m_pop2;
-		individual_ptr m_bestInd;
-
-		constraints_ptr m_constraints;
-		typename processors< T >::processors_ptr m_processors;
-		termination_strategy_ptr m_terminationStrategy;
-		selection_strategy_ptr m_selectionStrategy;
-		mutation_strategy_ptr m_mutationStrategy;
-		listener_ptr m_listener;
+		selection_strategy_ptr m_strategy;
 
-		const bool m_minimize;
 	public:
-		/**
-		 * һdifferential_evolution
-		 *
-		 * @author louiehan (11/11/2019)
-		 *
-		 * @param varCount Ŀ꺯ı㷨ĸԪأ
-		 * @param popSize һȺеи
-		 * @param processors ŻỰڼʹõĲд
-		 * @param constraints ԼаĿ꺯ʹõıԼԼ㷨ڲʹõԼ
-		 * @param minimize ΪtrueСɱΪfalse򽫳󻯳ɱ
-		 * @param terminationStrategy ֹԣ
-		 * @param selectionStrategy ѡԣ
-		 * @param mutationStrategy ԣ
-		 * @param listener 
-		 */
-		differential_evolution(size_t varCount, size_t popSize, typename processors< T >::processors_ptr processors, constraints_ptr constraints, bool minimize,
-			termination_strategy_ptr terminationStrategy, selection_strategy_ptr selectionStrategy,
-			mutation_strategy_ptr mutationStrategy, de::listener_ptr listener)
-			try
-
-			: m_varCount(varCount), m_popSize(popSize), m_pop1(std::make_shared< population >(popSize, varCount, constraints)),
-			m_pop2(std::make_shared< population >(popSize, varCount)), m_bestInd(m_pop1->best(minimize)),
-			m_constraints(constraints), m_processors(processors), m_minimize(minimize), m_terminationStrategy(terminationStrategy),
-			m_listener(listener), m_selectionStrategy(selectionStrategy), m_mutationStrategy(mutationStrategy)
-		{
-			assert(processors);
-			assert(constraints);
-			assert(terminationStrategy);
-			assert(selectionStrategy);
-			assert(listener);
-			assert(mutationStrategy);
-
-			assert(popSize > 0);
-			assert(varCount > 0);
-
-			//ͨʹóʼĿ꺯ʼ1
-			processors->push(m_pop1);
-			processors->start();
-			processors->wait();
-
-		}
-		catch (const processors_exception&)
+		explicit dynamic_selection(selection_strategy_ptr strategy)
+			: m_strategy(strategy)
 		{
-			throw differential_evolution_exception();
+			assert(strategy);
 		}
 
-		virtual ~differential_evolution(void)
+		void operator()(population_ptr& pop1, population_ptr& pop2, individual_ptr& bestInd, bool minimize, selection_listener_ptr listener)
 		{
+			(*m_strategy)(pop1, pop2, bestInd, minimize, listener);
 		}
 
-		/**
-		 * ֽŻ̡
-		 *
-		 * ܴǲнеģ˺ͬģŻɻ󴥷쳣֮ǰ᷵ء
-		 *
-		 * @author louiehan (11/11/2019)
-		 */
-		void run()
-		{
-			try
-			{
-				m_listener->start();
-				individual_ptr bestIndIteration(m_bestInd);
-
-				for (size_t genCount = 0; m_terminationStrategy->event(m_bestInd, genCount); ++genCount)
-				{
-					m_listener->startGeneration(genCount);
-					for (size_t i = 0; i < m_popSize; ++i)
-					{
-						mutation_strategy::mutation_info mutationInfo((*m_mutationStrategy)(*m_pop1, bestIndIteration, i));
-
-						individual_ptr tmpInd(std::get< 0 >(mutationInfo));
+		selection_strategy_ptr get() const { return m_strategy; }
+	};
 
-						tmpInd->ensureConstraints(m_constraints, std::get< 1 >(mutationInfo));
+	/**
+	 * 运行时多态的选择策略是否是一对一的只能在运行时确定
+	 */
+	inline bool one_to_one_selection(const dynamic_selection& selection)
+	{
+		return selection.get()->one_to_one();
+	}
 
-						// 
-						m_processors->push(tmpInd);
+	/**
+	 * 转发到运行时多态的终止策略（termination_strategy_ptr）的终止策略适配器
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class dynamic_termination
+	{
+	private:
+		termination_strategy_ptr m_strategy;
 
-						// ʱtempIndһvectorУڴ֮ǰǿյģڴ֮󽫱ƶȷλá
-						(*m_pop2)[i] = tmpInd;
-					}
+	public:
+		explicit dynamic_termination(termination_strategy_ptr strategy)
+			: m_strategy(strategy)
+		{
+			assert(strategy);
+		}
 
-					m_listener->startProcessors(genCount);
-					m_processors->start();
-					m_processors->wait();
-					m_listener->endProcessors(genCount);
+		bool event(const run_statistics& stats) { return m_strategy->event(stats); }
+	};
 
-					//BestParentChildSelectionStrategy()( m_pop1, m_pop2, m_bestInd, m_minimize );
-					m_listener->startSelection(genCount);
-					(*m_selectionStrategy)(m_pop1, m_pop2, m_bestInd, m_minimize);
-					bestIndIteration = m_bestInd;
+	/**
+	 * 转发到运行时多态的侦听器（listener_ptr）的侦听器适配器
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class dynamic_listener
+	{
+	private:
+		listener_ptr m_listener;
 
-					m_listener->endSelection(genCount);
+	public:
+		explicit dynamic_listener(listener_ptr listener)
+			: m_listener(listener)
+		{
+			assert(listener);
+		}
 
-					m_listener->endGeneration(genCount, bestIndIteration, m_bestInd);
+		void start() { m_listener->start(); }
+		void end() { m_listener->end(); }
+		void error() { m_listener->error(); }
+		void startGeneration(size_t genCount) { m_listener->startGeneration(genCount); }
+		void endGeneration(size_t genCount, individual_ptr bestIndGen, individual_ptr bestInd) { m_listener->endGeneration(genCount, bestIndGen, bestInd); }
+		void startSelection(size_t genCount) { m_listener->startSelection(genCount); }
+		void endSelection(size_t genCount) { m_listener->endSelection(genCount); }
+		void startProcessors(size_t genCount) { m_listener->startProcessors(genCount); }
+		void endProcessors(size_t genCount) { m_listener->endProcessors(genCount); }
+
+		listener_ptr get() const { return m_listener; }
+	};
 
-				}
+	/**
+	 * 运行时多态的侦听器是否需要运行统计只能在运行时确定
+	 */
+	inline void attach_statistics(dynamic_listener& listener, run_statistics_ptr stats)
+	{
+		statistics_listener* l(dynamic_cast< statistics_listener* >(listener.get().get()));
+		if (l)
+			l->attach(stats);
+	}
 
-				//BOOST_SCOPE_EXIT_TPL( (m_listener) )
-				//{
-				m_listener->end();
-				//} 
-				//BOOST_SCOPE_EXIT_END
-			}
-			catch (const processors_exception&)
-			{
-				m_listener->error();
-				throw differential_evolution_exception();
-			}
+	/**
+	 * 变量个数在编译时确定（D > 0）的差分进化，即fixed_differential_evolution< T, D >，
+	 * 变量存放在个体内的std::array< double, D >中，运行时不分配内存。
+	 *
+	 * D为0（缺省）时是下面的运行时版本differential_evolution< T >。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T, size_t D = 0 > class differential_evolution
+		: public fixed_differential_evolution< T, D >
+	{
+	public:
+		using fixed_differential_evolution< T, D >::fixed_differential_evolution;
+	};
 
-		}
+	/**
+	 * 差分进化算法主类
+	 *
+	 * 根据各种输入参数或策略运行优化过程。
+	 *
+	 * 这是basic_differential_evolution的运行时多态版本：变异、选择、终止策略和侦听器通过shared_ptr传入，
+	 * 在运行时组合；目标函数由处理器集合并行计算。策略在编译时已知、需要避免虚函数调用时，
+	 * 可以直接使用basic_differential_evolution。
+	 *
+	 * @author louiehan (11/11/2019)
+	 */
+	template< typename T > class differential_evolution< T, 0 >
+		: public basic_differential_evolution< T, dynamic_mutation, dynamic_selection, dynamic_termination, dynamic_listener, parallel_evaluator< T > >
+	{
+	private:
+		typedef basic_differential_evolution< T, dynamic_mutation, dynamic_selection, dynamic_termination, dynamic_listener, parallel_evaluator< T > > base;
 
+	public:
 		/**
-		 * Ż̲Ѹ塣
+		 * 构造一个differential_evolution对象
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @return individual_ptr
+		 * @param varCount 变量总数。它包括目标函数所需的变量，但具有算法所需的更多元素；
+		 * @param popSize 在一个种群中的所有个体的数量；
+		 * @param processors 优化会话期间使用的并行处理器数；
+		 * @param constraints 约束向量，其中包含目标函数使用的变量的约束以及算法内部使用的所有其他变量的约束；
+		 * @param minimize 如果为true，将尝试最小化成本；如果为false，则将尝试最大化成本；
+		 * @param terminationStrategy 终止策略；
+		 * @param selectionStrategy 选择策略；
+		 * @param mutationStrategy 变异策略；
+		 * @param listener 侦听器；
+		 * @param populationSizeStrategy 可选的种群规模策略，为空时种群规模保持不变。
+		 * @param feasibility 可选的可行性规则，违反程度过大的试验个体不计算目标函数（见feasibility_rule）。
+		 * @param initial 可选的初始种群，为空时在约束范围内随机生成。
 		 */
-		individual_ptr best() const { return m_bestInd; }
+		differential_evolution(size_t varCount, size_t popSize, typename processors< T >::processors_ptr processors, constraints_ptr constraints, bool minimize,
+			termination_strategy_ptr terminationStrategy, selection_strategy_ptr selectionStrategy,
+			mutation_strategy_ptr mutationStrategy, de::listener_ptr listener, population_size_strategy_ptr populationSizeStrategy = population_size_strategy_ptr(),
+			feasibility_rule_ptr feasibility = feasibility_rule_ptr(), population_ptr initial = population_ptr())
+			: base(varCount, popSize, parallel_evaluator< T >(processors), constraints, minimize, dynamic_termination(terminationStrategy),
+				dynamic_selection(selectionStrategy), dynamic_mutation(mutationStrategy), dynamic_listener(listener), populationSizeStrategy, feasibility, initial)
+		{
+		}
+
+		virtual ~differential_evolution(void)
+		{
+		}
 	};
 
 }
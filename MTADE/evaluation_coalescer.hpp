@@ -0,0 +1,365 @@
+#ifndef DE_EVALUATION_COALESCER_HPP_INCLUDED
+#define DE_EVALUATION_COALESCER_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "boost_noncopyable.hpp"
+#include "evaluator.hpp"
+#include "objective_function.h"
+#include "processors.hpp"
+
+namespace de
+{
+
+	/**
+	 * 合并计算的统计
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	struct coalescing_statistics
+	{
+		/**
+		 * 批量目标函数的调用次数
+		 */
+		size_t calls;
+		/**
+		 * 计算的个体数
+		 */
+		size_t evaluations;
+		/**
+		 * 因为达到批大小而开始的调用次数，其余的因为等待时间到达上限而开始
+		 */
+		size_t fullCalls;
+		/**
+		 * 个体从提交到所在的调用开始的总时间（秒）
+		 */
+		double waitSeconds;
+		/**
+		 * 批量目标函数调用的总时间（秒）
+		 */
+		double callSeconds;
+
+		coalescing_statistics()
+			: calls(0), evaluations(0), fullCalls(0), waitSeconds(0), callSeconds(0)
+		{
+		}
+
+		/**
+		 * 返回平均的批大小
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double mean_batch() const { return calls > 0 ? double(evaluations) / calls : 0; }
+
+		/**
+		 * 返回个体平均的等待时间（秒）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double mean_wait() const { return evaluations > 0 ? waitSeconds / evaluations : 0; }
+	};
+
+	/**
+	 * 把多个引擎提交的个体合并成批量目标函数（batch_objective_function）的一次调用，再把代价分给各个个体。
+	 *
+	 * 等待的个体达到batchSize个，或者最早的个体已经等待了maxWait时，开始一次调用，最多包含batchSize个个体。
+	 * 合并器没有自己的线程：调用由正在等待的引擎线程之一进行（谁发现批已就绪谁调用），其他引擎的个体也在其中。
+	 * 同时进行的调用最多为concurrency个；大于1时批量目标函数要能在几个线程中同时被调用。
+	 *
+	 * maxWait是延迟和吞吐量之间的折中：等待越久，批越大，每个个体分摊的调用开销越小。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class evaluation_coalescer : boost::noncopyable
+	{
+	private:
+		typedef std::chrono::steady_clock clock_type;
+
+		// 一个引擎一次提交的个体
+		struct request
+		{
+			size_t remaining;
+			bool error;
+		};
+
+		typedef std::shared_ptr< request > request_ptr;
+
+		struct item
+		{
+			individual_ptr ind;
+			request_ptr owner;
+			clock_type::time_point queued;
+		};
+
+		batch_objective_function_ptr m_of;
+		const size_t m_batchSize;
+		const clock_type::duration m_maxWait;
+		const size_t m_concurrency;
+
+		std::mutex m_mx;
+		std::condition_variable m_cv;
+		std::deque< item > m_pending;
+		size_t m_running;
+		coalescing_statistics m_statistics;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param of 批量目标函数
+		 * @param batchSize 一次调用的最大个体数
+		 * @param maxWait 个体在开始调用之前的最长等待时间
+		 * @param concurrency 同时进行的调用的最大数
+		 */
+		evaluation_coalescer(batch_objective_function_ptr of, size_t batchSize, clock_type::duration maxWait, size_t concurrency = 1)
+			: m_of(of), m_batchSize(batchSize), m_maxWait(maxWait), m_concurrency(concurrency), m_running(0)
+		{
+			assert(of);
+			assert(batchSize > 0);
+			assert(concurrency > 0);
+		}
+
+		/**
+		 * 计算种群中每个个体的代价，语义与计算策略相同（见serial_evaluator）
+		 *
+		 * 目标函数出错时抛出processors_exception。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 种群
+		 * @param deadline 截止时间
+		 * @param token 停止令牌
+		 * @param mode 取消方式
+		 *
+		 * @return bool 所有个体都计算完时为true
+		 */
+		bool evaluate(const population& pop, clock_type::time_point deadline, const stop_token& token, cancellation mode)
+		{
+			request_ptr req(std::make_shared< request >());
+			req->remaining = pop.size();
+			req->error = false;
+
+			std::unique_lock< std::mutex > lock(m_mx);
+
+			const clock_type::time_point now(clock_type::now());
+			for (population::size_type i = 0; i < pop.size(); ++i)
+			{
+				item it = { pop[i], req, now };
+				m_pending.push_back(it);
+			}
+
+			// 新的个体可能使批达到batchSize
+			m_cv.notify_all();
+
+			// 停止令牌没有通知机制，等待时每隔一毫秒检查一次
+			const std::chrono::milliseconds poll(1);
+
+			for (;;)
+			{
+				if (req->remaining == 0)
+				{
+					if (req->error)
+						throw processors_exception("objective function error");
+
+					return true;
+				}
+
+				if (token.stop_requested() || clock_type::now() >= deadline)
+				{
+					req->remaining -= remove(req);
+
+					if (mode == cancellation::drain)
+						m_cv.wait(lock, [&req]() { return req->remaining == 0; });
+
+					return false;
+				}
+
+				if (m_running < m_concurrency && ready(clock_type::now()))
+				{
+					call(lock);
+					continue;
+				}
+
+				clock_type::time_point until(deadline);
+				if (token.stop_possible())
+					until = std::min(until, clock_type::now() + poll);
+				if (!m_pending.empty() && m_running < m_concurrency)
+					until = std::min(until, m_pending.front().queued + m_maxWait);
+
+				if (until == clock_type::time_point::max())
+					m_cv.wait(lock);
+				else
+					m_cv.wait_until(lock, until);
+			}
+		}
+
+		/**
+		 * 返回统计
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return coalescing_statistics
+		 */
+		coalescing_statistics statistics()
+		{
+			std::lock_guard< std::mutex > lock(m_mx);
+			return m_statistics;
+		}
+
+		size_t batch_size() const { return m_batchSize; }
+		clock_type::duration max_wait() const { return m_maxWait; }
+
+	private:
+		bool ready(clock_type::time_point now) const
+		{
+			return m_pending.size() >= m_batchSize || (!m_pending.empty() && now - m_pending.front().queued >= m_maxWait);
+		}
+
+		// 删除一次提交中还没有开始计算的个体，返回删除的个数
+		size_t remove(const request_ptr& req)
+		{
+			const size_t before(m_pending.size());
+			m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), [&req](const item& it) { return it.owner == req; }), m_pending.end());
+
+			return before - m_pending.size();
+		}
+
+		// 取出最早的最多batchSize个个体，在不持有锁时调用批量目标函数，然后分发代价
+		void call(std::unique_lock< std::mutex >& lock)
+		{
+			const size_t count(std::min(m_batchSize, m_pending.size()));
+			const bool full(count == m_batchSize);
+
+			std::vector< item > batch(m_pending.begin(), m_pending.begin() + count);
+			m_pending.erase(m_pending.begin(), m_pending.begin() + count);
+			++m_running;
+
+			lock.unlock();
+
+			const clock_type::time_point start(clock_type::now());
+
+			std::vector< DVectorPtr > args(count);
+			std::vector< double > costs(count, 0);
+			for (size_t i = 0; i < count; ++i)
+			{
+				batch[i].ind->context().start();
+				args[i] = batch[i].ind->vars();
+			}
+
+			bool error(false);
+			try
+			{
+				(*m_of)(args, costs);
+			}
+			catch (const objective_function_exception&)
+			{
+				error = true;
+			}
+
+			const clock_type::time_point end(clock_type::now());
+
+			lock.lock();
+
+			--m_running;
+			++m_statistics.calls;
+			m_statistics.evaluations += count;
+			m_statistics.fullCalls += full ? 1 : 0;
+			m_statistics.callSeconds += std::chrono::duration< double >(end - start).count();
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				m_statistics.waitSeconds += std::chrono::duration< double >(start - batch[i].queued).count();
+
+				if (error)
+					batch[i].owner->error = true;
+				else
+					batch[i].ind->setCost(costs[i]);
+
+				--batch[i].owner->remaining;
+			}
+
+			m_cv.notify_all();
+		}
+	};
+
+	/**
+	 * A smart pointer to an evaluation_coalescer
+	 */
+	typedef std::shared_ptr< evaluation_coalescer > evaluation_coalescer_ptr;
+
+	/**
+	 * 通过共享的合并器（evaluation_coalescer）计算的计算策略，参见parallel_evaluator。
+	 *
+	 * 同一个合并器可以被在不同线程中运行的多个引擎使用，它们的个体被合并成批量目标函数的调用。
+	 * 使用这个计算策略的basic_differential_evolution的模板参数Objective可以是batch_objective_function_ptr，它不被使用。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class coalesced_evaluator
+	{
+	private:
+		evaluation_coalescer_ptr m_coalescer;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param coalescer 合并器
+		 */
+		explicit coalesced_evaluator(evaluation_coalescer_ptr coalescer)
+			: m_coalescer(coalescer)
+		{
+			assert(coalescer);
+		}
+
+		/**
+		 * 计算种群中每个个体的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 种群
+		 * @param deadline 截止时间
+		 * @param token 停止令牌
+		 * @param mode 取消方式
+		 *
+		 * @return bool 所有个体都计算完时为true
+		 */
+		bool operator()(const population& pop, std::chrono::steady_clock::time_point deadline, const stop_token& token, cancellation mode)
+		{
+			return m_coalescer->evaluate(pop, deadline, token, mode);
+		}
+
+		/**
+		 * 返回合并器
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return evaluation_coalescer_ptr
+		 */
+		evaluation_coalescer_ptr get() const { return m_coalescer; }
+	};
+
+}
+
+#endif //DE_EVALUATION_COALESCER_HPP_INCLUDED
@@ -0,0 +1,160 @@
+#ifndef DE_EVALUATION_CONTEXT_HPP_INCLUDED
+#define DE_EVALUATION_CONTEXT_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <limits>
+
+#include "de_types.hpp"
+
+namespace de
+{
+
+	/**
+	 * 一次目标函数计算的上下文：截断代价（cutoff）和提前放弃的标记。
+	 *
+	 * 使用一对一的选择（例如tournament_selection_strategy）时，试验个体只有不差于同一索引的父个体才有意义，
+	 * 差分进化把父个体的代价作为试验个体的截断代价。代价是大量数据或仿真步骤的累加和的目标函数，
+	 * 在部分和已经确定比截断代价差时可以停止计算，返回lose(partial)。这样的代价是被截断的（censored）：
+	 * 它只是真实代价的一个界，个体在选择中一定落败，运行统计不会把它当作种群的代价。
+	 *
+	 * 没有截断代价时（初始种群，或者选择策略不是一对一的），exceeded()总是返回false。
+	 *
+	 * 每个个体有一个上下文（见individual::context），同一时刻只有一个处理器计算它，不需要同步。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class evaluation_context
+	{
+	private:
+		double m_cutoff;
+		bool m_minimize;
+		bool m_lost;
+
+	public:
+		/**
+		 * 构造没有截断代价的上下文
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		evaluation_context()
+			: m_cutoff(std::numeric_limits< double >::infinity()), m_minimize(true), m_lost(false)
+		{
+		}
+
+		/**
+		 * 设定截断代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param cutoff 截断代价，通常是父个体的代价
+		 * @param minimize 如果为true，代价大于截断代价时落败，否则代价小于截断代价时落败
+		 */
+		void set_cutoff(double cutoff, bool minimize)
+		{
+			m_cutoff = cutoff;
+			m_minimize = minimize;
+		}
+
+		/**
+		 * 删除截断代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void clear_cutoff()
+		{
+			m_minimize = true;
+			m_cutoff = std::numeric_limits< double >::infinity();
+		}
+
+		/**
+		 * 是否设定了有限的截断代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool has_cutoff() const { return m_cutoff > -std::numeric_limits< double >::infinity() && m_cutoff < std::numeric_limits< double >::infinity(); }
+
+		/**
+		 * 返回截断代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double cutoff() const { return m_cutoff; }
+
+		/**
+		 * 如果为true，代价越小越好
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool minimize() const { return m_minimize; }
+
+		/**
+		 * 部分代价是否已经严格差于截断代价。部分代价必须是真实代价的界：继续计算只会使它更差
+		 * （最小化时例如非负项的部分和）。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param partial 部分代价
+		 *
+		 * @return bool
+		 */
+		bool exceeded(double partial) const { return m_minimize ? partial > m_cutoff : partial < m_cutoff; }
+
+		/**
+		 * 放弃计算：标记个体落败并返回部分代价，目标函数用return context.lose(partial);结束计算
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param partial 部分代价，必须满足exceeded(partial)
+		 *
+		 * @return double partial
+		 */
+		double lose(double partial)
+		{
+			m_lost = true;
+			return partial;
+		}
+
+		/**
+		 * 上一次计算是否被放弃，这时个体的代价是被截断的
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool lost() const { return m_lost; }
+
+		/**
+		 * 在每次计算之前调用，清除放弃的标记
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void start() { m_lost = false; }
+	};
+
+	/**
+	 * 调用目标函数：目标函数接受evaluation_context时传入上下文，否则只传入参数向量
+	 */
+	template< typename F > auto invoke_objective(F& f, DVectorPtr vars, evaluation_context& context, int) -> decltype(f(vars, context))
+	{
+		return f(vars, context);
+	}
+
+	template< typename F > auto invoke_objective(F& f, DVectorPtr vars, evaluation_context&, long) -> decltype(f(vars))
+	{
+		return f(vars);
+	}
+
+}
+
+#endif //DE_EVALUATION_CONTEXT_HPP_INCLUDED
@@ -0,0 +1,591 @@
+#ifndef DE_EVALUATION_SCHEDULER_HPP_INCLUDED
+#define DE_EVALUATION_SCHEDULER_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "boost_noncopyable.hpp"
+#include "cpu_quota.hpp"
+#include "evaluator.hpp"
+#include "objective_function.h"
+#include "processors.hpp"
+
+namespace de
+{
+
+	/**
+	 * 调度器从哪个作业取下一个计算
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	enum class scheduling_policy
+	{
+		/**
+		 * 按权重分配处理器时间：取得到的时间除以权重最小的作业
+		 */
+		fair_share,
+		/**
+		 * 优先级高的作业先计算，优先级相同的作业之间按权重分配
+		 */
+		priority
+	};
+
+	/**
+	 * 一个作业的统计
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	struct job_metrics
+	{
+		/**
+		 * 提交的计算数
+		 */
+		size_t submitted;
+		/**
+		 * 完成的计算数
+		 */
+		size_t evaluations;
+		/**
+		 * 被取消（没有开始）的计算数
+		 */
+		size_t cancelled;
+		/**
+		 * 目标函数抛出异常的计算数
+		 */
+		size_t errors;
+		/**
+		 * 计算占用处理器线程的总时间（秒）
+		 */
+		double busySeconds;
+		/**
+		 * 计算在队列中等待的总时间（秒）
+		 */
+		double waitSeconds;
+		/**
+		 * 同时进行的计算的最大数
+		 */
+		size_t maxInFlight;
+
+		job_metrics()
+			: submitted(0), evaluations(0), cancelled(0), errors(0), busySeconds(0), waitSeconds(0), maxInFlight(0)
+		{
+		}
+
+		/**
+		 * 返回平均的排队时间（秒）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double mean_wait() const { return evaluations > 0 ? waitSeconds / evaluations : 0; }
+	};
+
+	/**
+	 * 多个优化作业共享的计算调度器：固定数量的处理器线程为所有作业计算目标函数，作业本身没有线程。
+	 *
+	 * 每个作业（例如一个差分进化引擎，通过scheduled_evaluator）把一代的计算提交到自己的队列，然后等待它们完成。
+	 * 空闲的处理器线程按调度策略选择一个作业并取出它的下一个计算：fair_share按权重分配处理器时间
+	 * （虚拟时间：每个作业得到的时间除以权重，取最小的），priority先计算优先级高的作业。
+	 * 作业可以限制同时进行的计算数（cap），达到上限时处理器线程计算其他作业。
+	 *
+	 * 调度器只有一个互斥量，每个计算加锁两次，适合每次计算至少几微秒的目标函数。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class evaluation_scheduler : boost::noncopyable
+	{
+	public:
+		class job;
+		typedef std::shared_ptr< job > job_ptr;
+
+		/**
+		 * 一个作业：计算队列、调度参数和统计。由evaluation_scheduler::add_job创建。
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		class job : boost::noncopyable
+		{
+			friend class evaluation_scheduler;
+
+		private:
+			typedef std::chrono::steady_clock clock_type;
+
+			struct task
+			{
+				std::function< void() > run;
+				clock_type::time_point queued;
+			};
+
+			evaluation_scheduler& m_scheduler;
+			const double m_weight;
+			const int m_priority;
+			const size_t m_cap;
+
+			std::deque< task > m_tasks;
+			std::condition_variable m_done;
+			size_t m_outstanding;
+			size_t m_inFlight;
+			double m_virtualTime;
+			bool m_error;
+			bool m_removed;
+			job_metrics m_metrics;
+
+		public:
+			job(evaluation_scheduler& scheduler, double weight, int priority, size_t cap)
+				: m_scheduler(scheduler), m_weight(weight), m_priority(priority), m_cap(cap), m_outstanding(0), m_inFlight(0), m_virtualTime(0),
+				m_error(false), m_removed(false)
+			{
+				assert(weight > 0);
+			}
+
+			/**
+			 * 提交计算，它们在处理器线程中按提交的顺序开始
+			 *
+			 * @author louiehan (10/19/2026)
+			 *
+			 * @param tasks 计算，抛出objective_function_exception表示目标函数错误
+			 */
+			void submit(const std::vector< std::function< void() > >& tasks)
+			{
+				const clock_type::time_point now(clock_type::now());
+
+				{
+					std::lock_guard< std::mutex > lock(m_scheduler.m_mx);
+					assert(!m_removed);
+
+					for (size_t n = 0; n < tasks.size(); ++n)
+					{
+						task t = { tasks[n], now };
+						m_tasks.push_back(t);
+					}
+
+					m_outstanding += tasks.size();
+					m_metrics.submitted += tasks.size();
+				}
+
+				m_scheduler.m_work.notify_all();
+			}
+
+			/**
+			 * 等待所有提交的计算完成（包括被放弃之后仍在进行的计算）
+			 *
+			 * 有目标函数错误时抛出processors_exception。
+			 *
+			 * @author louiehan (10/19/2026)
+			 */
+			void wait()
+			{
+				std::unique_lock< std::mutex > lock(m_scheduler.m_mx);
+				m_done.wait(lock, [this]() { return m_outstanding == 0; });
+
+				check_error();
+			}
+
+			/**
+			 * 最多等待到deadline，参见wait()
+			 *
+			 * @author louiehan (10/19/2026)
+			 *
+			 * @param deadline 截止时间
+			 *
+			 * @return bool 所有计算都已完成时为true
+			 */
+			bool wait_until(clock_type::time_point deadline)
+			{
+				std::unique_lock< std::mutex > lock(m_scheduler.m_mx);
+				if (!m_done.wait_until(lock, deadline, [this]() { return m_outstanding == 0; }))
+					return false;
+
+				check_error();
+				return true;
+			}
+
+			/**
+			 * 删除还没有开始的计算，正在进行的计算继续
+			 *
+			 * @author louiehan (10/19/2026)
+			 *
+			 * @return size_t 被删除的计算数
+			 */
+			size_t cancel()
+			{
+				std::lock_guard< std::mutex > lock(m_scheduler.m_mx);
+				return cancel_locked();
+			}
+
+			/**
+			 * 返回作业的统计
+			 *
+			 * @author louiehan (10/19/2026)
+			 *
+			 * @return job_metrics
+			 */
+			job_metrics metrics() const
+			{
+				std::lock_guard< std::mutex > lock(m_scheduler.m_mx);
+				return m_metrics;
+			}
+
+			double weight() const { return m_weight; }
+			int priority() const { return m_priority; }
+			size_t cap() const { return m_cap; }
+
+		private:
+			bool eligible() const { return !m_tasks.empty() && (m_cap == 0 || m_inFlight < m_cap); }
+
+			size_t cancel_locked()
+			{
+				const size_t count(m_tasks.size());
+
+				m_tasks.clear();
+				m_outstanding -= count;
+				m_metrics.cancelled += count;
+
+				if (m_outstanding == 0)
+					m_done.notify_all();
+
+				return count;
+			}
+
+			void check_error()
+			{
+				if (m_error)
+				{
+					m_error = false;
+					throw processors_exception("objective function error");
+				}
+			}
+		};
+
+	private:
+		mutable std::mutex m_mx;
+		std::condition_variable m_work;
+		std::vector< job_ptr > m_jobs;
+		std::vector< std::thread > m_workers;
+		const scheduling_policy m_policy;
+		bool m_stop;
+
+	public:
+		/**
+		 * 构造函数，启动处理器线程
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param workers 处理器线程数，0表示按CPU限额确定（见cpu_quota）
+		 * @param policy 调度策略
+		 */
+		explicit evaluation_scheduler(size_t workers = 0, scheduling_policy policy = scheduling_policy::fair_share)
+			: m_policy(policy), m_stop(false)
+		{
+			if (workers == 0)
+				workers = cpu_quota::detect().workers();
+
+			for (size_t n = 0; n < workers; ++n)
+				m_workers.push_back(std::thread([this]() { work(); }));
+		}
+
+		/**
+		 * 删除所有还没有开始的计算，等待处理器线程结束
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		~evaluation_scheduler()
+		{
+			{
+				std::lock_guard< std::mutex > lock(m_mx);
+
+				m_stop = true;
+				for (size_t n = 0; n < m_jobs.size(); ++n)
+					m_jobs[n]->cancel_locked();
+			}
+
+			m_work.notify_all();
+
+			for (size_t n = 0; n < m_workers.size(); ++n)
+				m_workers[n].join();
+		}
+
+		/**
+		 * 返回进程范围的共享调度器，第一次调用时创建（处理器线程数按CPU限额确定，fair_share）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return std::shared_ptr< evaluation_scheduler >
+		 */
+		static std::shared_ptr< evaluation_scheduler > shared()
+		{
+			static std::shared_ptr< evaluation_scheduler > scheduler(std::make_shared< evaluation_scheduler >());
+			return scheduler;
+		}
+
+		/**
+		 * 添加一个作业
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param weight 分配处理器时间的权重
+		 * @param priority 优先级，只用于priority策略，大的先计算
+		 * @param cap 同时进行的计算的上限，0表示没有上限
+		 *
+		 * @return job_ptr
+		 */
+		job_ptr add_job(double weight = 1, int priority = 0, size_t cap = 0)
+		{
+			job_ptr j(std::make_shared< job >(*this, weight, priority, cap));
+
+			std::lock_guard< std::mutex > lock(m_mx);
+
+			// 新作业从当前最小的虚拟时间开始，不能用之前空闲的时间占用处理器
+			double minimum(std::numeric_limits< double >::max());
+			for (size_t n = 0; n < m_jobs.size(); ++n)
+				minimum = std::min(minimum, m_jobs[n]->m_virtualTime);
+
+			j->m_virtualTime = m_jobs.empty() ? 0 : minimum;
+			m_jobs.push_back(j);
+
+			return j;
+		}
+
+		/**
+		 * 删除作业：删除还没有开始的计算，等待正在进行的计算完成
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param j 作业
+		 */
+		void remove_job(job_ptr j)
+		{
+			std::unique_lock< std::mutex > lock(m_mx);
+
+			j->cancel_locked();
+			j->m_done.wait(lock, [&j]() { return j->m_outstanding == 0; });
+			j->m_removed = true;
+
+			m_jobs.erase(std::remove(m_jobs.begin(), m_jobs.end(), j), m_jobs.end());
+		}
+
+		/**
+		 * 返回处理器线程数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t workers() const { return m_workers.size(); }
+
+		/**
+		 * 返回作业数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t jobs() const
+		{
+			std::lock_guard< std::mutex > lock(m_mx);
+			return m_jobs.size();
+		}
+
+	private:
+		// 按调度策略选择有可以开始的计算的作业，没有时为null
+		job* select()
+		{
+			job* best(nullptr);
+
+			for (size_t n = 0; n < m_jobs.size(); ++n)
+			{
+				job* j(m_jobs[n].get());
+				if (!j->eligible())
+					continue;
+
+				if (!best || (m_policy == scheduling_policy::priority && j->m_priority != best->m_priority ? j->m_priority > best->m_priority : j->m_virtualTime < best->m_virtualTime))
+					best = j;
+			}
+
+			return best;
+		}
+
+		void work()
+		{
+			typedef std::chrono::steady_clock clock_type;
+			std::unique_lock< std::mutex > lock(m_mx);
+
+			for (;;)
+			{
+				job* j(nullptr);
+				m_work.wait(lock, [this, &j]() { return m_stop || (j = select()) != nullptr; });
+
+				if (m_stop)
+					return;
+
+				job::task t(j->m_tasks.front());
+				j->m_tasks.pop_front();
+
+				++j->m_inFlight;
+				j->m_metrics.maxInFlight = std::max(j->m_metrics.maxInFlight, j->m_inFlight);
+
+				lock.unlock();
+
+				const clock_type::time_point start(clock_type::now());
+				bool error(false);
+
+				try
+				{
+					t.run();
+				}
+				catch (const objective_function_exception&)
+				{
+					error = true;
+				}
+
+				const double busy(std::chrono::duration< double >(clock_type::now() - start).count());
+
+				lock.lock();
+
+				--j->m_inFlight;
+				--j->m_outstanding;
+				j->m_virtualTime += busy / j->m_weight;
+				j->m_metrics.busySeconds += busy;
+				j->m_metrics.waitSeconds += std::chrono::duration< double >(start - t.queued).count();
+
+				if (error)
+				{
+					j->m_error = true;
+					++j->m_metrics.errors;
+				}
+				else
+					++j->m_metrics.evaluations;
+
+				if (j->m_outstanding == 0)
+					j->m_done.notify_all();
+
+				// 完成的计算可能使达到上限的作业可以再开始一个计算
+				if (j->m_cap > 0)
+					m_work.notify_all();
+			}
+		}
+	};
+
+	/**
+	 * A smart pointer to an evaluation_scheduler
+	 */
+	typedef std::shared_ptr< evaluation_scheduler > evaluation_scheduler_ptr;
+
+	/**
+	 * 把每代的计算提交给共享的计算调度器（evaluation_scheduler）的一个作业的计算策略，参见parallel_evaluator。
+	 *
+	 * 目标函数由processor_traits< T >::make创建一次，被调度器的所有处理器线程同时调用，因此必须是线程安全的
+	 * （与多个处理器共享同一个目标函数对象时相同）。作业由调用者创建，引擎结束之后用remove_job删除。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T > class scheduled_evaluator
+	{
+	private:
+		typedef typename processor_traits< T >::value_type value_type;
+
+		evaluation_scheduler::job_ptr m_job;
+		std::shared_ptr< value_type > m_of;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param j 调度器中的作业
+		 * @param of 目标函数，或目标函数工厂
+		 */
+		scheduled_evaluator(evaluation_scheduler::job_ptr j, T of)
+			: m_job(j), m_of(std::make_shared< value_type >(processor_traits< T >::make(of)))
+		{
+			assert(j);
+		}
+
+		/**
+		 * 计算种群中每个个体的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 种群
+		 * @param deadline 截止时间
+		 * @param token 停止令牌
+		 * @param mode 取消方式
+		 *
+		 * @return bool 所有个体都计算完时为true
+		 */
+		bool operator()(const population& pop, std::chrono::steady_clock::time_point deadline, const stop_token& token, cancellation mode)
+		{
+			std::vector< std::function< void() > > tasks;
+			tasks.reserve(pop.size());
+
+			std::shared_ptr< value_type > of(m_of);
+			for (population::size_type i = 0; i < pop.size(); ++i)
+			{
+				individual_ptr ind(pop[i]);
+				tasks.push_back([of, ind]()
+				{
+					ind->context().start();
+					ind->setCost(processor_traits< T >::run(*of, ind->vars(), ind->context()));
+				});
+			}
+
+			m_job->submit(tasks);
+
+			if (deadline == std::chrono::steady_clock::time_point::max() && !token.stop_possible())
+			{
+				m_job->wait();
+				return true;
+			}
+
+			// 停止令牌没有通知机制，等待时每隔一毫秒检查一次
+			const std::chrono::milliseconds poll(1);
+
+			for (;;)
+			{
+				std::chrono::steady_clock::time_point until(token.stop_possible() ? std::min(deadline, std::chrono::steady_clock::now() + poll) : deadline);
+
+				if (m_job->wait_until(until))
+					return true;
+
+				if (token.stop_requested() || std::chrono::steady_clock::now() >= deadline)
+				{
+					m_job->cancel();
+
+					if (mode == cancellation::drain)
+						m_job->wait();
+
+					return false;
+				}
+			}
+		}
+
+		/**
+		 * 返回作业
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return evaluation_scheduler::job_ptr
+		 */
+		evaluation_scheduler::job_ptr get() const { return m_job; }
+	};
+
+}
+
+#endif //DE_EVALUATION_SCHEDULER_HPP_INCLUDED
@@ -0,0 +1,198 @@
+#ifndef DE_EVALUATOR_HPP_INCLUDED
+#define DE_EVALUATOR_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "multithread.hpp"
+#include "population.hpp"
+#include "processors.hpp"
+
+namespace de
+{
+
+	/**
+	 * 截止时间到达或收到停止请求时如何处理正在进行的目标函数计算。
+	 *
+	 * 两种方式都不再开始新的计算（队列中剩余的试验个体被删除），未完成的一代被丢弃。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	enum class cancellation
+	{
+		/**
+		 * 等待正在进行的计算完成之后返回，超出截止时间的时间不超过一次目标函数计算的时间
+		 */
+		drain,
+		/**
+		 * 立即返回，正在进行的计算在后台完成，下一次运行或处理器集合析构时等待它们
+		 */
+		abandon
+	};
+
+	/**
+	 * 在调用线程中依次计算种群中每个个体的代价的计算策略，目标函数的调用可以被内联。
+	 *
+	 * 计算策略是basic_differential_evolution的模板参数，必须提供
+	 *
+	 *   bool operator()(const population& pop, std::chrono::steady_clock::time_point deadline, const stop_token& token, cancellation mode);
+	 *
+	 * 计算完所有个体时返回true；到达截止时间或收到停止请求时返回false，这时种群中的代价是不完整的。
+	 *
+	 * 目标函数的耗时很短、线程同步的开销占主要部分时，串行计算比处理器集合更快。
+	 * 截止时间和停止请求在两次计算之间检查，因此两种取消方式都等待正在进行的一次计算。
+	 *
+	 * 模板参数T与processors< T >相同：目标函数对象、指针、共享指针或目标函数工厂。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T > class serial_evaluator
+	{
+	private:
+		typename processor_traits< T >::value_type m_of;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param of 目标函数，或目标函数工厂
+		 */
+		explicit serial_evaluator(T of)
+			: m_of(processor_traits< T >::make(of))
+		{
+		}
+
+		/**
+		 * 计算种群中每个个体的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 种群
+		 * @param deadline 截止时间
+		 * @param token 停止令牌
+		 * @param mode 取消方式
+		 *
+		 * @return bool 所有个体都计算完时为true
+		 */
+		bool operator()(const population& pop, std::chrono::steady_clock::time_point deadline, const stop_token& token, cancellation mode)
+		{
+			const bool unbounded(deadline == std::chrono::steady_clock::time_point::max() && !token.stop_possible());
+
+			for (population::size_type i = 0; i < pop.size(); ++i)
+			{
+				if (!unbounded && (token.stop_requested() || std::chrono::steady_clock::now() >= deadline))
+					return false;
+
+				pop[i]->context().start();
+				pop[i]->setCost(processor_traits< T >::run(m_of, pop[i]->vars(), pop[i]->context()));
+			}
+
+			return true;
+		}
+	};
+
+	/**
+	 * 用处理器集合（processors< T >）并行计算种群中每个个体的代价的计算策略，参见serial_evaluator。
+	 *
+	 * 到达截止时间或收到停止请求时，删除还没有开始计算的个体，按mode等待或放弃正在进行的计算。
+	 *
+	 * 模板参数P是处理器集合的类型，也可以是接口相同的async_processors< T >（见async_evaluator）。
+	 *
+	 * 几个在不同线程中运行的引擎可以共享一个处理器集合：它们使用同一个互斥量，每次计算一代时持有它，
+	 * 因此各个引擎的代轮流使用处理器线程，而变异和选择仍然并行进行。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T, typename P = processors< T > > class parallel_evaluator
+	{
+	private:
+		typename P::processors_ptr m_processors;
+		std::shared_ptr< std::mutex > m_shared;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param processors 处理器集合
+		 * @param shared 共享处理器集合的引擎使用的互斥量，只有一个引擎使用处理器集合时为空
+		 */
+		explicit parallel_evaluator(typename P::processors_ptr processors, std::shared_ptr< std::mutex > shared = std::shared_ptr< std::mutex >())
+			: m_processors(processors), m_shared(shared)
+		{
+			assert(processors);
+		}
+
+		/**
+		 * 计算种群中每个个体的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 种群
+		 * @param deadline 截止时间
+		 * @param token 停止令牌
+		 * @param mode 取消方式
+		 *
+		 * @return bool 所有个体都计算完时为true
+		 */
+		bool operator()(const population& pop, std::chrono::steady_clock::time_point deadline, const stop_token& token, cancellation mode)
+		{
+			std::unique_lock< std::mutex > lock;
+			if (m_shared)
+				lock = std::unique_lock< std::mutex >(*m_shared);
+
+			m_processors->push(pop);
+			m_processors->start();
+
+			if (deadline == std::chrono::steady_clock::time_point::max() && !token.stop_possible())
+			{
+				m_processors->wait();
+				return true;
+			}
+
+			// 停止令牌没有通知机制，等待时每隔一毫秒检查一次
+			const std::chrono::milliseconds poll(1);
+
+			for (;;)
+			{
+				std::chrono::steady_clock::time_point until(token.stop_possible() ? std::min(deadline, std::chrono::steady_clock::now() + poll) : deadline);
+
+				if (m_processors->wait_until(until))
+					return true;
+
+				if (token.stop_requested() || std::chrono::steady_clock::now() >= deadline)
+				{
+					m_processors->cancel();
+
+					if (mode == cancellation::drain)
+						m_processors->wait();
+
+					return false;
+				}
+			}
+		}
+
+		/**
+		 * 返回处理器集合
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return processors_ptr
+		 */
+		typename P::processors_ptr get() const { return m_processors; }
+	};
+
+}
+
+#endif //DE_EVALUATOR_HPP_INCLUDED
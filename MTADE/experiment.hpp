@@ -0,0 +1,695 @@
+#ifndef DE_EXPERIMENT_HPP_INCLUDED
+#define DE_EXPERIMENT_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "differential_evolution.hpp"
+#include "objective_function.h"
+#include "ud_string.hpp"
+
+namespace de
+{
+
+	/**
+	 * 扫描规格无效或实验无法运行时抛出的异常
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class experiment_exception : public exception
+	{
+	public:
+		/**
+		 * 以错误信息为参数的构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param message
+		 */
+		experiment_exception(const std::string& message)
+			: exception(message.c_str())
+		{
+		}
+	};
+
+	/**
+	 * 实验使用的目标函数及其变量的缺省定义域
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	struct objective_info
+	{
+		objective_function_ptr function;
+		double min;
+		double max;
+	};
+
+	/**
+	 * 按名字创建目标函数："sphere"、"route"、"rastrigin"或"rosenbrock"。
+	 *
+	 * 目标函数是无状态的，可以被一次运行的所有处理器共享。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param name 目标函数的名字
+	 *
+	 * @return objective_info
+	 */
+	inline objective_info make_objective(const std::string& name)
+	{
+		objective_info info;
+
+		if (name == "sphere")
+		{
+			info.function = std::make_shared< sphere_function >();
+			info.min = -100;
+			info.max = 100;
+		}
+		else if (name == "route")
+		{
+			info.function = std::make_shared< evaluation_route >();
+			info.min = -100;
+			info.max = 100;
+		}
+		else if (name == "rastrigin")
+		{
+			info.function = std::make_shared< rastrigin_function >();
+			info.min = -5.12;
+			info.max = 5.12;
+		}
+		else if (name == "rosenbrock")
+		{
+			info.function = std::make_shared< rosenbrock_function >();
+			info.min = -30;
+			info.max = 30;
+		}
+		else
+			throw experiment_exception("unknown objective function \"" + name + "\"");
+
+		return info;
+	}
+
+	/**
+	 * 按编号创建变异策略：1-5为mutation_strategy_1到mutation_strategy_5，6为shade_mutation_strategy
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param n 变异策略的编号
+	 * @param varCount 变量的个数
+	 * @param args 变异策略参数
+	 *
+	 * @return mutation_strategy_ptr
+	 */
+	inline mutation_strategy_ptr make_mutation_strategy(size_t n, size_t varCount, const mutation_strategy_arguments& args)
+	{
+		switch (n)
+		{
+		case 1:
+			return std::make_shared< mutation_strategy_1 >(varCount, args);
+		case 2:
+			return std::make_shared< mutation_strategy_2 >(varCount, args);
+		case 3:
+			return std::make_shared< mutation_strategy_3 >(varCount, args);
+		case 4:
+			return std::make_shared< mutation_strategy_4 >(varCount, args);
+		case 5:
+			return std::make_shared< mutation_strategy_5 >(varCount, args);
+		case 6:
+			return std::make_shared< shade_mutation_strategy >(varCount, args);
+		default:
+			throw experiment_exception("mutation strategy must be between 1 and 6");
+		}
+	}
+
+	/**
+	 * 按名字创建选择策略："best_parent_child"或"tournament"
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param name 选择策略的名字
+	 *
+	 * @return selection_strategy_ptr
+	 */
+	inline selection_strategy_ptr make_selection_strategy(const std::string& name)
+	{
+		if (name == "best_parent_child")
+			return std::make_shared< best_parent_child_selection_strategy >();
+		else if (name == "tournament")
+			return std::make_shared< tournament_selection_strategy >();
+		else
+			throw experiment_exception("unknown selection strategy \"" + name + "\"");
+	}
+
+	/**
+	 * 扫描规格。
+	 *
+	 * 列表型的参数（目标函数、变异策略、选择策略、F、CR、NP）的笛卡尔积构成实验的所有配置，
+	 * 每个配置独立运行repetitions次。规格文件每行一个参数，格式为"name = value1, value2, ..."，
+	 * '#'之后的内容为注释，例如：
+	 *
+	 *   function = sphere, rastrigin
+	 *   mutation = 1, 3
+	 *   selection = best_parent_child, tournament
+	 *   F = 0.5, 0.8
+	 *   CR = 0.1, 0.9
+	 *   NP = 50, 100
+	 *   D = 10
+	 *   generations = 500
+	 *   repetitions = 25
+	 *   seed = 12345
+	 *   threads_per_run = 1
+	 *   thread_budget = 8	# 0表示使用所有的硬件线程
+	 *   minimize = true
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class sweep_spec
+	{
+	public:
+		std::vector< std::string > functions;
+		std::vector< size_t > mutations;
+		std::vector< std::string > selections;
+		std::vector< double > weights;
+		std::vector< double > crossovers;
+		std::vector< size_t > popSizes;
+
+		size_t varCount;
+		size_t generations;
+		size_t repetitions;
+		unsigned long seed;
+		size_t threadsPerRun;
+		size_t threadBudget;
+		bool minimize;
+
+	public:
+		/**
+		 * 构造一个只有一个配置的缺省规格
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		sweep_spec()
+			: functions(1, "sphere"), mutations(1, 1), selections(1, "best_parent_child"), weights(1, 0.5), crossovers(1, 0.9),
+			popSizes(1, 50), varCount(10), generations(1000), repetitions(25), seed(1), threadsPerRun(1), threadBudget(0), minimize(true)
+		{
+		}
+
+		/**
+		 * 从输入流中读取规格，未出现的参数保持原值
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param is 输入流
+		 */
+		void parse(std::istream& is)
+		{
+			std::string line;
+
+			while (std::getline(is, line))
+			{
+				std::string::size_type comment(line.find('#'));
+				if (comment != std::string::npos)
+					line.erase(comment);
+
+				std::string::size_type eq(line.find('='));
+				std::vector< std::string > key(tokens(line.substr(0, eq)));
+
+				if (eq == std::string::npos)
+				{
+					if (!key.empty())
+						throw experiment_exception("wrong line format in \"" + line + "\" - expected name = values");
+
+					continue;
+				}
+
+				std::vector< std::string > values(tokens(line.substr(eq + 1)));
+
+				if (key.size() != 1 || values.empty())
+					throw experiment_exception("wrong line format in \"" + line + "\" - expected name = values");
+
+				set(udstr::tolower(key[0]), values);
+			}
+		}
+
+		/**
+		 * 从文件中读取规格
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param path 规格文件的路径
+		 */
+		void load(const std::string& path)
+		{
+			std::ifstream is(path.c_str());
+
+			if (!is)
+				throw experiment_exception("could not open the sweep spec \"" + path + "\"");
+
+			parse(is);
+		}
+
+	private:
+		static std::vector< std::string > tokens(const std::string& str)
+		{
+			std::vector< std::string > all(udstr::bs_split(str, std::string("[\\s,;]+")));
+			std::vector< std::string > result;
+
+			for (std::vector< std::string >::size_type n = 0; n < all.size(); ++n)
+			{
+				if (!all[n].empty())
+					result.push_back(all[n]);
+			}
+
+			return result;
+		}
+
+		static double to_double(const std::string& value)
+		{
+			try
+			{
+				return std::stod(value);
+			}
+			catch (const std::exception&)
+			{
+				throw experiment_exception("invalid number \"" + value + "\"");
+			}
+		}
+
+		static size_t to_size(const std::string& value)
+		{
+			try
+			{
+				return std::stoul(value);
+			}
+			catch (const std::exception&)
+			{
+				throw experiment_exception("invalid integer \"" + value + "\"");
+			}
+		}
+
+		static std::vector< double > to_doubles(const std::vector< std::string >& values)
+		{
+			std::vector< double > numbers;
+			for (std::vector< std::string >::size_type n = 0; n < values.size(); ++n)
+				numbers.push_back(to_double(values[n]));
+
+			return numbers;
+		}
+
+		static std::vector< size_t > to_sizes(const std::vector< std::string >& values)
+		{
+			std::vector< size_t > numbers;
+			for (std::vector< std::string >::size_type n = 0; n < values.size(); ++n)
+				numbers.push_back(to_size(values[n]));
+
+			return numbers;
+		}
+
+		void set(const std::string& key, const std::vector< std::string >& values)
+		{
+			if (key == "function")
+				functions = values;
+			else if (key == "selection")
+				selections = values;
+			else if (key == "mutation")
+				mutations = to_sizes(values);
+			else if (key == "np")
+				popSizes = to_sizes(values);
+			else if (key == "f")
+				weights = to_doubles(values);
+			else if (key == "cr")
+				crossovers = to_doubles(values);
+			else if (values.size() != 1)
+				throw experiment_exception("parameter \"" + key + "\" takes a single value");
+			else if (key == "d")
+				varCount = to_size(values[0]);
+			else if (key == "generations")
+				generations = to_size(values[0]);
+			else if (key == "repetitions")
+				repetitions = to_size(values[0]);
+			else if (key == "seed")
+				seed = to_size(values[0]);
+			else if (key == "threads_per_run")
+				threadsPerRun = to_size(values[0]);
+			else if (key == "thread_budget")
+				threadBudget = to_size(values[0]);
+			else if (key == "minimize")
+				minimize = udstr::tolower(values[0]) == "true" || values[0] == "1";
+			else
+				throw experiment_exception("unknown parameter \"" + key + "\"");
+		}
+	};
+
+	/**
+	 * 实验的一个配置，即扫描规格中的列表型参数的一个组合
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	struct experiment_config
+	{
+		std::string function;
+		size_t mutation;
+		std::string selection;
+		double weight;
+		double crossover;
+		size_t popSize;
+	};
+
+	/**
+	 * 一次运行的结果
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	struct run_result
+	{
+		unsigned long seed;
+		double cost;
+		double seconds;
+		bool failed;
+
+		run_result()
+			: seed(0), cost(std::numeric_limits< double >::quiet_NaN()), seconds(0), failed(true)
+		{
+		}
+	};
+
+	/**
+	 * 一组运行的最终代价的统计值
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class cost_statistics
+	{
+	public:
+		size_t count;
+		double mean;
+		double stddev;
+		double median;
+		double best;
+		double worst;
+
+	public:
+		/**
+		 * 计算统计值
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param costs 各次运行的最终代价
+		 * @param minimize 如果为true，代价越小越好，否则代价越大越好
+		 */
+		cost_statistics(std::vector< double > costs, bool minimize)
+			: count(costs.size()), mean(std::numeric_limits< double >::quiet_NaN()), stddev(mean), median(mean), best(mean), worst(mean)
+		{
+			if (costs.empty())
+				return;
+
+			std::sort(costs.begin(), costs.end());
+
+			double sum(0);
+			for (std::vector< double >::size_type n = 0; n < costs.size(); ++n)
+				sum += costs[n];
+
+			mean = sum / costs.size();
+
+			double sq(0);
+			for (std::vector< double >::size_type n = 0; n < costs.size(); ++n)
+				sq += (costs[n] - mean) * (costs[n] - mean);
+
+			stddev = costs.size() > 1 ? std::sqrt(sq / (costs.size() - 1)) : 0;
+
+			size_t middle(costs.size() / 2);
+			median = costs.size() % 2 ? costs[middle] : (costs[middle - 1] + costs[middle]) / 2;
+
+			best = minimize ? costs.front() : costs.back();
+			worst = minimize ? costs.back() : costs.front();
+		}
+	};
+
+	/**
+	 * 并行实验运行器。
+	 *
+	 * 将扫描规格展开为配置，每个配置的每次重复都是一个独立的差分进化实例。多个实例在
+	 * 运行线程中并行运行，每个实例使用threadsPerRun个处理器，同时运行的实例数由总的线程
+	 * 预算决定，因此所有实例的处理器线程之和不会超过预算。
+	 *
+	 * 每次运行都在运行线程的随机数引擎上设定由(seed, 配置, 重复)导出的种子，因此结果与
+	 * 调度顺序和并行度无关，并且可以单独重现。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class experiment_runner
+	{
+	private:
+		sweep_spec m_spec;
+		std::vector< experiment_config > m_configs;
+		std::vector< run_result > m_results;
+
+	public:
+		/**
+		 * 构造函数，检查规格并展开所有的配置
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param spec 扫描规格
+		 */
+		experiment_runner(const sweep_spec& spec)
+			: m_spec(spec)
+		{
+			if (spec.varCount == 0 || spec.repetitions == 0 || spec.threadsPerRun == 0)
+				throw experiment_exception("D, repetitions and threads_per_run must be greater than 0");
+
+			for (size_t f = 0; f < spec.functions.size(); ++f)
+				for (size_t m = 0; m < spec.mutations.size(); ++m)
+					for (size_t s = 0; s < spec.selections.size(); ++s)
+						for (size_t w = 0; w < spec.weights.size(); ++w)
+							for (size_t c = 0; c < spec.crossovers.size(); ++c)
+								for (size_t p = 0; p < spec.popSizes.size(); ++p)
+								{
+									// 变异策略需要4个与当前个体不同的个体
+									if (spec.popSizes[p] < 5)
+										throw experiment_exception("NP must be at least 5");
+
+									experiment_config config = { spec.functions[f], spec.mutations[m], spec.selections[s], spec.weights[w], spec.crossovers[c], spec.popSizes[p] };
+									m_configs.push_back(config);
+								}
+		}
+
+		virtual ~experiment_runner()
+		{
+		}
+
+		/**
+		 * 运行所有配置的所有重复，直到全部完成才返回
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void run()
+		{
+			const size_t tasks(m_configs.size() * m_spec.repetitions);
+			const size_t budget(m_spec.threadBudget > 0 ? m_spec.threadBudget : std::max< size_t >(1, std::thread::hardware_concurrency()));
+			const size_t concurrent(std::min(tasks, std::max< size_t >(1, budget / m_spec.threadsPerRun)));
+
+			m_results.assign(tasks, run_result());
+
+			std::atomic< size_t > next(0);
+			std::vector< std::thread > runners;
+
+			for (size_t n = 0; n < concurrent; ++n)
+			{
+				runners.push_back(std::thread([this, &next, tasks]()
+				{
+					for (size_t task = next++; task < tasks; task = next++)
+						m_results[task] = run_one(task / m_spec.repetitions, task % m_spec.repetitions);
+				}));
+			}
+
+			for (size_t n = 0; n < runners.size(); ++n)
+				runners[n].join();
+		}
+
+		/**
+		 * 返回展开后的所有配置
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const std::vector< experiment_config >&
+		 */
+		const std::vector< experiment_config >& configs() const { return m_configs; }
+
+		/**
+		 * 返回一次运行的结果
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param config 配置的索引
+		 * @param repetition 重复的索引
+		 *
+		 * @return const run_result&
+		 */
+		const run_result& result(size_t config, size_t repetition) const
+		{
+			return m_results.at(config * m_spec.repetitions + repetition);
+		}
+
+		/**
+		 * 返回扫描规格
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const sweep_spec&
+		 */
+		const sweep_spec& spec() const { return m_spec; }
+
+		/**
+		 * 计算一个配置的所有成功运行的最终代价的统计值
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param config 配置的索引
+		 *
+		 * @return cost_statistics
+		 */
+		cost_statistics statistics(size_t config) const
+		{
+			std::vector< double > costs;
+
+			for (size_t r = 0; r < m_spec.repetitions; ++r)
+			{
+				const run_result& res(result(config, r));
+				if (!res.failed)
+					costs.push_back(res.cost);
+			}
+
+			return cost_statistics(costs, m_spec.minimize);
+		}
+
+		/**
+		 * 以CSV格式输出所有配置的统计表，每个配置一行
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param os 输出流
+		 */
+		void write_table(std::ostream& os) const
+		{
+			os << "function,mutation,selection,F,CR,NP,D,runs,failed,mean,std,median,best,worst,mean_seconds" << std::endl;
+
+			for (size_t c = 0; c < m_configs.size(); ++c)
+			{
+				const experiment_config& config(m_configs[c]);
+				cost_statistics stats(statistics(c));
+
+				double seconds(0);
+				for (size_t r = 0; r < m_spec.repetitions; ++r)
+					seconds += result(c, r).seconds;
+
+				os << config.function << ',' << config.mutation << ',' << config.selection << ',' << config.weight << ',' << config.crossover << ','
+					<< config.popSize << ',' << m_spec.varCount << ',' << m_spec.repetitions << ',' << m_spec.repetitions - stats.count << ','
+					<< stats.mean << ',' << stats.stddev << ',' << stats.median << ',' << stats.best << ',' << stats.worst << ','
+					<< seconds / m_spec.repetitions << std::endl;
+			}
+		}
+
+		/**
+		 * 返回一次运行的种子，由规格的种子、配置索引和重复索引导出
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param config 配置的索引
+		 * @param repetition 重复的索引
+		 *
+		 * @return unsigned long
+		 */
+		unsigned long run_seed(size_t config, size_t repetition) const
+		{
+			std::seed_seq seq{ static_cast< uint32_t >(m_spec.seed), static_cast< uint32_t >(config), static_cast< uint32_t >(repetition) };
+			uint32_t seed[1];
+			seq.generate(seed, seed + 1);
+
+			return seed[0];
+		}
+
+	protected:
+		/**
+		 * 为一次运行创建监听器，缺省不输出任何信息。
+		 *
+		 * 从多个运行线程中并发调用，派生类返回的监听器只能由对应的那次运行使用。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param config 配置的索引
+		 * @param repetition 重复的索引
+		 *
+		 * @return listener_ptr
+		 */
+		virtual listener_ptr make_listener(size_t config, size_t repetition)
+		{
+			return std::make_shared< quiet_listener >();
+		}
+
+	private:
+		run_result run_one(size_t config, size_t repetition)
+		{
+			const experiment_config& c(m_configs[config]);
+
+			run_result result;
+			result.seed = run_seed(config, repetition);
+
+			// 本次运行的所有随机数都来自运行线程的引擎
+			seed_generator(result.seed);
+
+			try
+			{
+				objective_info objective(make_objective(c.function));
+
+				constraints_ptr constraints(std::make_shared< constraints >(m_spec.varCount, objective.min, objective.max));
+				processor_listener_ptr processor_listener(std::make_shared< null_processor_listener >());
+				processors< objective_function_ptr >::processors_ptr _processors(std::make_shared< processors< objective_function_ptr > >(m_spec.threadsPerRun, objective.function, processor_listener));
+
+				termination_strategy_ptr terminationStrategy(std::make_shared< max_gen_termination_strategy >(m_spec.generations));
+				selection_strategy_ptr selectionStrategy(make_selection_strategy(c.selection));
+				mutation_strategy_ptr mutationStrategy(make_mutation_strategy(c.mutation, m_spec.varCount, mutation_strategy_arguments(c.weight, c.crossover)));
+
+				std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+
+				differential_evolution< objective_function_ptr > de(m_spec.varCount, c.popSize, _processors, constraints, m_spec.minimize,
+					terminationStrategy, selectionStrategy, mutationStrategy, make_listener(config, repetition));
+
+				de.run();
+
+				result.cost = de.best()->cost();
+				result.seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+				result.failed = false;
+			}
+			catch (const differential_evolution_exception&)
+			{
+				result.failed = true;
+			}
+			catch (const de::exception&)
+			{
+				result.failed = true;
+			}
+
+			return result;
+		}
+	};
+
+}
+
+#endif //DE_EXPERIMENT_HPP_INCLUDED
@@ -0,0 +1,317 @@
+#ifndef DE_FEASIBILITY_HPP_INCLUDED
+#define DE_FEASIBILITY_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <algorithm>
+
+#include "population.hpp"
+#include "selection_strategy.hpp"
+
+namespace de
+{
+
+	/**
+	 * 非线性约束函数的抽象基类。
+	 *
+	 * 范围约束（constraints）在生成试验个体时修复；不能修复的非线性约束（例如g_k(x) <= 0）由约束函数
+	 * 计算违反程度，通常是sum(max(0, g_k(x)))。约束函数应该比目标函数便宜得多：它在生产者一侧
+	 * （差分进化的线程中）对每个试验个体计算，违反程度过大的试验个体不会进入处理器集合的队列。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class constraint_function
+	{
+	public:
+		virtual ~constraint_function() {}
+
+		/**
+		 * 在派生类中实现，计算约束的违反程度
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param args 参数向量
+		 *
+		 * @return double 违反程度，0表示满足所有的约束，负值按0处理
+		 */
+		virtual double operator()(DVectorPtr args) = 0;
+	};
+
+	/**
+	 * Smart pointer to a constraint function
+	 */
+	typedef std::shared_ptr< constraint_function > constraint_function_ptr;
+
+	/**
+	 * 可行性规则：计算个体的违反程度，决定哪些试验个体需要计算目标函数，并比较两个个体。
+	 *
+	 * 比较使用epsilon约束法：违反程度不超过epsilon的个体视为可行，两个可行的个体比较代价，
+	 * 可行的个体优于不可行的个体，两个不可行的个体比较违反程度。epsilon为0时就是Deb的可行性规则。
+	 *
+	 * epsilon从epsilon0开始，在前controlGenerations代内按(1 - t / controlGenerations)^exponent递减到0，之后保持为0。
+	 * 只有违反程度不超过当前epsilon的试验个体才计算目标函数；其余的试验个体不计算，代价设为最差值
+	 * （最小化时为正无穷大），它们只按违反程度参与比较。epsilon不会增大，因此没有计算过代价的个体
+	 * 以后也不会被当作可行的个体比较代价。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class feasibility_rule
+	{
+	private:
+		constraint_function_ptr m_function;
+		const double m_epsilon0;
+		const size_t m_controlGenerations;
+		const double m_exponent;
+
+		double m_epsilon;
+
+	public:
+		/**
+		 * 构造使用Deb可行性规则（epsilon为0）的对象
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param function 约束函数
+		 */
+		explicit feasibility_rule(constraint_function_ptr function)
+			: m_function(function), m_epsilon0(0), m_controlGenerations(0), m_exponent(1), m_epsilon(0)
+		{
+			assert(function);
+		}
+
+		/**
+		 * 构造使用epsilon约束法的对象
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param function 约束函数
+		 * @param epsilon0 初始的epsilon
+		 * @param controlGenerations epsilon递减到0的代数
+		 * @param exponent 递减的指数
+		 */
+		feasibility_rule(constraint_function_ptr function, double epsilon0, size_t controlGenerations, double exponent = 2)
+			: m_function(function), m_epsilon0(epsilon0), m_controlGenerations(controlGenerations), m_exponent(exponent), m_epsilon(epsilon0)
+		{
+			assert(function);
+			assert(epsilon0 >= 0);
+			assert(exponent > 0);
+		}
+
+		/**
+		 * 在每一代（包括初始种群，genCount为0）开始时调用，更新epsilon
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param genCount 进化代数
+		 */
+		void start_generation(size_t genCount)
+		{
+			m_epsilon = genCount < m_controlGenerations ? m_epsilon0 * std::pow(1.0 - double(genCount) / m_controlGenerations, m_exponent) : 0.0;
+		}
+
+		/**
+		 * 返回当前的epsilon
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double epsilon() const { return m_epsilon; }
+
+		/**
+		 * 计算个体的违反程度并保存在个体中
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param ind 个体
+		 */
+		void evaluate(individual& ind) const
+		{
+			ind.setViolation(std::max(0.0, (*m_function)(ind.vars())));
+		}
+
+		/**
+		 * 个体是否需要计算目标函数：违反程度不超过当前的epsilon
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param ind 已经计算了违反程度的个体
+		 *
+		 * @return bool
+		 */
+		bool admits(const individual& ind) const { return ind.violation() <= m_epsilon; }
+
+		/**
+		 * 不计算目标函数的个体的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param minimize 是否最小化
+		 *
+		 * @return double
+		 */
+		static double rejected_cost(bool minimize)
+		{
+			return minimize ? std::numeric_limits< double >::infinity() : -std::numeric_limits< double >::infinity();
+		}
+
+		/**
+		 * 按epsilon约束法比较两个个体：ind1优于或等于ind2时返回true
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param ind1 个体
+		 * @param ind2 个体
+		 * @param minimize 是否最小化
+		 *
+		 * @return bool
+		 */
+		bool better_or_equal(const individual_ptr& ind1, const individual_ptr& ind2, bool minimize) const
+		{
+			assert(ind1 && ind2);
+
+			const bool feasible1(admits(*ind1));
+			const bool feasible2(admits(*ind2));
+
+			if (feasible1 && feasible2)
+				return ind1->better_or_equal(ind2, minimize);
+
+			if (feasible1 != feasible2)
+				return feasible1;
+
+			return ind1->violation() <= ind2->violation();
+		}
+
+		/**
+		 * 按epsilon约束法比较两个个体：ind1严格优于ind2时返回true
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param ind1 个体
+		 * @param ind2 个体
+		 * @param minimize 是否最小化
+		 *
+		 * @return bool
+		 */
+		bool better(const individual_ptr& ind1, const individual_ptr& ind2, bool minimize) const
+		{
+			return !better_or_equal(ind2, ind1, minimize);
+		}
+
+		/**
+		 * 按epsilon约束法返回种群中最好的个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 种群
+		 * @param minimize 是否最小化
+		 *
+		 * @return individual_ptr
+		 */
+		individual_ptr best(const population& pop, bool minimize) const
+		{
+			assert(!pop.empty());
+
+			individual_ptr best(pop[0]);
+			for (population::size_type i = 1; i < pop.size(); ++i)
+			{
+				if (!better_or_equal(best, pop[i], minimize))
+					best = pop[i];
+			}
+
+			return best;
+		}
+	};
+
+	/**
+	 * A smart pointer to a feasibility_rule
+	 */
+	typedef std::shared_ptr< feasibility_rule > feasibility_rule_ptr;
+
+	/**
+	 * 使用可行性规则的选择策略：与tournament_selection_strategy相同，比较同一索引的父个体和试验个体，
+	 * 但按feasibility_rule比较。应该与差分进化的可行性规则使用同一个对象。
+	 *
+	 * 选择监听器只收到两个个体都可行（都计算了代价）的比较，使自适应的变异策略只根据代价的改进调整参数。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class feasibility_selection_strategy : public selection_strategy
+	{
+	private:
+		feasibility_rule_ptr m_rule;
+
+	public:
+		/**
+		 * constructs a feasibility_selection_strategy
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param rule 可行性规则
+		 */
+		explicit feasibility_selection_strategy(feasibility_rule_ptr rule)
+			: m_rule(rule)
+		{
+			assert(rule);
+		}
+
+		/**
+		 * 重载操作符（） applies the selection strategy
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop1 old population
+		 * @param pop2 new population
+		 * @param bestInd reference to the best individual - contains
+		 *  			  the best individual on return
+		 * @param minimize if true, it will minimize, if false it will
+		 *  			   maximize
+		 * @param listener 可选的选择监听器
+		 */
+		void operator()(population_ptr& pop1, population_ptr& pop2, individual_ptr& bestInd, bool minimize, selection_listener_ptr listener = selection_listener_ptr())
+		{
+			assert(pop1);
+			assert(pop2);
+
+			assert(pop1->size() == pop2->size());
+
+			// epsilon可能已经减小，最好的个体在存活的个体中按当前的epsilon重新确定
+			bestInd = individual_ptr();
+
+			for (size_t i = 0; i < pop1->size(); ++i)
+			{
+				individual_ptr crt((*pop2)[i]);
+				const bool won(!crt->censored() && m_rule->better_or_equal(crt, (*pop1)[i], minimize));
+
+				if (listener && m_rule->admits(*crt) && m_rule->admits(*(*pop1)[i]))
+					listener->selected(i, (*pop1)[i], crt, won);
+
+				if (!won)
+					(*pop2)[i] = (*pop1)[i];
+
+				if (!bestInd || m_rule->better_or_equal((*pop2)[i], bestInd, minimize))
+					bestInd = (*pop2)[i];
+
+				if (listener)
+					listener->survived((*pop2)[i]);
+			}
+
+			if (listener)
+				listener->end_selection();
+
+			std::swap(pop1, pop2);
+		}
+
+		virtual bool one_to_one() const { return true; }
+	};
+
+}
+
+#endif //DE_FEASIBILITY_HPP_INCLUDED
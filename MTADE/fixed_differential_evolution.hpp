@@ -0,0 +1,472 @@
+#ifndef DE_FIXED_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
+#define DE_FIXED_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include "boost_noncopyable.hpp"
+#include "constraint_table.hpp"
+#include "crossover_strategy.hpp"
+#include "de_constraints.hpp"
+#include "mutation_strategy.hpp"
+#include "random_generator.hpp"
+
+namespace de
+{
+
+	/**
+	 * 变量个数在编译时确定的个体：变量直接存放在个体中（std::array），种群是个体的连续数组，
+	 * 不需要每个个体一个共享指针和一个堆上的vector。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< size_t D > class fixed_individual
+	{
+	public:
+		/**
+		 * 变量的类型
+		 */
+		typedef std::array< double, D > vars_type;
+
+	private:
+		vars_type m_vars;
+		double m_cost;
+
+	public:
+		fixed_individual()
+			: m_cost(0)
+		{
+			m_vars.fill(0);
+		}
+
+		/**
+		 * 返回变量
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return vars_type&
+		 */
+		vars_type& vars() { return m_vars; }
+		const vars_type& vars() const { return m_vars; }
+
+		/**
+		 * 返回个体的代价值
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double cost() const { return m_cost; }
+
+		/**
+		 * 设置个体的代价值
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param cost
+		 */
+		void setCost(double cost) { m_cost = cost; }
+
+		/**
+		 * 与individual::better_or_equal相同：代价优于或等于另一个个体时返回true
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param ind 另一个个体
+		 * @param minimize 为true时代价越小越优
+		 *
+		 * @return bool
+		 */
+		bool better_or_equal(const fixed_individual& ind, bool minimize) const
+		{
+			return minimize ? m_cost <= ind.m_cost : ind.m_cost <= m_cost;
+		}
+	};
+
+	/**
+	 * 固定维数的差分进化使用的目标函数特征类，与processor_traits对应：目标函数可以按值、指针或共享指针传递。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T > class fixed_objective_traits
+	{
+	public:
+		// \cond
+		typedef T value_type;
+		typedef T object_type;
+		static object_type& get(value_type& t) { return t; }
+		// \endcond
+	};
+
+	template< typename T > class fixed_objective_traits< T* >
+	{
+	public:
+		// \cond
+		typedef T* value_type;
+		typedef T object_type;
+		static object_type& get(value_type t) { return *t; }
+		// \endcond
+	};
+
+	template< typename T > class fixed_objective_traits< std::shared_ptr< T > >
+	{
+	public:
+		// \cond
+		typedef std::shared_ptr< T > value_type;
+		typedef T object_type;
+		static object_type& get(const value_type& t) { return *t; }
+		// \endcond
+	};
+
+	/**
+	 * 从种群中抽取N个互不相同、并且不等于avoid的索引，与mutation_strategy::Urn相同。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param NP 索引的上限（不包括）
+	 * @param avoid 要避免的索引
+	 * @param urn 抽取的索引
+	 */
+	template< size_t N > void fixed_urn(size_t NP, size_t avoid, size_t(&urn)[N])
+	{
+		assert(NP > N);
+
+		for (size_t k = 0; k < N; ++k)
+		{
+			bool repeated;
+
+			do
+			{
+				urn[k] = genintrand(0, NP, true);
+				repeated = urn[k] == avoid;
+
+				for (size_t n = 0; n < k; ++n)
+					repeated = repeated || urn[k] == urn[n];
+			} while (repeated);
+		}
+	}
+
+	/**
+	 * 固定维数的变异策略 DE/rand/1，对应mutation_strategy_1。
+	 *
+	 * 固定维数的变异策略由fixed_differential_evolution调用，必须提供
+	 *
+	 *   void operator()(const std::vector< fixed_individual< D > >& pop, size_t best, size_t i, const constraint_table& table, std::array< double, D >& trial);
+	 *
+	 * 维数D和交叉策略都是编译时常数，内联之后变异和交叉的循环可以完全展开。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< size_t D, typename Crossover = exponential_crossover > class fixed_mutation_strategy_1
+	{
+	private:
+		mutation_strategy_arguments m_args;
+		Crossover m_crossover;
+
+	public:
+		/**
+		 * constructs a fixed_mutation_strategy_1
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param args mutation strategy arguments
+		 */
+		explicit fixed_mutation_strategy_1(const mutation_strategy_arguments& args)
+			: m_args(args)
+		{
+		}
+
+		/**
+		 * 生成第i个个体的试验个体，交叉选中的变量在写入的同时修复
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 当前种群
+		 * @param best 最优个体的索引
+		 * @param i 当前个体的索引
+		 * @param table 约束表
+		 * @param trial 试验个体的变量
+		 */
+		void operator()(const std::vector< fixed_individual< D > >& pop, size_t best, size_t i, const constraint_table& table, std::array< double, D >& trial)
+		{
+			size_t urn[3];
+			fixed_urn(pop.size(), i, urn);
+
+			const std::array< double, D >& x0(pop[urn[0]].vars());
+			const std::array< double, D >& x1(pop[urn[1]].vars());
+			const std::array< double, D >& x2(pop[urn[2]].vars());
+			const double F(m_args.weight());
+
+			trial = pop[i].vars();
+
+			m_crossover(D, m_args.crossover(), [&](size_t j)
+			{
+				trial[j] = table.repair(j, x0[j] + F * (x1[j] - x2[j]), x0[j]);
+			});
+		}
+	};
+
+	/**
+	 * 固定维数的变异策略 DE/rand-to-best/1，对应mutation_strategy_2，参见fixed_mutation_strategy_1。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< size_t D, typename Crossover = exponential_crossover > class fixed_mutation_strategy_2
+	{
+	private:
+		mutation_strategy_arguments m_args;
+		Crossover m_crossover;
+
+	public:
+		/**
+		 * constructs a fixed_mutation_strategy_2
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param args mutation strategy arguments
+		 */
+		explicit fixed_mutation_strategy_2(const mutation_strategy_arguments& args)
+			: m_args(args)
+		{
+		}
+
+		void operator()(const std::vector< fixed_individual< D > >& pop, size_t best, size_t i, const constraint_table& table, std::array< double, D >& trial)
+		{
+			size_t urn[3];
+			fixed_urn(pop.size(), i, urn);
+
+			const std::array< double, D >& x(pop[i].vars());
+			const std::array< double, D >& b(pop[best].vars());
+			const std::array< double, D >& x0(pop[urn[0]].vars());
+			const std::array< double, D >& x1(pop[urn[1]].vars());
+			const std::array< double, D >& x2(pop[urn[2]].vars());
+			const double F(m_args.weight());
+
+			trial = x;
+
+			m_crossover(D, m_args.crossover(), [&](size_t j)
+			{
+				trial[j] = table.repair(j, x[j] + F * (b[j] - x[j]) + F * (x1[j] - x2[j]), x0[j]);
+			});
+		}
+	};
+
+	/**
+	 * 变量个数在编译时确定的差分进化，用于只有几个变量的小问题。
+	 *
+	 * 种群是fixed_individual< D >的两个连续数组（当前种群和试验个体），在构造时分配，运行时
+	 * 不再分配内存；变异、交叉和修复由变异策略内联完成（见fixed_mutation_strategy_1）。
+	 * 目标函数在调用线程中依次计算（小问题的目标函数通常很快，线程同步的开销反而占主要部分），
+	 * 选择方式与tournament_selection_strategy相同：试验个体优于或等于父个体时取代父个体。
+	 *
+	 * 目标函数T可以按值、指针或共享指针传递（见fixed_objective_traits），可以接受
+	 * const std::array< double, D >&；只接受DVectorPtr的目标函数（如objective_function）
+	 * 通过一个在构造时分配的DVector调用，每次计算复制D个变量。
+	 *
+	 * 一般通过differential_evolution< T, D >使用。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T, size_t D, typename Mutation = fixed_mutation_strategy_1< D > > class fixed_differential_evolution : boost::noncopyable
+	{
+	public:
+		/**
+		 * 个体的类型
+		 */
+		typedef fixed_individual< D > individual_type;
+		/**
+		 * 种群的类型
+		 */
+		typedef std::vector< individual_type > population_type;
+
+	private:
+		typename fixed_objective_traits< T >::value_type m_of;
+		constraints_ptr m_constraints;
+		constraint_table m_constraintTable;
+		Mutation m_mutation;
+		const bool m_minimize;
+
+		population_type m_pop;
+		population_type m_trials;
+		size_t m_best;
+
+		// 只接受DVectorPtr的目标函数使用的参数
+		DVectorPtr m_args;
+
+		size_t m_genCount;
+		size_t m_evaluations;
+
+	public:
+		/**
+		 * 构造一个fixed_differential_evolution对象，随机初始化种群并计算它的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param popSize 种群规模，至少为4
+		 * @param of 目标函数
+		 * @param constraints 约束，大小必须为D
+		 * @param minimize 如果为true，将尝试最小化成本；如果为false，则将尝试最大化成本；
+		 * @param mutation 变异策略
+		 */
+		fixed_differential_evolution(size_t popSize, T of, constraints_ptr constraints, bool minimize, const Mutation& mutation)
+			: m_of(of), m_constraints(constraints), m_constraintTable(*constraints), m_mutation(mutation), m_minimize(minimize),
+			m_pop(popSize), m_trials(popSize), m_best(0), m_args(std::make_shared< DVector >(D)), m_genCount(0), m_evaluations(0)
+		{
+			assert(constraints);
+			assert(constraints->size() == D);
+			assert(popSize >= 4);
+
+			for (size_t i = 0; i < m_pop.size(); ++i)
+			{
+				for (size_t j = 0; j < D; ++j)
+					m_pop[i].vars()[j] = constraints->get_rand_value(j);
+
+				m_pop[i].setCost(evaluate(m_pop[i].vars()));
+
+				if (m_pop[i].better_or_equal(m_pop[m_best], m_minimize))
+					m_best = i;
+			}
+		}
+
+		/**
+		 * 构造一个使用DE/rand/1的fixed_differential_evolution对象
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param popSize 种群规模，至少为4
+		 * @param of 目标函数
+		 * @param constraints 约束，大小必须为D
+		 * @param minimize 如果为true，将尝试最小化成本；如果为false，则将尝试最大化成本；
+		 * @param args mutation strategy arguments
+		 */
+		fixed_differential_evolution(size_t popSize, T of, constraints_ptr constraints, bool minimize, const mutation_strategy_arguments& args)
+			: fixed_differential_evolution(popSize, of, constraints, minimize, Mutation(args))
+		{
+		}
+
+		virtual ~fixed_differential_evolution()
+		{
+		}
+
+		/**
+		 * 运行maxGen代（从构造时算起），参见run_while
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param maxGen 最大进化代数
+		 */
+		void run(size_t maxGen)
+		{
+			run_while([maxGen](const individual_type&, size_t genCount) { return genCount < maxGen; });
+		}
+
+		/**
+		 * 运行优化过程，直到终止条件要求停止。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param termination 终止条件，形如bool(const individual_type& best, size_t genCount)，
+		 *					  与termination_strategy::event相同，返回true继续，返回false停止
+		 */
+		template< typename F > void run_while(F termination)
+		{
+			while (termination(m_pop[m_best], m_genCount))
+			{
+				for (size_t i = 0; i < m_pop.size(); ++i)
+				{
+					m_mutation(m_pop, m_best, i, m_constraintTable, m_trials[i].vars());
+					m_trials[i].setCost(evaluate(m_trials[i].vars()));
+				}
+
+				for (size_t i = 0; i < m_pop.size(); ++i)
+				{
+					if (m_trials[i].better_or_equal(m_pop[i], m_minimize))
+					{
+						m_pop[i] = m_trials[i];
+
+						if (m_pop[i].better_or_equal(m_pop[m_best], m_minimize))
+							m_best = i;
+					}
+				}
+
+				++m_genCount;
+			}
+		}
+
+		/**
+		 * 返回最优个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const individual_type&
+		 */
+		const individual_type& best() const { return m_pop[m_best]; }
+
+		/**
+		 * 返回当前种群
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const population_type&
+		 */
+		const population_type& population() const { return m_pop; }
+
+		/**
+		 * 返回已经完成的进化代数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t generation() const { return m_genCount; }
+
+		/**
+		 * 返回目标函数的计算次数，包括初始种群
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t evaluations() const { return m_evaluations; }
+
+		/**
+		 * 返回变异策略
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return Mutation&
+		 */
+		Mutation& mutation() { return m_mutation; }
+
+	private:
+		double evaluate(const std::array< double, D >& vars)
+		{
+			++m_evaluations;
+			return call(fixed_objective_traits< T >::get(m_of), vars, 0);
+		}
+
+		// 目标函数接受std::array时直接调用
+		template< typename F > auto call(F& f, const std::array< double, D >& vars, int) -> decltype(double(f(vars)))
+		{
+			return f(vars);
+		}
+
+		// 否则复制到预先分配的DVector
+		template< typename F > double call(F& f, const std::array< double, D >& vars, long)
+		{
+			std::copy(vars.begin(), vars.end(), m_args->begin());
+			return f(m_args);
+		}
+	};
+
+}
+
+#endif //DE_FIXED_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
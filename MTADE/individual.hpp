@@ -12,6 +12,7 @@
 
 #include "de_types.hpp"
 #include "de_constraints.hpp"
+#include "evaluation_context.hpp"
 #include "multithread.hpp"
 
 namespace de
@@ -21,11 +22,11 @@ namespace de
 	typedef std::shared_ptr< individual > individual_ptr;
 
 	/**
-	 * ֽȺеĸࡣ
+	 * 差分进化种群中的个体类。
 	 *
-	 * ÿһЩصĴۡ
+	 * 每个个体有一组变量和与这些变量相关的代价。
 	 *
-	 * ÿ̰߳ȫġ
+	 * 每个个体是线程安全的。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -34,35 +35,38 @@ namespace de
 	private:
 		de::DVectorPtr m_vars;
 		double m_cost;
+		std::vector< double > m_costs;
+		double m_violation;
+		evaluation_context m_context;
 		de::mutex m_mx;
 
 	public:
 		/**
-		 * 캯
+		 * 个体对象构造函数
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param varCount ÿı
+		 * @param varCount 每个个体的变量的数量
 		 */
 		individual(size_t varCount)
-			: m_vars(std::make_shared< de::DVector >(varCount))
+			: m_vars(std::make_shared< de::DVector >(varCount)), m_violation(0)
 		{
 		}
 
 		/**
-		 * 캯
+		 * 个体对象构造函数
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param vars Ƶڲvectorеıvector
+		 * @param vars 将被复制到内部变量vector容器中的变量vector容器对象。
 		 */
 		individual(const de::DVector& vars)
-			: m_vars(std::make_shared< de::DVector >(vars))
+			: m_vars(std::make_shared< de::DVector >(vars)), m_violation(0)
 		{
 		}
 
 		/**
-		 * ʹԼڵֵʼڲvector
+		 * 使用约束集合内的随机值初始化变量的内部vector容器对象。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -79,7 +83,7 @@ namespace de
 		}
 
 		/**
-		 * ظĴֵ
+		 * 返回个体的代价值
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -88,7 +92,7 @@ namespace de
 		double cost() const { return m_cost; }
 
 		/**
-		 * ʹԭ;ֵΪԼڵֵ
+		 * 使用原点和旧值将变量设置为约束内的新随机值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -118,29 +122,29 @@ namespace de
 		de::DVectorPtr vars() const { return m_vars; }
 
 		/**
-		 * ضԱֵķǳãֵ
+		 * 根据索引返回对变量值的非常量引用，该索引可用作左值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index Ҫõı
+		 * @param index 要返回其引用的变量的索引
 		 *
 		 * @return de::Double&
 		 */
 		de::Double& operator[](size_t index) { return (*m_vars)[index]; }
 
 		/**
-		 * ضԱֵĳãֵ
+		 * 根据索引返回对变量值的常量引用，该索引可用作左值。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index Ҫõı
+		 * @param index 要返回其引用的变量的索引
 		 *
 		 * @return de::Double&
 		 */
 		const de::Double& operator[](size_t index) const { return (*m_vars)[index]; }
 
 		/**
-		 * 趨
+		 * 设定代价
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -149,11 +153,80 @@ namespace de
 		void setCost(double cost) { m_cost = cost; }
 
 		/**
-		 * ݴ۽ǰһбȽϡǰ۵ڻһĴۣ򷵻true
+		 * 设定多目标函数的代价向量。标量代价取第一个目标的代价，用于只比较标量代价的代码（例如显示）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param costs 每个目标的代价
+		 */
+		void setCost(const std::vector< double >& costs)
+		{
+			assert(!costs.empty());
+
+			m_costs = costs;
+			m_cost = costs.front();
+		}
+
+		/**
+		 * 返回多目标函数的代价向量，单目标函数时为空
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const std::vector< double >&
+		 */
+		const std::vector< double >& costs() const { return m_costs; }
+
+		/**
+		 * 返回非线性约束的违反程度（见feasibility_rule），0表示可行
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double violation() const { return m_violation; }
+
+		/**
+		 * 设定非线性约束的违反程度
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param violation 违反程度，不小于0
+		 */
+		void setViolation(double violation) { m_violation = violation; }
+
+		/**
+		 * 返回计算目标函数时使用的上下文，差分进化在计算之前设定截断代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return evaluation_context&
+		 */
+		evaluation_context& context() { return m_context; }
+
+		/**
+		 * 返回计算目标函数时使用的上下文
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const evaluation_context&
+		 */
+		const evaluation_context& context() const { return m_context; }
+
+		/**
+		 * 代价是否是被截断的：目标函数在超过截断代价时提前放弃了计算，代价只是真实代价的界
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool censored() const { return m_context.lost(); }
+
+		/**
+		 * 根据代价将当前个体与另一个个体进行比较。如果当前代价低于或等于另一个个体的代价，则返回true。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param ind ҪȽϵĸ
+		 * @param ind 要比较的个体
 		 *
 		 * @return bool
 		 */
@@ -164,11 +237,11 @@ namespace de
 		}
 
 		/**
-		 * ݴ۽ǰһбȽϡǰϸһĴۣ򷵻true
+		 * 根据代价将当前个体与另一个个体进行比较。如果当前代价严格低于另一个个体的代价，则返回true。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param ind ҪȽϵĸ
+		 * @param ind 要比较的个体
 		 *
 		 * @return bool
 		 */
@@ -179,12 +252,12 @@ namespace de
 		}
 
 		/**
-		 * ݴ۽ǰһбȽϡǰڻһĴۣ
-		 * 򷵻trueŵı׼СڻǴȡminimize־ǸͻǸߡ
+		 * 根据代价将当前个体与另一个个体进行比较。如果当前代价优于或等于另一个个体的代价，
+		 * 则返回true，优的标准是小于还是大于取决于minimize标志是更低还是更高。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param ind ҪȽϵĸ
+		 * @param ind 要比较的个体
 		 * @param minimize <= if true, >= if false
 		 *
 		 * @return bool
@@ -196,12 +269,12 @@ namespace de
 		}
 
 		/**
-		 * ݴ۽ǰһбȽϡǰϸһĴۣ
-		 * 򷵻trueŵı׼СڻǴȡminimize־ǸͻǸߡ
+		 * 根据代价将当前个体与另一个个体进行比较。如果当前代价严格优于另一个个体的代价，
+		 * 则返回true，优的标准是小于还是大于取决于minimize标志是更低还是更高。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param ind ҪȽϵĸ
+		 * @param ind 要比较的个体
 		 * @param minimize < if true, > if false
 		 *
 		 * @return bool
@@ -213,7 +286,7 @@ namespace de
 		}
 
 		/**
-		 * vectorڱĸ
+		 * 返回vector容器内变量的个数
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -222,7 +295,7 @@ namespace de
 		size_t size() const { return m_vars->size(); }
 
 		/**
-		 * ַʽظڲģۺͱб
+		 * 以字符串的形式返回个体内部的（代价和变量列表）。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -247,9 +320,9 @@ namespace de
 	typedef std::queue< individual_ptr > individual_queue_base;
 
 	/**
-	 * ̰߳ȫĸ
+	 * 线程安全的个体队列
 	 *
-	 * ڽҪɲͬݸĿ꺯ĲĸŶӡ
+	 * 用于将包含要由不同处理器传递给目标函数的参数的个体排队。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -260,13 +333,13 @@ namespace de
 
 	public:
 		/**
-		 * ڶеײµĸ塣
+		 * 在队列底部添加新的个体。
 		 *
-		 * ̰߳ȫ
+		 * 数线程安全
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param ind Ҫеĸ
+		 * @param ind 要插入队列中的个体
 		 */
 		void push_back(individual_ptr ind)
 		{
@@ -276,13 +349,13 @@ namespace de
 		}
 
 		/**
-		 * Ӷжɾ壨Уء
+		 * 从队列顶部删除个体（如果有）并返回。
 		 *
-		 * ̰߳ȫ
+		 * 线程安全
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @return individual_ptr жĸ壻ΪգΪnull
+		 * @return individual_ptr 队列顶部的个体；如果队列为空，则为null
 		 */
 		individual_ptr pop()
 		{
@@ -299,6 +372,51 @@ namespace de
 			else
 				return individual_ptr();
 		}
+
+		/**
+		 * 从队列顶部删除最多count个个体并添加到batch中
+		 *
+		 * 线程安全
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param count 最多取出的个体数
+		 * @param batch 接收个体的向量
+		 *
+		 * @return size_t 取出的个体数
+		 */
+		size_t pop(size_t count, std::vector< individual_ptr >& batch)
+		{
+			de::lock lock(m_mx);
+
+			size_t n(0);
+			for (; n < count && !individual_queue_base::empty(); ++n)
+			{
+				batch.push_back(individual_queue_base::front());
+				individual_queue_base::pop();
+			}
+
+			return n;
+		}
+
+		/**
+		 * 删除队列中所有的个体
+		 *
+		 * 线程安全
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t 删除的个体数
+		 */
+		size_t clear()
+		{
+			de::lock lock(m_mx);
+
+			size_t count(individual_queue_base::size());
+			individual_queue_base().swap(*this);
+
+			return count;
+		}
 	};
 
 }
@@ -0,0 +1,339 @@
+#ifndef DE_IPOP_RESTARTS_HPP_INCLUDED
+#define DE_IPOP_RESTARTS_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "differential_evolution.hpp"
+
+namespace de
+{
+
+	/**
+	 * IPOP重启的参数
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	struct ipop_options
+	{
+		/**
+		 * 第一次运行的种群规模
+		 */
+		size_t popSize;
+		/**
+		 * 每次重启时种群规模乘以的倍数
+		 */
+		double growth;
+		/**
+		 * 种群规模的上限
+		 */
+		size_t maxPopSize;
+		/**
+		 * 最多的运行次数（包括第一次）
+		 */
+		size_t runs;
+		/**
+		 * 所有运行的目标函数计算次数的上限，0表示没有上限
+		 */
+		size_t maxEvaluations;
+		/**
+		 * 一次运行连续stagnationGenerations代最优代价的改进都不超过stagnationEpsilon时，认为停滞并重启
+		 */
+		size_t stagnationGenerations;
+		double stagnationEpsilon;
+		/**
+		 * 一次运行的最大代数
+		 */
+		size_t maxGenerations;
+		/**
+		 * 重启时在已知最佳个体附近播种的个体比例，0表示完全随机的初始种群
+		 */
+		double seedFraction;
+		/**
+		 * 播种区域（超立方体）的边占约束范围的百分比，见constraints::get_square_zone_rand_values
+		 */
+		double seedSidePct;
+		/**
+		 * 同时进行的运行数，它们共享同一个处理器集合
+		 */
+		size_t concurrent;
+		/**
+		 * 第r次运行的随机数种子为seed + r
+		 */
+		unsigned long seed;
+
+		ipop_options(size_t popSize_ = 20)
+			: popSize(popSize_), growth(2), maxPopSize(popSize_ * 16), runs(8), maxEvaluations(0), stagnationGenerations(50), stagnationEpsilon(1e-10),
+			maxGenerations(1000), seedFraction(0.2), seedSidePct(10), concurrent(1), seed(1)
+		{
+		}
+	};
+
+	/**
+	 * 一次运行的结果
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	struct ipop_run
+	{
+		size_t index;
+		size_t popSize;
+		size_t generations;
+		size_t evaluations;
+		size_t seeded;
+		double cost;
+	};
+
+	/**
+	 * IPOP（increasing population size）重启的差分进化。
+	 *
+	 * 每次运行是一个differential_evolution< T >的基础引擎，在停滞（stagnation_termination_strategy）或达到最大代数时结束；
+	 * 然后以growth倍的种群规模重新开始。除了第一次运行，初始种群中的seedFraction部分在已知的全局最佳个体附近播种
+	 * （第一个个体就是全局最佳个体，其余的来自constraints::get_square_zone_rand_values），其余的在约束范围内随机生成。
+	 *
+	 * concurrent大于1时，几次运行在各自的线程中同时进行，共享同一个处理器集合（见parallel_evaluator）：
+	 * 不增加计算目标函数的线程，只有变异和选择并行。每次运行开始时播种使用当时已知的全局最佳个体。
+	 * 同时进行的运行每代都把计算次数记入共享的计数，计数达到maxEvaluations时所有运行在当前一代之后停止，
+	 * 超出的计算次数最多是每个运行的一代（或一个初始种群）。
+	 *
+	 * 每次运行使用新的变异策略（由工厂创建，例如SHADE的历史和存档不会带到下一次运行）和同一个选择策略。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T > class ipop_restarts : boost::noncopyable
+	{
+	public:
+		/**
+		 * 为一次运行创建变异策略的函数，参数是变量个数
+		 */
+		typedef std::function< mutation_strategy_ptr(size_t) > mutation_factory;
+
+	private:
+		typedef basic_differential_evolution< T, dynamic_mutation, dynamic_selection, dynamic_termination, dynamic_listener, parallel_evaluator< T > > engine;
+
+		// 把一次运行的计算次数记入所有运行共享的计数，共享的计数达到上限时停止
+		class budget_termination_strategy : public termination_strategy
+		{
+		private:
+			std::atomic< size_t >& m_total;
+			const size_t m_maxEvaluations;
+			size_t m_charged;
+
+		public:
+			budget_termination_strategy(std::atomic< size_t >& total, size_t maxEvaluations)
+				: m_total(total), m_maxEvaluations(maxEvaluations), m_charged(0)
+			{
+			}
+
+			using termination_strategy::event;
+
+			virtual bool event(const run_statistics& stats)
+			{
+				charge(stats.evaluations());
+				return m_maxEvaluations == 0 || m_total < m_maxEvaluations;
+			}
+
+			// evaluations是本次运行到目前为止的计算次数
+			void charge(size_t evaluations)
+			{
+				m_total += evaluations - m_charged;
+				m_charged = evaluations;
+			}
+		};
+
+		const size_t m_varCount;
+		typename processors< T >::processors_ptr m_processors;
+		constraints_ptr m_constraints;
+		const bool m_minimize;
+		selection_strategy_ptr m_selection;
+		mutation_factory m_mutation;
+		const ipop_options m_options;
+		listener_ptr m_listener;
+
+		std::shared_ptr< std::mutex > m_shared;
+
+		std::mutex m_mx;
+		size_t m_next;
+		std::atomic< size_t > m_evaluations;
+		individual_ptr m_best;
+		std::vector< ipop_run > m_runs;
+		bool m_failed;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param varCount 变量个数
+		 * @param processors 所有运行共享的处理器集合
+		 * @param constraints 约束
+		 * @param minimize 如果为true，将尝试最小化成本
+		 * @param selection 选择策略，所有运行共享，必须是无状态的
+		 * @param mutation 为每次运行创建变异策略
+		 * @param options 重启的参数
+		 * @param listener 所有运行共享的侦听器，concurrent大于1时要能在几个线程中同时被调用
+		 */
+		ipop_restarts(size_t varCount, typename processors< T >::processors_ptr processors, constraints_ptr constraints, bool minimize,
+			selection_strategy_ptr selection, mutation_factory mutation, const ipop_options& options, listener_ptr listener = std::make_shared< quiet_listener >())
+			: m_varCount(varCount), m_processors(processors), m_constraints(constraints), m_minimize(minimize), m_selection(selection), m_mutation(mutation),
+			m_options(options), m_listener(listener), m_shared(std::make_shared< std::mutex >()), m_next(0), m_evaluations(0), m_failed(false)
+		{
+			assert(processors);
+			assert(constraints);
+			assert(selection);
+			assert(mutation);
+			assert(listener);
+			assert(options.popSize >= 5);
+			assert(options.runs > 0);
+		}
+
+		/**
+		 * 进行所有的运行，直到运行次数或计算次数达到上限才返回
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void run()
+		{
+			const size_t concurrent(std::max< size_t >(1, std::min(m_options.concurrent, m_options.runs)));
+
+			if (concurrent == 1)
+				runner();
+			else
+			{
+				std::vector< std::thread > runners;
+				for (size_t n = 0; n < concurrent; ++n)
+					runners.push_back(std::thread([this]() { runner(); }));
+
+				for (size_t n = 0; n < runners.size(); ++n)
+					runners[n].join();
+			}
+
+			if (m_failed)
+				throw differential_evolution_exception();
+		}
+
+		/**
+		 * 返回所有运行中的最佳个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return individual_ptr
+		 */
+		individual_ptr best() const { return m_best; }
+
+		/**
+		 * 返回所有运行的目标函数计算次数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t evaluations() const { return m_evaluations; }
+
+		/**
+		 * 返回每次运行的结果，按运行结束的顺序
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const std::vector< ipop_run >&
+		 */
+		const std::vector< ipop_run >& runs() const { return m_runs; }
+
+	private:
+		// 在一个线程中依次进行运行，直到没有剩余的运行或计算次数用完
+		void runner()
+		{
+			for (;;)
+			{
+				size_t index;
+				individual_ptr incumbent;
+
+				{
+					std::lock_guard< std::mutex > lock(m_mx);
+
+					if (m_failed || m_next >= m_options.runs || (m_options.maxEvaluations > 0 && m_evaluations >= m_options.maxEvaluations))
+						return;
+
+					index = m_next++;
+					incumbent = m_best;
+				}
+
+				try
+				{
+					ipop_run result(run_one(index, incumbent));
+
+					std::lock_guard< std::mutex > lock(m_mx);
+					m_runs.push_back(result);
+				}
+				catch (const differential_evolution_exception&)
+				{
+					std::lock_guard< std::mutex > lock(m_mx);
+					m_failed = true;
+					return;
+				}
+			}
+		}
+
+		ipop_run run_one(size_t index, individual_ptr incumbent)
+		{
+			// 本次运行的所有随机数都来自运行线程的引擎
+			seed_generator(m_options.seed + index);
+
+			const size_t popSize(std::min(m_options.maxPopSize, static_cast< size_t >(m_options.popSize * std::pow(m_options.growth, static_cast< double >(index)))));
+
+			population_ptr initial(std::make_shared< population >(popSize, m_varCount, m_constraints));
+			size_t seeded(0);
+
+			if (incumbent && m_options.seedFraction > 0)
+			{
+				seeded = std::max< size_t >(1, std::min(popSize, static_cast< size_t >(m_options.seedFraction * popSize)));
+
+				(*initial)[0] = std::make_shared< individual >(*incumbent->vars());
+				for (size_t i = 1; i < seeded; ++i)
+					(*initial)[i] = std::make_shared< individual >(*m_constraints->get_square_zone_rand_values(incumbent->vars(), m_options.seedSidePct));
+			}
+
+			std::vector< termination_strategy_ptr > terminations;
+			terminations.push_back(std::make_shared< stagnation_termination_strategy >(m_options.stagnationGenerations, m_options.stagnationEpsilon));
+			terminations.push_back(std::make_shared< max_gen_termination_strategy >(m_options.maxGenerations));
+
+			// 计算次数的上限由所有运行共享，不能在开始时分给每次运行
+			std::shared_ptr< budget_termination_strategy > budget(std::make_shared< budget_termination_strategy >(m_evaluations, m_options.maxEvaluations));
+			terminations.push_back(budget);
+
+			engine de(m_varCount, popSize, parallel_evaluator< T >(m_processors, m_shared), m_constraints, m_minimize,
+				dynamic_termination(std::make_shared< or_termination_strategy >(terminations)), dynamic_selection(m_selection),
+				dynamic_mutation(m_mutation(m_varCount)), dynamic_listener(m_listener), population_size_strategy_ptr(), feasibility_rule_ptr(), initial);
+
+			de.run();
+			budget->charge(de.evaluations());
+
+			{
+				std::lock_guard< std::mutex > lock(m_mx);
+
+				if (!m_best || de.best()->better(m_best, m_minimize))
+					m_best = de.best();
+			}
+
+			ipop_run result = { index, popSize, de.statistics().generation(), de.evaluations(), seeded, de.best()->cost() };
+			return result;
+		}
+	};
+
+}
+
+#endif //DE_IPOP_RESTARTS_HPP_INCLUDED
@@ -11,13 +11,13 @@ namespace de
 {
 
 	/**
-	 * ûĳࡣ
+	 * 用户定义的侦听器的抽象基类。
 	 *
-	 * ŻỰڼ䷢ĳЩҪ¼ʱཫ֪ͨ
+	 * 在优化会话期间发生某些重要事件时，侦听器类将接收通知。
 	 *
-	 * Щ¼ʾǰ״̬Ϣȡ
+	 * 这些事件可用于显示当前状态，诊断信息等。
 	 *
-	 * ûӴ࣬⽫Խյ¼һЩõ顣
+	 * 用户将从此类中派生具体的侦听器类，这将对接收到的事件做一些有用的事情。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -27,27 +27,27 @@ namespace de
 		virtual ~listener() {}
 
 		/**
-		 * Ż̿ʼʱá
+		 * 在优化过程开始时调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 */
 		virtual void start() = 0;
 		/**
-		 * Ż̽ʱá
+		 * 在优化过程结束时调用。
 		 *
-		 * ʹŻ쳣Ҳô˺
+		 * 即使优化过程以异常结束，也会调用此函数
 		 *
 		 * @author louiehan (11/11/2019)
 		 */
 		virtual void end() = 0;
 		/**
-		 * Ż쳣ʱãź
+		 * 在优化过程中引发异常时调用，并发出错误信号
 		 *
 		 * @author louiehan (11/11/2019)
 		 */
 		virtual void error() = 0;
 		/**
-		 * ÿһʼʱá
+		 * 在每一代开始时调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -55,7 +55,7 @@ namespace de
 		 */
 		virtual void startGeneration(size_t genCount) = 0;
 		/**
-		 *ÿһʱãڵ֮ǰ쳣
+		 *在每一代结束时调用，除非在到达迭代结束之前引发异常。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -65,7 +65,7 @@ namespace de
 		 */
 		virtual void endGeneration(size_t genCount, individual_ptr bestIndGen, individual_ptr bestInd) = 0;
 		/**
-		 * ѡʼ֮ǰá
+		 * 在选择开始之前调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -73,7 +73,7 @@ namespace de
 		 */
 		virtual void startSelection(size_t genCount) = 0;
 		/**
-		 * ִѡá
+		 * 执行选择后调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -81,7 +81,7 @@ namespace de
 		 */
 		virtual void endSelection(size_t genCount) = 0;
 		/**
-		 * ڿʼĿ꺯֮ǰá
+		 * 在开始目标函数处理之前调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -89,7 +89,7 @@ namespace de
 		 */
 		virtual void startProcessors(size_t genCount) = 0;
 		/**
-		 * Ŀ꺯ɺá
+		 * 目标函数处理完成后调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -99,12 +99,12 @@ namespace de
 	};
 
 	/**
-	 * ָָ
+	 * 指向侦听器的智能指针
 	 */
 	typedef std::shared_ptr< listener > listener_ptr;
 
 	/**
-	 * н¼ľ
+	 * 忽略所有接收事件的具体侦听器
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -125,6 +125,27 @@ namespace de
 		virtual void endProcessors(size_t genCount) {}
 	};
 
+	/**
+	 * 忽略所有事件、也不输出任何信息的监听器。
+	 *
+	 * 用于批量实验和基准测试，null_listener会在每一代结束时输出当前的最佳代价。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class quiet_listener : public listener
+	{
+	public:
+		virtual void start() {}
+		virtual void end() {}
+		virtual void error() {}
+		virtual void startGeneration(size_t genCount) {}
+		virtual void endGeneration(size_t genCount, individual_ptr bestIndGen, individual_ptr bestInd) {}
+		virtual void startSelection(size_t genCount) {}
+		virtual void endSelection(size_t genCount) {}
+		virtual void startProcessors(size_t genCount) {}
+		virtual void endProcessors(size_t genCount) {}
+	};
+
 }
 
 #endif //DE_LISTENER_HPP_INCLUDED
@@ -0,0 +1,342 @@
+#ifndef DE_MULTI_OBJECTIVE_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
+#define DE_MULTI_OBJECTIVE_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <memory>
+#include <vector>
+
+#include "basic_differential_evolution.hpp"
+#include "pareto_ranking.hpp"
+
+namespace de
+{
+
+	/**
+	 * 有容量上限的Pareto前沿存档：保存到目前为止找到的互不支配的个体。
+	 *
+	 * 每次更新把候选个体与存档合并，只保留非支配前沿；超过容量时按拥挤距离从大到小保留，
+	 * 使存档沿前沿均匀分布。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class pareto_archive
+	{
+	private:
+		const size_t m_capacity;
+		std::vector< individual_ptr > m_members;
+
+		pareto_ranking m_ranking;
+		std::vector< individual_ptr > m_merged;
+		std::vector< const std::vector< double >* > m_costs;
+		std::vector< size_t > m_selected;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param capacity 存档的容量上限
+		 */
+		explicit pareto_archive(size_t capacity)
+			: m_capacity(capacity)
+		{
+			assert(capacity > 0);
+		}
+
+		/**
+		 * 用一组候选个体更新存档
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param candidates 候选个体，必须已经计算了代价向量；已经在存档中的个体（同一个个体或代价向量相同）被忽略
+		 */
+		void update(const std::vector< individual_ptr >& candidates)
+		{
+			m_merged.assign(m_members.begin(), m_members.end());
+
+			// 前沿中存活了多代的个体已经在存档中，重复的个体会互不支配并挤掉其他的点
+			for (size_t c = 0; c < candidates.size(); ++c)
+			{
+				bool duplicate(false);
+				for (size_t i = 0; i < m_merged.size() && !duplicate; ++i)
+					duplicate = m_merged[i] == candidates[c] || m_merged[i]->costs() == candidates[c]->costs();
+
+				if (!duplicate)
+					m_merged.push_back(candidates[c]);
+			}
+
+			m_costs.resize(m_merged.size());
+			for (size_t i = 0; i < m_merged.size(); ++i)
+				m_costs[i] = &m_merged[i]->costs();
+
+			m_ranking(m_costs);
+
+			const std::vector< size_t >& front(m_ranking.front(0));
+
+			// 只保留非支配前沿：select在第一个前沿放不下时按拥挤距离裁剪
+			m_ranking.select(std::min(m_capacity, front.size()), m_selected);
+
+			m_members.clear();
+			for (size_t n = 0; n < m_selected.size(); ++n)
+				m_members.push_back(m_merged[m_selected[n]]);
+		}
+
+		/**
+		 * 返回存档中的个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const std::vector< individual_ptr >&
+		 */
+		const std::vector< individual_ptr >& members() const { return m_members; }
+
+		/**
+		 * 返回存档中的个体数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t size() const { return m_members.size(); }
+
+		/**
+		 * 返回存档的容量上限
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t capacity() const { return m_capacity; }
+	};
+
+	/**
+	 * 多目标差分进化（GDE3）。
+	 *
+	 * 目标函数返回代价向量（见multi_objective_function），所有的目标都是最小化。试验个体由mutation_strategy生成
+	 * （需要最优个体的策略使用非支配前沿中随机的个体），由processors< T >并行计算。选择：试验个体弱支配父个体时
+	 * 取代父个体，父个体支配试验个体时丢弃试验个体，否则两者都保留；保留的个体超过种群规模时，
+	 * 用非支配排序和拥挤距离裁剪（见pareto_ranking）。非支配前沿同时更新有容量上限的Pareto存档。
+	 *
+	 * 自适应的变异策略（例如SHADE）依赖标量代价的改进，在这里不会更新它们的参数。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename T > class multi_objective_differential_evolution : boost::noncopyable
+	{
+	private:
+		const size_t m_varCount;
+		const size_t m_popSize;
+
+		population_ptr m_pop;
+		population_ptr m_trials;
+		std::vector< DVectorPtr > m_origins;
+
+		constraints_ptr m_constraints;
+		constraint_table_ptr m_constraintTable;
+		mutation_strategy_ptr m_mutation;
+		parallel_evaluator< T > m_evaluator;
+
+		pareto_ranking m_ranking;
+		pareto_archive m_archive;
+
+		std::vector< individual_ptr > m_candidates;
+		std::vector< const std::vector< double >* > m_costs;
+		std::vector< size_t > m_selected;
+		std::vector< individual_ptr > m_front;
+
+		size_t m_genCount;
+		size_t m_evaluations;
+
+	public:
+		/**
+		 * 构造一个multi_objective_differential_evolution对象，随机初始化种群并计算它的代价向量
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param varCount 变量总数
+		 * @param popSize 种群规模，至少为5
+		 * @param processors 计算目标函数的处理器集合
+		 * @param constraints 约束
+		 * @param mutationStrategy 变异策略
+		 * @param archiveSize Pareto存档的容量上限
+		 * @param ranking 非支配排序，决定并行排序的阈值和线程数
+		 */
+		multi_objective_differential_evolution(size_t varCount, size_t popSize, typename processors< T >::processors_ptr processors, constraints_ptr constraints,
+			mutation_strategy_ptr mutationStrategy, size_t archiveSize, const pareto_ranking& ranking = pareto_ranking())
+			try
+
+			: m_varCount(varCount), m_popSize(popSize), m_pop(std::make_shared< population >(popSize, varCount, constraints)),
+			m_trials(std::make_shared< population >(popSize, varCount)), m_origins(popSize), m_constraints(constraints),
+			m_constraintTable(std::make_shared< constraint_table >(*constraints)), m_mutation(mutationStrategy), m_evaluator(processors),
+			m_ranking(ranking), m_archive(archiveSize), m_genCount(0), m_evaluations(0)
+		{
+			assert(constraints);
+			assert(mutationStrategy);
+			assert(popSize >= 5);
+
+			m_mutation->set_constraint_table(m_constraintTable);
+
+			m_evaluator(*m_pop, std::chrono::steady_clock::time_point::max(), stop_token(), cancellation::drain);
+			m_evaluations += popSize;
+
+			m_candidates.assign(m_pop->begin(), m_pop->end());
+			select();
+		}
+		catch (const processors_exception&)
+		{
+			throw differential_evolution_exception();
+		}
+		catch (const objective_function_exception&)
+		{
+			throw differential_evolution_exception();
+		}
+
+		virtual ~multi_objective_differential_evolution()
+		{
+		}
+
+		/**
+		 * 运行maxGen代（从构造时算起）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param maxGen 最大进化代数
+		 */
+		void run(size_t maxGen)
+		{
+			try
+			{
+				for (; m_genCount < maxGen; ++m_genCount)
+				{
+					m_mutation->start_generation(*m_pop, true);
+
+					for (size_t i = 0; i < m_popSize; ++i)
+					{
+						individual_ptr best(m_front[genintrand(0, m_front.size(), true)]);
+						mutation_strategy::mutation_info mutationInfo((*m_mutation)(*m_pop, best, i));
+
+						(*m_trials)[i] = std::get< 0 >(mutationInfo);
+						m_origins[i] = std::get< 1 >(mutationInfo);
+					}
+
+					if (!m_mutation->repairs_trials())
+						m_constraintTable->repair(*m_trials, m_origins);
+
+					m_evaluator(*m_trials, std::chrono::steady_clock::time_point::max(), stop_token(), cancellation::drain);
+					m_evaluations += m_popSize;
+
+					m_candidates.clear();
+
+					for (size_t i = 0; i < m_popSize; ++i)
+					{
+						const individual_ptr& parent((*m_pop)[i]);
+						const individual_ptr& trial((*m_trials)[i]);
+
+						if (weakly_dominates(trial->costs(), parent->costs()))
+							m_candidates.push_back(trial);
+						else if (dominates(parent->costs(), trial->costs()))
+							m_candidates.push_back(parent);
+						else
+						{
+							m_candidates.push_back(parent);
+							m_candidates.push_back(trial);
+						}
+					}
+
+					select();
+				}
+			}
+			catch (const processors_exception&)
+			{
+				throw differential_evolution_exception();
+			}
+			catch (const objective_function_exception&)
+			{
+				throw differential_evolution_exception();
+			}
+		}
+
+		/**
+		 * 返回当前种群
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return population_ptr
+		 */
+		population_ptr get_population() const { return m_pop; }
+
+		/**
+		 * 返回当前种群的非支配前沿
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const std::vector< individual_ptr >&
+		 */
+		const std::vector< individual_ptr >& front() const { return m_front; }
+
+		/**
+		 * 返回Pareto存档
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const pareto_archive&
+		 */
+		const pareto_archive& archive() const { return m_archive; }
+
+		/**
+		 * 返回已经完成的进化代数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t generation() const { return m_genCount; }
+
+		/**
+		 * 返回目标函数的计算次数，包括初始种群
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t evaluations() const { return m_evaluations; }
+
+	private:
+		// 从候选个体中选出下一代种群，更新非支配前沿和存档
+		void select()
+		{
+			m_costs.resize(m_candidates.size());
+			for (size_t i = 0; i < m_candidates.size(); ++i)
+			{
+				if (m_candidates[i]->costs().empty())
+					throw differential_evolution_exception();
+
+				m_costs[i] = &m_candidates[i]->costs();
+			}
+
+			m_ranking(m_costs);
+			m_ranking.select(m_popSize, m_selected);
+
+			// 第一个前沿总是最先选中，被选中的第一个前沿的个体就是新种群的非支配前沿
+			m_front.clear();
+			for (size_t n = 0; n < m_selected.size(); ++n)
+			{
+				(*m_pop)[n] = m_candidates[m_selected[n]];
+
+				if (m_ranking.rank()[m_selected[n]] == 0)
+					m_front.push_back((*m_pop)[n]);
+			}
+
+			m_archive.update(m_front);
+		}
+	};
+
+}
+
+#endif //DE_MULTI_OBJECTIVE_DIFFERENTIAL_EVOLUTION_HPP_INCLUDED
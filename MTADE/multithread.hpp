@@ -7,6 +7,8 @@
 #pragma once
 #endif
 
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <mutex>
 //#include <boost/thread.hpp>
@@ -16,6 +18,89 @@ namespace de
 	typedef std::recursive_mutex mutex;
 	typedef std::lock_guard< std::recursive_mutex > lock;
 
+	/**
+	 * 停止令牌，用于协作式地取消长时间运行的操作（例如差分进化的运行）。
+	 *
+	 * 由stop_source创建，被取消的操作定期检查stop_requested()。缺省构造的令牌永远不会被请求停止。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class stop_token
+	{
+	private:
+		std::shared_ptr< std::atomic< bool > > m_flag;
+
+	public:
+		stop_token()
+		{
+		}
+
+		explicit stop_token(std::shared_ptr< std::atomic< bool > > flag)
+			: m_flag(flag)
+		{
+		}
+
+		/**
+		 * 是否已经请求停止
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool stop_requested() const { return m_flag && m_flag->load(); }
+
+		/**
+		 * 令牌是否关联了stop_source，即是否可能被请求停止
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool stop_possible() const { return bool(m_flag); }
+	};
+
+	/**
+	 * 停止请求的来源，可以从任何线程调用request_stop()
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class stop_source
+	{
+	private:
+		std::shared_ptr< std::atomic< bool > > m_flag;
+
+	public:
+		stop_source()
+			: m_flag(std::make_shared< std::atomic< bool > >(false))
+		{
+		}
+
+		/**
+		 * 请求停止所有关联的令牌
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void request_stop() { m_flag->store(true); }
+
+		/**
+		 * 是否已经请求停止
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool stop_requested() const { return m_flag->load(); }
+
+		/**
+		 * 返回关联的停止令牌
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return stop_token
+		 */
+		stop_token token() const { return stop_token(m_flag); }
+	};
+
 }
 
 #endif //DE_MULTITHREAD_HPP_INCLUDED
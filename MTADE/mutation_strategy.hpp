@@ -8,16 +8,21 @@
 #endif
 
 #include "population.hpp"
+#include "selection_strategy.hpp"
+#include "constraint_table.hpp"
+#include "crossover_strategy.hpp"
 
 #define URN_DEPTH 5
 
 #include <tuple>
+#include <vector>
+#include <algorithm>
 
 namespace de
 {
 
 	/**
-	 * ȨӣӺͶӣǰóʹõĲ
+	 * 变异策略权重因子，交叉因子和抖动因子（根据前两个参数计算得出）所使用的参数。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -30,15 +35,15 @@ namespace de
 
 	public:
 		/**
-		 * һ
+		 * 构造一个变异策略类对象。
 		 *
-		 * ˵ôṩȨغͽ֮⣬ö󻹰һӣ
-		 * ñڹʱģĳЩͻʹá
+		 * 除了调用代码提供的权重和交叉因子之外，该对象还包含一个变异因子，
+		 * 该变异因子是在构造时计算出来的，并被某些突变策略使用。
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
-		 * @param weight Ȩӣֽ㷨Ľ0-2֮doubleֵ
-		 * @param crossover  ֽ㷨Ľ0-1֮doubleֵ
+		 * @param weight 权重因子，差分进化算法定义的介于0-2之间的double值。
+		 * @param crossover 交叉因子 差分进化算法定义的介于0-1之间的double值。
 		 */
 		mutation_strategy_arguments(double weight, double crossover)
 			: m_weight(weight), m_crossover(crossover), m_dither(weight + genrand() * (1.0 - weight))
@@ -47,7 +52,7 @@ namespace de
 		}
 
 		/**
-		 * Ȩ
+		 * 返回权重因子
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -55,7 +60,7 @@ namespace de
 		 */
 		double weight() const { return m_weight; }
 		/**
-		 * ؽ
+		 * 返回交叉因子
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -63,7 +68,7 @@ namespace de
 		 */
 		double crossover() const { return m_crossover; }
 		/**
-		 * ر
+		 * 返回变异因子
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -73,9 +78,9 @@ namespace de
 	};
 
 	/**
-	 * Եĳ
+	 * 变异策略的抽象基类
 	 *
-	 * ԶŻεֵ
+	 * 变异策略定义了在优化过程中如何调整变量值。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -84,12 +89,14 @@ namespace de
 	private:
 		mutation_strategy_arguments m_args;
 		size_t m_varCount;
+		bool m_fusedRepair;
+		constraint_table_ptr m_constraintTable;
 
 	protected:
 		/**
-		 * ñһ4СΪ
+		 * 用变异策略生成一组4个随机大小的数作为索引。
 		 *
-		 * Щֱȫͬұⲿṩͬ
+		 * 这些数字必须全部不同，并且必须与外部提供的索引不同。
 		 *
 		 * @author louiehan (11/15/2019)
 		 */
@@ -103,8 +110,8 @@ namespace de
 			 *
 			 * @author louiehan (11/15/2019)
 			 *
-			 * @param NP ɵޣ
-			 * @param avoid ʱҪֵ
+			 * @param NP 生成的随机数的上限（不包括）
+			 * @param avoid 生成随机数时要避免的值
 			 */
 			Urn(size_t NP, size_t avoid)
 			{
@@ -115,17 +122,59 @@ namespace de
 			}
 
 			/**
-			 * ɵĸ֮һ
+			 * 返回生成的四个随机数之一
 			 *
 			 * @author louiehan (11/15/2019)
 			 *
-			 * @param index Ҫص0-3֮䡣
+			 * @param index 要返回的随机数的索引，可以在0-3之间。
 			 *
 			 * @return size_t
 			 */
 			size_t operator[](size_t index) const { assert(index < 4); return m_urn[index]; }
 		};
 
+		/**
+		 * 修复单个变量：设置了约束表时按约束表修复，否则原样返回
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param j 变量的索引
+		 * @param value 变量的新值
+		 * @param origin 原值
+		 *
+		 * @return double
+		 */
+		double repair(size_t j, double value, double origin) const
+		{
+			return m_constraintTable ? m_constraintTable->repair(j, value, origin) : value;
+		}
+
+		/**
+		 * 融合的试验个体生成核：复制父个体，由交叉策略选出要改变的变量，每个选中的变量在写入变异值的同时修复；
+		 * 没有改变的变量来自满足约束的父个体，不需要再检查。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param crossoverStrategy 交叉策略（见crossover_strategy.hpp）
+		 * @param parent 父个体的变量
+		 * @param origin 越界时用于修复的原值
+		 * @param CR 交叉因子
+		 * @param mutate 返回变量j的变异值的函数对象，形如double(size_t j)
+		 *
+		 * @return individual_ptr 试验个体
+		 */
+		template< typename C, typename F > individual_ptr make_trial(C& crossoverStrategy, const DVector& parent, const DVector& origin, double CR, F mutate) const
+		{
+			individual_ptr tmpInd(std::make_shared< individual >(parent));
+			DVector& v(*tmpInd->vars());
+
+			crossoverStrategy(varCount(), CR, [&](size_t j)
+			{
+				v[j] = repair(j, mutate(j), origin[j]);
+			});
+
+			return tmpInd;
+		}
 
 	public:
 		virtual ~mutation_strategy()
@@ -139,31 +188,78 @@ namespace de
 		 *
 		 * @param varCount number of variables
 		 * @param args mutation strategy arguments
+		 * @param fusedRepair 为true表示operator()生成的试验个体已经用约束表修复（使用make_trial），
+		 *					  引擎不需要再检查整个个体
 		 */
-		mutation_strategy(size_t varCount, const mutation_strategy_arguments& args)
-			: m_args(args), m_varCount(varCount)
+		mutation_strategy(size_t varCount, const mutation_strategy_arguments& args, bool fusedRepair = false)
+			: m_args(args), m_varCount(varCount), m_fusedRepair(fusedRepair)
 		{
 		}
 
 		/**
-		 * ԱصԪ͡
+		 * 运算符（）成员返回的元组的类型。
 		 */
 		typedef std::tuple< individual_ptr, de::DVectorPtr > mutation_info;
 
 		/**
-		 * ִб
+		 * 执行变异
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
-		 * @param pop ǰȺã
-		 * @param bestIt һõĸ壻
-		 * @param i ǰ
+		 * @param pop 当前种群的引用；
+		 * @param bestIt 上一代最好的个体；
+		 * @param i 当前个体的索引。
 		 *
-		 * @return mutation_info Ԫ飨tupleĸװͬСdoubleֵvector
-		 *						 ǳӦԼʩӵƵ£ԭֵֵ
+		 * @return mutation_info 元组（tuple），包含变异的个体和装有与变量数量相同大小的double值的vector容器，
+		 *						 在它们超出相应约束所施加的限制的情况下，用作原值以生成新值。
 		 */
 		virtual mutation_info operator()(const population& pop, individual_ptr bestIt, size_t i) = 0;
 
+		/**
+		 * 在每一代生成试验个体之前调用，缺省不做任何事情。
+		 *
+		 * 需要按代准备数据（如排序或抽样参数）的变异策略可以重载此函数。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 当前种群的引用
+		 * @param minimize 如果为true，代价越小越好，否则代价越大越好
+		 */
+		virtual void start_generation(const population& pop, bool minimize)
+		{
+		}
+
+		/**
+		 * 种群缩小（见population_size_strategy）之后调用，缺省不做任何事情。
+		 *
+		 * 保存与种群规模成比例的数据（如外部存档）的变异策略可以重载此函数。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param popSize 新的种群规模
+		 */
+		virtual void resize(size_t popSize)
+		{
+		}
+
+		/**
+		 * 设置生成试验个体时用于修复变量的约束表，由differential_evolution在构造时调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param table 约束表，为空时不修复
+		 */
+		void set_constraint_table(constraint_table_ptr table) { m_constraintTable = table; }
+
+		/**
+		 * 如果operator()生成的试验个体已经满足约束，返回true
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool repairs_trials() const { return m_fusedRepair && m_constraintTable; }
+
 		/**
 		 * returns the number of variables
 		 *
@@ -174,7 +270,7 @@ namespace de
 		size_t varCount() const { return m_varCount; }
 
 		/**
-		 * Ȩ
+		 * 返回权重因子
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -183,7 +279,7 @@ namespace de
 		double weight() const { return m_args.weight(); }
 
 		/**
-		 * ؽ
+		 * 返回交叉因子
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -192,7 +288,7 @@ namespace de
 		double crossover() const { return m_args.crossover(); }
 
 		/**
-		 * ر
+		 * 返回变异因子
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -204,12 +300,17 @@ namespace de
 	typedef std::shared_ptr< mutation_strategy > mutation_strategy_ptr;
 
 	/**
-	 *  DE/rand/1/bin #1
+	 * 变异策略 DE/rand/1/bin #1
+	 *
+	 * 交叉策略由模板参数Crossover决定，缺省为指数交叉。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
-	class mutation_strategy_1 : public mutation_strategy
+	template< typename Crossover = exponential_crossover > class basic_mutation_strategy_1 : public mutation_strategy
 	{
+	private:
+		Crossover m_crossover;
+
 	public:
 		/**
 		 * constructs a mutation strategy # 1
@@ -219,58 +320,60 @@ namespace de
 		 * @param varCount number of variables
 		 * @param args mutation strategy arguments
 		 */
-		mutation_strategy_1(size_t varCount, const mutation_strategy_arguments& args)
-			: mutation_strategy(varCount, args)
+		basic_mutation_strategy_1(size_t varCount, const mutation_strategy_arguments& args)
+			: mutation_strategy(varCount, args, true)
 		{
 		}
 
 		/**
-		* ִб
+		* 执行变异
 		*
 		* @author louiehan (11/15/2019)
 		*
-		* @param pop ǰȺã
-		* @param bestIt һõĸ壻
-		* @param i ǰ
+		* @param pop 当前种群的引用；
+		* @param bestIt 上一代最好的个体；
+		* @param i 当前个体的索引。
 		*
-		* @return mutation_info Ԫ飨tupleĸװͬСdoubleֵvector
-		*						ǳӦԼʩӵƵ£ԭֵֵ
+		* @return mutation_info 元组（tuple），包含变异的个体和装有与变量数量相同大小的double值的vector容器，
+		*						在它们超出相应约束所施加的限制的情况下，用作原值以生成新值。
 		*/
 		mutation_info operator()(const population& pop, individual_ptr bestIt, size_t i)
 		{
 			assert(bestIt);
 
-			de::DVectorPtr origin(std::make_shared< de::DVector >(varCount()));
-			individual_ptr tmpInd(std::make_shared< individual >(*pop[i]->vars()));
 			Urn urn(pop.size(), i);
 
+			const DVector& x0(*pop[urn[0]]->vars());
+			const DVector& x1(*pop[urn[1]]->vars());
+			const DVector& x2(*pop[urn[2]]->vars());
 
-			// make sure j is within bounds
-			size_t j = genintrand(0, varCount(), true);
-			size_t k = 0;
-
-			do
+			individual_ptr tmpInd(make_trial(m_crossover, *pop[i]->vars(), x0, crossover(), [&](size_t j)
 			{
-				(*tmpInd->vars())[j] = (*pop[urn[0]]->vars())[j] + weight() * ((*pop[urn[1]]->vars())[j] - (*pop[urn[2]]->vars())[j]);
-
-				j = ++j % varCount();
-				++k;
-			} while (genrand() < crossover() && k < varCount());
+				return x0[j] + weight() * (x1[j] - x2[j]);
+			}));
 
-			origin = pop[urn[0]]->vars();
-
-			return mutation_info(tmpInd, origin);
+			return mutation_info(tmpInd, pop[urn[0]]->vars());
 		}
 
 	};
 
 	/**
-	 * 2 De/rand-to-best/bin # 2
+	 * 使用指数交叉的mutation_strategy_1
+	 */
+	typedef basic_mutation_strategy_1<> mutation_strategy_1;
+
+	/**
+	 * 变异策略2 De/rand-to-best/bin # 2
+	 *
+	 * 交叉策略由模板参数Crossover决定，缺省为指数交叉。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
-	class mutation_strategy_2 : public mutation_strategy
+	template< typename Crossover = exponential_crossover > class basic_mutation_strategy_2 : public mutation_strategy
 	{
+	private:
+		Crossover m_crossover;
+
 	public:
 		/**
 		 * constructs a mutation strategy # 2
@@ -280,60 +383,61 @@ namespace de
 		 * @param varCount number of variables
 		 * @param args mutation strategy arguments
 		 */
-		mutation_strategy_2(size_t varCount, const mutation_strategy_arguments& args)
-			: mutation_strategy(varCount, args)
+		basic_mutation_strategy_2(size_t varCount, const mutation_strategy_arguments& args)
+			: mutation_strategy(varCount, args, true)
 		{
 		}
 
 		/**
-		* ִб
+		* 执行变异
 		*
 		* @author louiehan (11/15/2019)
 		*
-		* @param pop ǰȺã
-		* @param bestIt һõĸ壻
-		* @param i ǰ
+		* @param pop 当前种群的引用；
+		* @param bestIt 上一代最好的个体；
+		* @param i 当前个体的索引。
 		*
-		* @return mutation_info Ԫ飨tupleĸװͬСdoubleֵvector
-		*						ǳӦԼʩӵƵ£ԭֵֵ
+		* @return mutation_info 元组（tuple），包含变异的个体和装有与变量数量相同大小的double值的vector容器，
+		*						在它们超出相应约束所施加的限制的情况下，用作原值以生成新值。
 		*/
 		mutation_info operator()(const population& pop, individual_ptr bestIt, size_t i)
 		{
 			assert(bestIt);
 
-			de::DVectorPtr origin(std::make_shared< de::DVector >(varCount()));
-			individual_ptr tmpInd(std::make_shared< individual >(*pop[i]->vars()));
 			Urn urn(pop.size(), i);
 
+			const DVector& x(*pop[i]->vars());
+			const DVector& best(*bestIt->vars());
+			const DVector& x1(*pop[urn[1]]->vars());
+			const DVector& x2(*pop[urn[2]]->vars());
 
-			// make sure j is within bounds
-			size_t j = genintrand(0, varCount(), true);
-			size_t k = 0;
-
-			do
+			individual_ptr tmpInd(make_trial(m_crossover, x, *pop[urn[0]]->vars(), crossover(), [&](size_t j)
 			{
-				(*tmpInd->vars())[j] = (*tmpInd->vars())[j] +
-					weight() * ((*bestIt->vars())[j] - (*tmpInd->vars())[j]) +
-					weight() * ((*pop[urn[1]]->vars())[j] - (*pop[urn[2]]->vars())[j]);
-
-				j = ++j % varCount();
-				++k;
-			} while (genrand() < crossover() && k < varCount());
-
-			origin = pop[urn[0]]->vars();
+				return x[j] + weight() * (best[j] - x[j]) + weight() * (x1[j] - x2[j]);
+			}));
 
-			return mutation_info(tmpInd, origin);
+			return mutation_info(tmpInd, pop[urn[0]]->vars());
 		}
 
 	};
 
 	/**
-	 *  DE/best/1/bin # 3
+	 * 使用指数交叉的mutation_strategy_2
+	 */
+	typedef basic_mutation_strategy_2<> mutation_strategy_2;
+
+	/**
+	 * 变异策略 DE/best/1/bin # 3
+	 *
+	 * 交叉策略由模板参数Crossover决定，缺省为指数交叉。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
-	class mutation_strategy_3 : public mutation_strategy
+	template< typename Crossover = exponential_crossover > class basic_mutation_strategy_3 : public mutation_strategy
 	{
+	private:
+		Crossover m_crossover;
+
 	public:
 		/**
 		 * constructs a mutation strategy # 3
@@ -343,59 +447,61 @@ namespace de
 		 * @param varCount number of variables
 		 * @param args mutation strategy arguments
 		 */
-		mutation_strategy_3(size_t varCount, const mutation_strategy_arguments& args)
-			: mutation_strategy(varCount, args)
+		basic_mutation_strategy_3(size_t varCount, const mutation_strategy_arguments& args)
+			: mutation_strategy(varCount, args, true)
 		{
 		}
 
 		/**
-		* ִб
+		* 执行变异
 		*
 		* @author louiehan (11/15/2019)
 		*
-		* @param pop ǰȺã
-		* @param bestIt һõĸ壻
-		* @param i ǰ
+		* @param pop 当前种群的引用；
+		* @param bestIt 上一代最好的个体；
+		* @param i 当前个体的索引。
 		*
-		* @return mutation_info Ԫ飨tupleĸװͬСdoubleֵvector
-		*						ǳӦԼʩӵƵ£ԭֵֵ
+		* @return mutation_info 元组（tuple），包含变异的个体和装有与变量数量相同大小的double值的vector容器，
+		*						在它们超出相应约束所施加的限制的情况下，用作原值以生成新值。
 		*/
 		mutation_info operator()(const population& pop, individual_ptr bestIt, size_t i)
 		{
 			assert(bestIt);
 
-			de::DVectorPtr origin(std::make_shared< de::DVector >(varCount()));
-			individual_ptr tmpInd(std::make_shared< individual >(*pop[i]->vars()));
 			Urn urn(pop.size(), i);
 
+			const DVector& best(*bestIt->vars());
+			const DVector& x1(*pop[urn[1]]->vars());
+			const DVector& x2(*pop[urn[2]]->vars());
 
-			// make sure j is within bounds
-			size_t j = genintrand(0, varCount(), true);
-			size_t k = 0;
-
-			do
+			individual_ptr tmpInd(make_trial(m_crossover, *pop[i]->vars(), *pop[urn[0]]->vars(), crossover(), [&](size_t j)
 			{
 				double jitter = (0.0001* genrand() + weight());
 
-				(*tmpInd->vars())[j] = (*bestIt->vars())[j] + jitter * ((*pop[urn[1]]->vars())[j] - (*pop[urn[2]]->vars())[j]);
+				return best[j] + jitter * (x1[j] - x2[j]);
+			}));
 
-				j = ++j % varCount();
-				++k;
-			} while (genrand() < crossover() && k < varCount());
-
-			origin = pop[urn[0]]->vars();
-
-			return mutation_info(tmpInd, origin);
+			return mutation_info(tmpInd, pop[urn[0]]->vars());
 		}
 	};
 
 	/**
-	 *  # 4
+	 * 使用指数交叉的mutation_strategy_3
+	 */
+	typedef basic_mutation_strategy_3<> mutation_strategy_3;
+
+	/**
+	 * 变异策略 # 4
+	 *
+	 * 交叉策略由模板参数Crossover决定，缺省为指数交叉。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
-	class mutation_strategy_4 : public mutation_strategy
+	template< typename Crossover = exponential_crossover > class basic_mutation_strategy_4 : public mutation_strategy
 	{
+	private:
+		Crossover m_crossover;
+
 	public:
 		/**
 		 * constructs a mutation strategy # 4
@@ -405,65 +511,63 @@ namespace de
 		 * @param varCount number of variables
 		 * @param args mutation strategy arguments
 		 */
-		mutation_strategy_4(size_t varCount, const mutation_strategy_arguments& args)
-			: mutation_strategy(varCount, args)
+		basic_mutation_strategy_4(size_t varCount, const mutation_strategy_arguments& args)
+			: mutation_strategy(varCount, args, true)
 		{
 		}
 
 		/**
-		* ִб
+		* 执行变异
 		*
 		* @author louiehan (11/15/2019)
 		*
-		* @param pop ǰȺã
-		* @param bestIt һõĸ壻
-		* @param i ǰ
+		* @param pop 当前种群的引用；
+		* @param bestIt 上一代最好的个体；
+		* @param i 当前个体的索引。
 		*
-		* @return mutation_info Ԫ飨tupleĸװͬСdoubleֵvector
-		*						ǳӦԼʩӵƵ£ԭֵֵ
+		* @return mutation_info 元组（tuple），包含变异的个体和装有与变量数量相同大小的double值的vector容器，
+		*						在它们超出相应约束所施加的限制的情况下，用作原值以生成新值。
 		*/
 		mutation_info operator()(const population& pop, individual_ptr bestIt, size_t i)
 		{
 			assert(bestIt);
 
-			de::DVectorPtr origin(std::make_shared< de::DVector >(varCount()));
-			individual_ptr tmpInd(std::make_shared< individual >(*pop[i]->vars()));
 			Urn urn(pop.size(), i);
 
-
-			// make sure j is within bounds
-			size_t j = genintrand(0, varCount(), true);
-			size_t k = 0;
+			const DVector& x0(*pop[urn[0]]->vars());
+			const DVector& x1(*pop[urn[1]]->vars());
+			const DVector& x2(*pop[urn[2]]->vars());
 
 			double factor(weight() + genrand() * (1.0 - weight()));
 
-			do
+			individual_ptr tmpInd(make_trial(m_crossover, *pop[i]->vars(), x0, crossover(), [&](size_t j)
 			{
-				double jitter = (0.0001* genrand() + weight());
-
-				(*tmpInd->vars())[j] = (*pop[urn[0]]->vars())[j] +
-					factor * ((*pop[urn[1]]->vars())[j] - (*pop[urn[2]]->vars())[j]);
-
-				j = ++j % varCount();
-				++k;
-			} while (genrand() < crossover() && k < varCount());
-
-			origin = pop[urn[0]]->vars();
+				return x0[j] + factor * (x1[j] - x2[j]);
+			}));
 
-			return mutation_info(tmpInd, origin);
+			return mutation_info(tmpInd, pop[urn[0]]->vars());
 		}
 
 	};
 
+	/**
+	 * 使用指数交叉的mutation_strategy_4
+	 */
+	typedef basic_mutation_strategy_4<> mutation_strategy_4;
+
 
 
 	/**
-	 *  # 5
+	 * 变异策略 # 5
+	 *
+	 * 交叉策略由模板参数Crossover决定，缺省为指数交叉。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
-	class mutation_strategy_5 : public mutation_strategy
+	template< typename Crossover = exponential_crossover > class basic_mutation_strategy_5 : public mutation_strategy
 	{
+	private:
+		Crossover m_crossover;
 
 	public:
 		/**
@@ -474,49 +578,338 @@ namespace de
 		 * @param varCount number of variables
 		 * @param args mutation strategy arguments
 		 */
-		mutation_strategy_5(size_t varCount, const mutation_strategy_arguments& args)
-			: mutation_strategy(varCount, args)
+		basic_mutation_strategy_5(size_t varCount, const mutation_strategy_arguments& args)
+			: mutation_strategy(varCount, args, true)
 		{
 		}
 
 		/**
-		* ִб
+		* 执行变异
 		*
 		* @author louiehan (11/15/2019)
 		*
-		* @param pop ǰȺã
-		* @param bestIt һõĸ壻
-		* @param i ǰ
+		* @param pop 当前种群的引用；
+		* @param bestIt 上一代最好的个体；
+		* @param i 当前个体的索引。
 		*
-		* @return mutation_info Ԫ飨tupleĸװͬСdoubleֵvector
-		*						ǳӦԼʩӵƵ£ԭֵֵ
+		* @return mutation_info 元组（tuple），包含变异的个体和装有与变量数量相同大小的double值的vector容器，
+		*						在它们超出相应约束所施加的限制的情况下，用作原值以生成新值。
 		*/
 		mutation_info operator()(const population& pop, individual_ptr bestIt, size_t i)
 		{
 			assert(bestIt);
 
-			de::DVectorPtr origin(std::make_shared< de::DVector >(varCount()));
-			individual_ptr tmpInd(std::make_shared< individual >(*pop[i]->vars()));
 			Urn urn(pop.size(), i);
 
-			// make sure j is within bounds
-			size_t j = genintrand(0, varCount(), true);
-			size_t k = 0;
+			const DVector& x0(*pop[urn[0]]->vars());
+			const DVector& x1(*pop[urn[1]]->vars());
+			const DVector& x2(*pop[urn[2]]->vars());
+
+			individual_ptr tmpInd(make_trial(m_crossover, *pop[i]->vars(), x0, crossover(), [&](size_t j)
+			{
+				return x0[j] + dither() * (x1[j] - x2[j]);
+			}));
+
+			return mutation_info(tmpInd, pop[urn[0]]->vars());
+		}
+
+	};
+
+	/**
+	 * 使用指数交叉的mutation_strategy_5
+	 */
+	typedef basic_mutation_strategy_5<> mutation_strategy_5;
+
+	/**
+	 * 基于成功历史的参数自适应变异策略SHADE（current-to-pbest/1/bin，带外部存档）
+	 *
+	 * 每个个体的权重因子F和交叉因子CR在每一代开始时从H个记忆单元中随机选一个抽取：F服从柯西分布
+	 * C(M_F, 0.1)，CR服从正态分布N(M_CR, 0.1)。试验个体严格优于父个体时记录它的F、CR和代价的改进量，
+	 * 每代选择结束后用改进量加权的Lehmer均值（F）和算术平均值（CR）更新一个记忆单元。
+	 *
+	 * 被替换的父个体放入环形存档，第二个差分向量的减数从种群和存档中抽取；存档的容量与种群规模成比例，
+	 * 种群缩小时（L-SHADE）随机删除存档中的个体直到新的容量；
+	 * pbest从按代价部分排序（nth_element）得到的前p*NP个个体中随机选取。
+	 *
+	 * 变异策略参数中的权重因子和交叉因子作为记忆单元的初值。该策略同时是选择监听器，
+	 * differential_evolution会把它传给选择策略以获得每个试验个体的比较结果。
+	 *
+	 * 交叉策略由模板参数Crossover决定，缺省为二项交叉，使用每个个体的CR。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	template< typename Crossover = binomial_crossover > class basic_shade_mutation_strategy : public mutation_strategy, public selection_listener
+	{
+	private:
+		Crossover m_crossover;
+
+		const double m_p;
+
+		std::vector< double > m_memoryF;
+		std::vector< double > m_memoryCR;
+		size_t m_memoryNext;
 
-			do
+		size_t m_archiveCapacity;
+		double m_archiveRate;
+		std::vector< individual_ptr > m_archive;
+		size_t m_archiveNext;
+
+		std::vector< size_t > m_ranked;
+		size_t m_pbestCount;
+
+		std::vector< double > m_F;
+		std::vector< double > m_CR;
+
+		std::vector< double > m_successF;
+		std::vector< double > m_successCR;
+		std::vector< double > m_successDelta;
+
+		bool m_minimize;
+
+	public:
+		/**
+		 * constructs a SHADE mutation strategy
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param varCount number of variables
+		 * @param args mutation strategy arguments，权重因子和交叉因子是记忆单元的初值
+		 * @param memorySize 记忆单元的个数H
+		 * @param p 选取pbest的范围占种群的比例
+		 * @param archiveCapacity 外部存档的容量，为0时等于第一代的种群规模
+		 */
+		basic_shade_mutation_strategy(size_t varCount, const mutation_strategy_arguments& args, size_t memorySize = 10, double p = 0.11, size_t archiveCapacity = 0)
+			: mutation_strategy(varCount, args, true), m_p(p), m_memoryF(memorySize, args.weight()), m_memoryCR(memorySize, args.crossover()), m_memoryNext(0),
+			m_archiveCapacity(archiveCapacity), m_archiveRate(0), m_archiveNext(0), m_pbestCount(0), m_minimize(true)
+		{
+			assert(memorySize > 0);
+			assert(p > 0 && p <= 1);
+		}
+
+		/**
+		 * 对种群按代价部分排序，并为每个个体抽取本代的F和CR
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 当前种群的引用
+		 * @param minimize 如果为true，代价越小越好，否则代价越大越好
+		 */
+		virtual void start_generation(const population& pop, bool minimize)
+		{
+			const size_t NP(pop.size());
+			assert(NP >= 4);
+
+			m_minimize = minimize;
+
+			// 存档的容量在第一代确定，之后只随种群缩小，不再分配
+			if (m_archiveRate == 0)
+			{
+				if (m_archiveCapacity == 0)
+					m_archiveCapacity = NP;
+
+				m_archiveRate = double(m_archiveCapacity) / NP;
+				m_archive.reserve(m_archiveCapacity);
+			}
+
+			m_pbestCount = std::min(NP, std::max< size_t >(2, size_t(m_p * NP + 0.5)));
+
+			m_ranked.resize(NP);
+			for (size_t n = 0; n < NP; ++n)
+				m_ranked[n] = n;
+
+			std::nth_element(m_ranked.begin(), m_ranked.begin() + (m_pbestCount - 1), m_ranked.end(), [&pop, minimize](size_t a, size_t b)
+			{
+				return pop[a]->better(pop[b], minimize);
+			});
+
+			m_F.resize(NP);
+			m_CR.resize(NP);
+
+			for (size_t n = 0; n < NP; ++n)
+			{
+				size_t r(genintrand(0, m_memoryF.size(), true));
+
+				std::cauchy_distribution<> cauchy(m_memoryF[r], 0.1);
+				do m_F[n] = cauchy(generator()); while (m_F[n] <= 0);
+				m_F[n] = std::min(m_F[n], 1.0);
+
+				std::normal_distribution<> normal(m_memoryCR[r], 0.1);
+				m_CR[n] = std::min(1.0, std::max(0.0, normal(generator())));
+			}
+
+			m_successF.clear();
+			m_successCR.clear();
+			m_successDelta.clear();
+		}
+
+		/**
+		* 执行变异
+		*
+		* @author louiehan (10/19/2026)
+		*
+		* @param pop 当前种群的引用；
+		* @param bestIt 上一代最好的个体；
+		* @param i 当前个体的索引。
+		*
+		* @return mutation_info 元组（tuple），包含变异的个体和装有与变量数量相同大小的double值的vector容器，
+		*						在它们超出相应约束所施加的限制的情况下，用作原值以生成新值。
+		*/
+		mutation_info operator()(const population& pop, individual_ptr bestIt, size_t i)
+		{
+			// 没有调用start_generation时（例如直接使用变异策略），按最小化准备本代的数据
+			if (m_F.size() != pop.size())
+				start_generation(pop, m_minimize);
+
+			const size_t NP(pop.size());
+
+			size_t pbest(m_ranked[genintrand(0, m_pbestCount, true)]);
+			size_t r1;
+			size_t r2;
+
+			do r1 = genintrand(0, NP, true); while (r1 == i);
+			do r2 = genintrand(0, NP + m_archive.size(), true); while (r2 == i || r2 == r1);
+
+			const DVector& x(*pop[i]->vars());
+			const DVector& xpbest(*pop[pbest]->vars());
+			const DVector& xr1(*pop[r1]->vars());
+			const DVector& xr2(r2 < NP ? *pop[r2]->vars() : *m_archive[r2 - NP]->vars());
+
+			const double F(m_F[i]);
+
+			individual_ptr tmpInd(make_trial(m_crossover, x, x, m_CR[i], [&](size_t j)
+			{
+				return x[j] + F * (xpbest[j] - x[j]) + F * (xr1[j] - xr2[j]);
+			}));
+
+			return mutation_info(tmpInd, pop[i]->vars());
+		}
+
+		virtual void selected(size_t i, individual_ptr parent, individual_ptr trial, bool won)
+		{
+			assert(parent && trial);
+
+			if (!trial->better(parent, m_minimize))
+				return;
+
+			if (m_archiveCapacity > 0)
+			{
+				if (m_archive.size() < m_archiveCapacity)
+					m_archive.push_back(parent);
+				else
+				{
+					m_archive[m_archiveNext] = parent;
+					m_archiveNext = (m_archiveNext + 1) % m_archiveCapacity;
+				}
+			}
+
+			if (i < m_F.size())
 			{
-				(*tmpInd->vars())[j] = (*pop[urn[0]]->vars())[j] + dither() * ((*pop[urn[1]]->vars())[j] - (*pop[urn[2]]->vars())[j]);
+				m_successF.push_back(m_F[i]);
+				m_successCR.push_back(m_CR[i]);
+				m_successDelta.push_back(std::fabs(parent->cost() - trial->cost()));
+			}
+		}
 
-				j = ++j % varCount();
-				++k;
-			} while (genrand() < crossover() && k < varCount());
+		/**
+		 * 按第一代的比例缩小存档的容量，随机删除多出的个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param popSize 新的种群规模
+		 */
+		virtual void resize(size_t popSize)
+		{
+			if (m_archiveRate == 0)
+				return;
 
-			origin = pop[urn[0]]->vars();
-			return mutation_info(tmpInd, origin);
+			m_archiveCapacity = std::max< size_t >(1, size_t(m_archiveRate * popSize + 0.5));
+
+			while (m_archive.size() > m_archiveCapacity)
+			{
+				std::swap(m_archive[genintrand(0, m_archive.size(), true)], m_archive.back());
+				m_archive.pop_back();
+			}
+
+			m_archiveNext %= m_archiveCapacity;
 		}
 
+		virtual void end_selection()
+		{
+			double total(0);
+			for (size_t n = 0; n < m_successDelta.size(); ++n)
+				total += m_successDelta[n];
+
+			if (total > 0)
+			{
+				double sumF(0);
+				double sumF2(0);
+				double sumCR(0);
+
+				for (size_t n = 0; n < m_successDelta.size(); ++n)
+				{
+					double w(m_successDelta[n] / total);
+
+					sumF += w * m_successF[n];
+					sumF2 += w * m_successF[n] * m_successF[n];
+					sumCR += w * m_successCR[n];
+				}
+
+				m_memoryF[m_memoryNext] = sumF2 / sumF;
+				m_memoryCR[m_memoryNext] = sumCR;
+				m_memoryNext = (m_memoryNext + 1) % m_memoryF.size();
+			}
+
+			m_successF.clear();
+			m_successCR.clear();
+			m_successDelta.clear();
+		}
+
+		/**
+		 * 返回记忆单元的个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t memory_size() const { return m_memoryF.size(); }
+
+		/**
+		 * 返回一个记忆单元中的权重因子均值M_F
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param k 记忆单元的索引
+		 *
+		 * @return double
+		 */
+		double memory_weight(size_t k) const { return m_memoryF.at(k); }
+
+		/**
+		 * 返回一个记忆单元中的交叉因子均值M_CR
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param k 记忆单元的索引
+		 *
+		 * @return double
+		 */
+		double memory_crossover(size_t k) const { return m_memoryCR.at(k); }
+
+		/**
+		 * 返回外部存档中的个体数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t archive_size() const { return m_archive.size(); }
 	};
 
+	/**
+	 * 使用二项交叉的shade_mutation_strategy
+	 */
+	typedef basic_shade_mutation_strategy<> shade_mutation_strategy;
+
 }
 
 #endif //DE_MUTATION_STRATEGY_HPP_INCLUDED
@@ -0,0 +1,334 @@
+#ifndef DE_NUMA_HPP_INCLUDED
+#define DE_NUMA_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace de
+{
+
+	/**
+	 * NUMA拓扑：每个节点上的逻辑处理器编号。
+	 *
+	 * detect()在Windows上使用GetNumaNodeProcessorMask（只支持第一个处理器组，即前64个逻辑处理器），
+	 * 在Linux上读取/sys/devices/system/node；不能确定时所有的逻辑处理器属于一个节点。
+	 * emulated()把逻辑处理器均分成若干个假想的节点，用于在没有NUMA的机器上测试分区和亲和性。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class numa_topology
+	{
+	private:
+		std::vector< std::vector< size_t > > m_nodes;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param nodes 每个节点上的逻辑处理器编号，至少一个节点，每个节点至少一个处理器
+		 */
+		explicit numa_topology(const std::vector< std::vector< size_t > >& nodes)
+			: m_nodes(nodes)
+		{
+			assert(!nodes.empty());
+		}
+
+		/**
+		 * 检测当前机器的NUMA拓扑
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return numa_topology
+		 */
+		static numa_topology detect()
+		{
+			std::vector< std::vector< size_t > > nodes;
+
+#if defined(_WIN32)
+			ULONG highest(0);
+			if (GetNumaHighestNodeNumber(&highest))
+			{
+				for (ULONG node = 0; node <= highest; ++node)
+				{
+					ULONGLONG mask(0);
+					if (!GetNumaNodeProcessorMask(static_cast< UCHAR >(node), &mask) || mask == 0)
+						continue;
+
+					std::vector< size_t > cpus;
+					for (size_t cpu = 0; cpu < 64; ++cpu)
+					{
+						if (mask & (ULONGLONG(1) << cpu))
+							cpus.push_back(cpu);
+					}
+
+					nodes.push_back(cpus);
+				}
+			}
+#elif defined(__linux__)
+			std::vector< size_t > online(parse_list(read_line("/sys/devices/system/node/online")));
+			for (size_t n = 0; n < online.size(); ++n)
+			{
+				std::vector< size_t > cpus(parse_list(read_line("/sys/devices/system/node/node" + std::to_string(online[n]) + "/cpulist")));
+
+				// 没有处理器的节点（只有内存）不能放置线程
+				if (!cpus.empty())
+					nodes.push_back(cpus);
+			}
+#endif
+
+			if (nodes.empty())
+			{
+				std::vector< size_t > cpus;
+				for (size_t cpu = 0; cpu < std::max< size_t >(1, std::thread::hardware_concurrency()); ++cpu)
+					cpus.push_back(cpu);
+
+				nodes.push_back(cpus);
+			}
+
+			return numa_topology(nodes);
+		}
+
+		/**
+		 * 把当前机器的逻辑处理器按编号均分成nodeCount个假想的节点
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param nodeCount 节点数，至少为1
+		 *
+		 * @return numa_topology
+		 */
+		static numa_topology emulated(size_t nodeCount)
+		{
+			assert(nodeCount > 0);
+
+			const numa_topology real(detect());
+
+			std::vector< size_t > cpus;
+			for (size_t n = 0; n < real.node_count(); ++n)
+				cpus.insert(cpus.end(), real.cpus(n).begin(), real.cpus(n).end());
+
+			std::sort(cpus.begin(), cpus.end());
+
+			// 处理器比节点少时，几个节点共用处理器
+			std::vector< std::vector< size_t > > nodes(nodeCount);
+			for (size_t n = 0; n < nodeCount; ++n)
+			{
+				const size_t first(n * cpus.size() / nodeCount);
+				const size_t last(std::max(first + 1, (n + 1) * cpus.size() / nodeCount));
+
+				for (size_t c = first; c < last; ++c)
+					nodes[n].push_back(cpus[c % cpus.size()]);
+			}
+
+			return numa_topology(nodes);
+		}
+
+		/**
+		 * 返回节点数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t node_count() const { return m_nodes.size(); }
+
+		/**
+		 * 返回节点上的逻辑处理器编号
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param node 节点索引
+		 *
+		 * @return const std::vector< size_t >&
+		 */
+		const std::vector< size_t >& cpus(size_t node) const { return m_nodes.at(node); }
+
+	private:
+		static std::string read_line(const std::string& path)
+		{
+			std::ifstream is(path.c_str());
+			std::string line;
+			std::getline(is, line);
+
+			return line;
+		}
+
+		// 解析"0-3,8-11"形式的列表
+		static std::vector< size_t > parse_list(const std::string& list)
+		{
+			std::vector< size_t > values;
+			std::istringstream is(list);
+			std::string range;
+
+			while (std::getline(is, range, ','))
+			{
+				if (range.empty() || range.find_first_not_of("0123456789- \t\r\n") != std::string::npos)
+					continue;
+
+				const std::string::size_type dash(range.find('-'));
+				const size_t first(std::stoul(range.substr(0, dash)));
+				const size_t last(dash == std::string::npos ? first : std::stoul(range.substr(dash + 1)));
+
+				for (size_t v = first; v <= last; ++v)
+					values.push_back(v);
+			}
+
+			return values;
+		}
+	};
+
+	/**
+	 * 把当前线程限制在一组逻辑处理器上运行
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param cpus 逻辑处理器编号
+	 *
+	 * @return bool 如果成功，则为true；不支持的平台返回false
+	 */
+	inline bool pin_current_thread(const std::vector< size_t >& cpus)
+	{
+#if defined(_WIN32)
+		DWORD_PTR mask(0);
+		for (size_t n = 0; n < cpus.size(); ++n)
+		{
+			if (cpus[n] < sizeof(DWORD_PTR) * 8)
+				mask |= DWORD_PTR(1) << cpus[n];
+		}
+
+		return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+
+		for (size_t n = 0; n < cpus.size(); ++n)
+		{
+			if (cpus[n] < CPU_SETSIZE)
+				CPU_SET(cpus[n], &set);
+		}
+
+		return CPU_COUNT(&set) > 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * 处理器集合在NUMA节点上的放置：第n个处理器线程属于节点n % nodes（交错分配），运行时绑定到该节点的逻辑处理器，
+	 * 因此只启动前几个处理器线程时（见worker_tuning和cpu_quota）它们也分布在各个节点上。
+	 * 一次计算的第i个个体（共n个）属于有处理器线程的前active个节点中的节点i * active / n，
+	 * 被放入该节点的队列，优先由同一节点的处理器计算。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class numa_placement
+	{
+	private:
+		numa_topology m_topology;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param topology NUMA拓扑
+		 */
+		explicit numa_placement(const numa_topology& topology = numa_topology::detect())
+			: m_topology(topology)
+		{
+		}
+
+		/**
+		 * 返回NUMA拓扑
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const numa_topology&
+		 */
+		const numa_topology& topology() const { return m_topology; }
+
+		/**
+		 * 返回节点数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t node_count() const { return m_topology.node_count(); }
+
+		/**
+		 * 返回第index个处理器线程所属的节点，处理器线程交错分配到各个节点
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t worker_node(size_t index) const { return index % node_count(); }
+
+		/**
+		 * 返回启动workers个处理器线程（第0个到第workers - 1个）时有处理器线程的节点数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t 至少为1
+		 */
+		size_t active_nodes(size_t workers) const { return std::max< size_t >(1, std::min(workers, node_count())); }
+
+		/**
+		 * 返回第i个个体（共n个）所属的节点，种群被分成active个连续的分区
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param i 个体的索引
+		 * @param n 个体数
+		 * @param active 有处理器线程的节点数，见active_nodes
+		 *
+		 * @return size_t
+		 */
+		size_t item_node(size_t i, size_t n, size_t active) const { return i * std::min(active, node_count()) / n; }
+
+		/**
+		 * 把当前线程绑定到节点的逻辑处理器上
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param node 节点索引
+		 *
+		 * @return bool 如果成功，则为true
+		 */
+		bool pin(size_t node) const { return pin_current_thread(m_topology.cpus(node)); }
+	};
+
+	/**
+	 * A smart pointer to a numa_placement
+	 */
+	typedef std::shared_ptr< numa_placement > numa_placement_ptr;
+
+}
+
+#endif //DE_NUMA_HPP_INCLUDED
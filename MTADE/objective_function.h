@@ -8,12 +8,18 @@
 #endif
 
 #include <memory>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include "de_types.hpp"
 #include "processors.hpp"
 
 /**
-* Ŀ꺯ĳࡣ
+* 具体目标函数的抽象基类。
 *
 * @author louiehan (11/12/2019)
 */
@@ -37,23 +43,39 @@ public:
 	virtual ~objective_function() {}
 
 	/**
-	* ʵ-ҪŻĿ꺯
+	* 在派生类中实现-它包含要优化的目标函数。
 	*
-	* Ŀ꺯һdouble͵Ĳؼdoubleֵ
+	* 目标函数接受一个double类型的参数向量并返回计算出的double值。
 	*
-	* argsеÿӦԼеͬ磬Ŀ꺯Ҫ
-	* ԼǰԪΪԼĿ꺯operatorʹ
-	* argsǰֵΪԺԴеֵ
+	* args向量中的每个索引对应于约束向量中的相同索引。例如，如果目标函数需要两个变量，
+	* 则将约束向量的前两个元素设置为两个变量的约束，并在目标函数operator（）中使用
+	* args向量的前两个值作为两个变量。可以忽略此向量中的所有其他值。
 	*
 	* @author louiehan (11/12/2019)
 	*
-	* @param args ͨĿ꺯ʹõıö࣬
-	*			  Ŀ꺯ofֻȡеǰnֵֵ
+	* @param args 参数向量。向量通常比目标函数使用的变量数大得多，
+	*			  因此目标函数of只取向量中的前n个值，而忽略其余的值。
 	*
-	* @return double ۣҪŻֵ
+	* @return double 函数代价，这是需要优化的值。
 	*/
 	virtual double operator()(de::DVectorPtr args) = 0;
 
+	/**
+	* 带计算上下文的目标函数。缺省实现忽略上下文，计算完整的代价。
+	*
+	* 代价是累加和的目标函数可以重载这个函数：部分和满足context.exceeded(partial)时，
+	* 返回context.lose(partial)提前结束计算（见de::evaluation_context）。派生类重载时
+	* 仍然要实现operator()(args)，并用using objective_function::operator();使两个重载都可见。
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @param args 参数向量
+	* @param context 计算上下文，包含截断代价
+	*
+	* @return double 函数代价，或者被截断的部分代价
+	*/
+	virtual double operator()(de::DVectorPtr args, de::evaluation_context& context) { return (*this)(args); }
+
 	/**
 	* An objective function has a name
 	*
@@ -115,4 +137,385 @@ public:
 
 };
 
+/**
+* Rastrigin函数，多峰函数，使用所有的变量：
+*
+* f(x) = 10n + sum(x_i^2 - 10cos(2 pi x_i))，全局最小值f(0) = 0，通常的定义域为[-5.12, 5.12]
+*
+* @author louiehan (10/19/2026)
+*/
+class rastrigin_function :public objective_function
+{
+public:
+	rastrigin_function()
+		: objective_function("Rastrigin function")
+	{
+	}
+
+	virtual double operator()(de::DVectorPtr args)
+	{
+		const double pi = 3.14159265358979323846;
+		double sum = 10.0 * args->size();
+
+		for (de::DVector::size_type j = 0; j < args->size(); ++j)
+		{
+			double x = (*args)[j];
+			sum += x * x - 10.0 * std::cos(2.0 * pi * x);
+		}
+
+		return sum;
+	}
+};
+
+/**
+* Rosenbrock函数，单峰但是有狭长弯曲山谷的函数，使用所有的变量：
+*
+* f(x) = sum(100(x_{i+1} - x_i^2)^2 + (1 - x_i)^2)，全局最小值f(1, ..., 1) = 0，通常的定义域为[-30, 30]
+*
+* @author louiehan (10/19/2026)
+*/
+class rosenbrock_function :public objective_function
+{
+public:
+	rosenbrock_function()
+		: objective_function("Rosenbrock function")
+	{
+	}
+
+	virtual double operator()(de::DVectorPtr args)
+	{
+		double sum = 0;
+
+		for (de::DVector::size_type j = 0; j + 1 < args->size(); ++j)
+		{
+			double x = (*args)[j];
+			double y = (*args)[j + 1];
+			sum += 100.0 * (y - x * x) * (y - x * x) + (1.0 - x) * (1.0 - x);
+		}
+
+		return sum;
+	}
+};
+
+/**
+* 用于测量并行处理器伸缩性的合成目标函数，代价为所有变量的平方和。
+*
+* 每次计算还会执行一段可调的纯计算负载：平均耗时为cost微秒，并按variance在
+* [cost*(1-variance), cost*(1+variance)]之间均匀变化。耗时由变量值的散列决定，
+* 因此同一组变量每次计算的耗时相同，也不需要在处理器线程之间共享随机数发生器。
+*
+* @author louiehan (10/19/2026)
+*/
+class synthetic_function :public objective_function
+{
+private:
+	double m_cost;
+	double m_variance;
+
+public:
+	/**
+	* constructs a synthetic_function object
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @param cost 每次计算的平均耗时（微秒）
+	* @param variance 耗时的相对变化范围，0-1之间，0表示每次计算的耗时相同
+	*/
+	synthetic_function(double cost, double variance)
+		: objective_function("synthetic function"), m_cost(cost), m_variance(variance)
+	{
+		assert(cost >= 0);
+		assert(variance >= 0 && variance <= 1);
+	}
+
+	virtual double operator()(de::DVectorPtr args)
+	{
+		double sum = 0;
+		uint64_t hash = 14695981039346656037ULL;
+
+		for (de::DVector::size_type j = 0; j < args->size(); ++j)
+		{
+			double x = (*args)[j];
+			uint64_t bits;
+			std::memcpy(&bits, &x, sizeof(bits));
+
+			hash = (hash ^ bits) * 1099511628211ULL;
+			sum += x * x;
+		}
+
+		double u = double(hash >> 11) / 9007199254740992.0;
+		double micros = m_cost * (1.0 + m_variance * (2.0 * u - 1.0));
+
+		return sum + 0.0 * burn(size_t(micros * iterations_per_microsecond()), u);
+	}
+
+	/**
+	* 返回计算负载每微秒执行的迭代次数，第一次调用时标定。
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @return double
+	*/
+	static double iterations_per_microsecond()
+	{
+		static const double ipm = calibrate();
+		return ipm;
+	}
+
+private:
+	static double burn(size_t iterations, double seed)
+	{
+		double x = seed;
+		for (size_t n = 0; n < iterations; ++n)
+			x = x * 0.999999 + 0.5;
+
+		return x;
+	}
+
+	static double calibrate()
+	{
+		const size_t iterations = 1 << 22;
+
+		std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+		volatile double x = burn(iterations, 0.5);
+		double micros = std::chrono::duration< double, std::micro >(std::chrono::steady_clock::now() - start).count();
+
+		// 读取x，使负载的结果被使用
+		return (micros > 0 ? iterations / micros : double(iterations)) + 0.0 * x;
+	}
+};
+
+/**
+* 批量目标函数的抽象基类：一次调用计算多组参数的代价，例如向量化的或在加速器上计算的目标函数。
+*
+* 每次调用有固定的开销时，把多个个体合并成一次调用（见de::evaluation_coalescer）可以提高吞吐量。
+*
+* @author louiehan (10/19/2026)
+*/
+class batch_objective_function
+{
+private:
+	const std::string m_name;
+
+public:
+	/**
+	* constructs a batch_objective_function object
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @param name the objective function name
+	*/
+	batch_objective_function(const std::string& name)
+		: m_name(name)
+	{
+	}
+
+	virtual ~batch_objective_function() {}
+
+	/**
+	* 在派生类中实现：计算每组参数的代价。出错时抛出de::objective_function_exception。
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @param args 参数向量，与objective_function的参数相同
+	* @param costs 输出的代价，调用时已有args.size()个元素，costs[i]是args[i]的代价
+	*/
+	virtual void operator()(const std::vector< de::DVectorPtr >& args, std::vector< double >& costs) = 0;
+
+	/**
+	* A batch objective function has a name
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @return const std::string&
+	*/
+	const std::string& name() const { return m_name; }
+};
+
+/**
+* Smart pointer to a batch objective function
+*/
+typedef std::shared_ptr< batch_objective_function > batch_objective_function_ptr;
+
+/**
+* 用于测量合并计算的合成批量目标函数，代价为所有变量的平方和。
+*
+* 每次调用的耗时为callCost微秒的固定开销加上每组参数itemCost微秒，负载与synthetic_function相同。
+*
+* @author louiehan (10/19/2026)
+*/
+class synthetic_batch_function :public batch_objective_function
+{
+private:
+	synthetic_function m_call;
+	synthetic_function m_item;
+
+public:
+	/**
+	* constructs a synthetic_batch_function object
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @param callCost 每次调用的固定耗时（微秒）
+	* @param itemCost 每组参数的耗时（微秒）
+	*/
+	synthetic_batch_function(double callCost, double itemCost)
+		: batch_objective_function("synthetic batch function"), m_call(callCost, 0), m_item(itemCost, 0)
+	{
+	}
+
+	virtual void operator()(const std::vector< de::DVectorPtr >& args, std::vector< double >& costs)
+	{
+		const double overhead = m_call(std::make_shared< de::DVector >());
+
+		for (size_t i = 0; i < args.size(); ++i)
+			costs[i] = m_item(args[i]) + 0.0 * overhead;
+	}
+};
+
+/**
+* 多目标函数的抽象基类：返回每个目标的代价，所有的目标都是最小化。
+*
+* 与objective_function一样可以由processors< T >计算，代价向量保存在individual::costs()中。
+*
+* @author louiehan (10/19/2026)
+*/
+class multi_objective_function
+{
+private:
+	const std::string m_name;
+	const size_t m_objectiveCount;
+
+public:
+	/**
+	* constructs a multi_objective_function object
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @param name the objective function name
+	* @param objectiveCount 目标的个数
+	*/
+	multi_objective_function(const std::string& name, size_t objectiveCount)
+		: m_name(name), m_objectiveCount(objectiveCount)
+	{
+		assert(objectiveCount > 0);
+	}
+
+	virtual ~multi_objective_function() {}
+
+	/**
+	* 在派生类中实现，计算每个目标的代价
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @param args 参数向量
+	*
+	* @return std::vector< double > 大小为objective_count()的代价向量
+	*/
+	virtual std::vector< double > operator()(de::DVectorPtr args) = 0;
+
+	/**
+	* A multi-objective function has a name
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @return const std::string&
+	*/
+	const std::string& name() const { return m_name; }
+
+	/**
+	* 返回目标的个数
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @return size_t
+	*/
+	size_t objective_count() const { return m_objectiveCount; }
+};
+
+/**
+* Smart pointer to a multi-objective function
+*/
+typedef std::shared_ptr< multi_objective_function > multi_objective_function_ptr;
+
+/**
+* ZDT1双目标测试函数，定义域为[0, 1]^n：
+*
+* f1 = x_1，f2 = g(1 - sqrt(f1 / g))，g = 1 + 9 sum(x_2..x_n) / (n - 1)；
+* Pareto前沿为f2 = 1 - sqrt(f1)（g = 1），f1在[0, 1]之内
+*
+* @author louiehan (10/19/2026)
+*/
+class zdt1_function :public multi_objective_function
+{
+public:
+	zdt1_function()
+		: multi_objective_function("ZDT1 function", 2)
+	{
+	}
+
+	virtual std::vector< double > operator()(de::DVectorPtr args)
+	{
+		assert(args->size() > 1);
+
+		double sum = 0;
+		for (de::DVector::size_type j = 1; j < args->size(); ++j)
+			sum += (*args)[j];
+
+		double f1 = (*args)[0];
+		double g = 1.0 + 9.0 * sum / (args->size() - 1);
+
+		return std::vector< double >{ f1, g * (1.0 - std::sqrt(f1 / g)) };
+	}
+};
+
+/**
+* DTLZ2测试函数，M个目标，定义域为[0, 1]^n（n >= M）：
+*
+* g = sum((x_i - 0.5)^2)，i >= M（从1开始计数）；f_k = (1 + g) prod(cos(x_i pi / 2), i < M - k) sin(x_{M-k} pi / 2)（k > 0时）；
+* Pareto前沿为第一象限的单位球面
+*
+* @author louiehan (10/19/2026)
+*/
+class dtlz2_function :public multi_objective_function
+{
+public:
+	/**
+	* constructs a dtlz2_function object
+	*
+	* @author louiehan (10/19/2026)
+	*
+	* @param objectiveCount 目标的个数
+	*/
+	dtlz2_function(size_t objectiveCount)
+		: multi_objective_function("DTLZ2 function", objectiveCount)
+	{
+	}
+
+	virtual std::vector< double > operator()(de::DVectorPtr args)
+	{
+		const size_t M = objective_count();
+		const double halfPi = 1.5707963267948966;
+
+		assert(args->size() >= M);
+
+		double g = 0;
+		for (de::DVector::size_type j = M - 1; j < args->size(); ++j)
+			g += ((*args)[j] - 0.5) * ((*args)[j] - 0.5);
+
+		std::vector< double > f(M, 1.0 + g);
+
+		for (size_t k = 0; k < M; ++k)
+		{
+			for (size_t j = 0; j + k + 1 < M; ++j)
+				f[k] *= std::cos((*args)[j] * halfPi);
+
+			if (k > 0)
+				f[k] *= std::sin((*args)[M - k - 1] * halfPi);
+		}
+
+		return f;
+	}
+};
+
 #endif //DE_OBJECTIVE_FUNCTION_HPP_INCLUDED
\ No newline at end of file
@@ -0,0 +1,403 @@
+#ifndef DE_PARETO_RANKING_HPP_INCLUDED
+#define DE_PARETO_RANKING_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <cassert>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace de
+{
+
+	/**
+	 * 代价向量a是否支配b（最小化）：a的每个目标都不差于b，并且至少有一个目标严格优于b
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param a 代价向量
+	 * @param b 代价向量，大小与a相同
+	 *
+	 * @return bool
+	 */
+	inline bool dominates(const std::vector< double >& a, const std::vector< double >& b)
+	{
+		assert(a.size() == b.size());
+
+		bool better(false);
+
+		for (size_t m = 0; m < a.size(); ++m)
+		{
+			if (b[m] < a[m])
+				return false;
+
+			if (a[m] < b[m])
+				better = true;
+		}
+
+		return better;
+	}
+
+	/**
+	 * 代价向量a是否弱支配b（最小化）：a的每个目标都不差于b
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param a 代价向量
+	 * @param b 代价向量，大小与a相同
+	 *
+	 * @return bool
+	 */
+	inline bool weakly_dominates(const std::vector< double >& a, const std::vector< double >& b)
+	{
+		assert(a.size() == b.size());
+
+		for (size_t m = 0; m < a.size(); ++m)
+		{
+			if (b[m] < a[m])
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * 非支配排序和拥挤距离，用于多目标差分进化的选择和Pareto前沿存档的裁剪。
+	 *
+	 * 非支配排序使用ENS-BS（efficient non-dominated sort，二分查找）：先按字典序排序代价向量，
+	 * 这样每个解只可能被排在它前面的解支配；然后按顺序对每个解二分查找第一个没有解支配它的前沿。
+	 * 两个目标时只需要与前沿中最后加入的解比较，总的复杂度为O(M N log N)；更多目标时最坏为O(M N^2)，
+	 * 通常接近O(M N log N)。拥挤距离对每个前沿的每个目标排序一次，为O(M N log N)。
+	 *
+	 * 解的个数不少于parallelThreshold时，字典序排序分段在多个线程中进行后归并，拥挤距离按目标分配到多个线程。
+	 * 前沿的分配本身是顺序的。
+	 *
+	 * 对象保留内部的缓冲区，重复使用时不再分配内存。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class pareto_ranking
+	{
+	private:
+		const size_t m_parallelThreshold;
+		const size_t m_threads;
+
+		std::vector< const std::vector< double >* > m_costs;
+		std::vector< size_t > m_order;
+		std::vector< std::vector< size_t > > m_fronts;
+		size_t m_frontCount;
+		std::vector< size_t > m_rank;
+		std::vector< double > m_crowding;
+		std::vector< std::vector< double > > m_partial;
+		std::vector< std::vector< size_t > > m_sorted;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param parallelThreshold 解的个数不少于此值时并行排序和计算拥挤距离
+		 * @param threads 并行时使用的线程数，0表示硬件线程数
+		 */
+		pareto_ranking(size_t parallelThreshold = 4096, size_t threads = 0)
+			: m_parallelThreshold(parallelThreshold), m_threads(threads > 0 ? threads : std::max< size_t >(1, std::thread::hardware_concurrency())), m_frontCount(0)
+		{
+		}
+
+		/**
+		 * 对一组代价向量做非支配排序并计算拥挤距离
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param costs 代价向量的指针，所有的代价向量大小相同
+		 */
+		void operator()(const std::vector< const std::vector< double >* >& costs)
+		{
+			m_costs = costs;
+
+			const size_t N(m_costs.size());
+			const bool parallel(N >= m_parallelThreshold && m_threads > 1);
+
+			for (size_t k = 0; k < m_frontCount; ++k)
+				m_fronts[k].clear();
+
+			m_frontCount = 0;
+			m_rank.assign(N, 0);
+			m_crowding.assign(N, 0);
+
+			if (N == 0)
+				return;
+
+			m_order.resize(N);
+			for (size_t i = 0; i < N; ++i)
+				m_order[i] = i;
+
+			sort_lexicographic(parallel);
+			assign_fronts();
+
+			if (parallel)
+				crowding_parallel();
+			else
+			{
+				m_partial.resize(1);
+				m_partial[0].assign(N, 0);
+				m_sorted.resize(1);
+
+				for (size_t m = 0; m < m_costs[0]->size(); ++m)
+					crowding(m, m_partial[0], m_sorted[0]);
+
+				m_crowding.swap(m_partial[0]);
+			}
+		}
+
+		/**
+		 * 返回前沿的个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t front_count() const { return m_frontCount; }
+
+		/**
+		 * 返回第k个前沿（0为非支配前沿）中的解的索引
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param k 前沿的索引
+		 *
+		 * @return const std::vector< size_t >&
+		 */
+		const std::vector< size_t >& front(size_t k) const { assert(k < m_frontCount); return m_fronts[k]; }
+
+		/**
+		 * 返回每个解所在前沿的索引
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const std::vector< size_t >&
+		 */
+		const std::vector< size_t >& rank() const { return m_rank; }
+
+		/**
+		 * 返回每个解在所在前沿中的拥挤距离，前沿的边界解为无穷大
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const std::vector< double >&
+		 */
+		const std::vector< double >& crowding() const { return m_crowding; }
+
+		/**
+		 * 按前沿的顺序选出count个解，最后一个放不下的前沿按拥挤距离从大到小选择
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param count 要选择的解的个数
+		 * @param selected 选中的解的索引
+		 */
+		void select(size_t count, std::vector< size_t >& selected) const
+		{
+			selected.clear();
+
+			for (size_t k = 0; k < m_frontCount && selected.size() < count; ++k)
+			{
+				const std::vector< size_t >& f(m_fronts[k]);
+
+				if (selected.size() + f.size() <= count)
+					selected.insert(selected.end(), f.begin(), f.end());
+				else
+				{
+					const size_t first(selected.size());
+					selected.insert(selected.end(), f.begin(), f.end());
+
+					std::partial_sort(selected.begin() + first, selected.begin() + count, selected.end(), [this](size_t a, size_t b)
+					{
+						return m_crowding[a] > m_crowding[b];
+					});
+
+					selected.resize(count);
+				}
+			}
+		}
+
+	private:
+		bool lexicographic_less(size_t a, size_t b) const
+		{
+			const std::vector< double >& x(*m_costs[a]);
+			const std::vector< double >& y(*m_costs[b]);
+
+			for (size_t m = 0; m < x.size(); ++m)
+			{
+				if (x[m] < y[m])
+					return true;
+
+				if (y[m] < x[m])
+					return false;
+			}
+
+			return a < b;
+		}
+
+		void sort_lexicographic(bool parallel)
+		{
+			auto less([this](size_t a, size_t b) { return lexicographic_less(a, b); });
+
+			if (!parallel)
+			{
+				std::sort(m_order.begin(), m_order.end(), less);
+				return;
+			}
+
+			const size_t N(m_order.size());
+			const size_t chunks(std::min(m_threads, N));
+
+			std::vector< size_t > bounds(chunks + 1);
+			for (size_t c = 0; c <= chunks; ++c)
+				bounds[c] = N * c / chunks;
+
+			std::vector< std::thread > threads;
+			for (size_t c = 0; c < chunks; ++c)
+			{
+				threads.push_back(std::thread([this, &bounds, less, c]()
+				{
+					std::sort(m_order.begin() + bounds[c], m_order.begin() + bounds[c + 1], less);
+				}));
+			}
+
+			for (size_t c = 0; c < threads.size(); ++c)
+				threads[c].join();
+
+			// 相邻的有序段两两归并，直到只剩一段
+			for (size_t width = 1; width < chunks; width *= 2)
+			{
+				for (size_t c = 0; c + width < chunks; c += 2 * width)
+				{
+					const size_t last(std::min(chunks, c + 2 * width));
+					std::inplace_merge(m_order.begin() + bounds[c], m_order.begin() + bounds[c + width], m_order.begin() + bounds[last], less);
+				}
+			}
+		}
+
+		bool dominated_by_front(size_t s, const std::vector< size_t >& f) const
+		{
+			const std::vector< double >& x(*m_costs[s]);
+
+			// 两个目标时前沿中的解按第一个目标递增、第二个目标递减，最后加入的解支配s当且仅当前沿中有解支配s
+			if (x.size() == 2)
+				return dominates(*m_costs[f.back()], x);
+
+			for (size_t n = f.size(); n-- > 0;)
+			{
+				if (dominates(*m_costs[f[n]], x))
+					return true;
+			}
+
+			return false;
+		}
+
+		void assign_fronts()
+		{
+			for (size_t n = 0; n < m_order.size(); ++n)
+			{
+				const size_t s(m_order[n]);
+
+				// 被第k个前沿支配时也被之前的每个前沿支配，可以二分查找
+				size_t lo(0), hi(m_frontCount);
+				while (lo < hi)
+				{
+					const size_t mid((lo + hi) / 2);
+
+					if (dominated_by_front(s, m_fronts[mid]))
+						lo = mid + 1;
+					else
+						hi = mid;
+				}
+
+				if (lo == m_frontCount)
+				{
+					if (m_frontCount == m_fronts.size())
+						m_fronts.push_back(std::vector< size_t >());
+
+					++m_frontCount;
+				}
+
+				m_fronts[lo].push_back(s);
+				m_rank[s] = lo;
+			}
+		}
+
+		// 把目标m对拥挤距离的贡献累加到distance
+		void crowding(size_t m, std::vector< double >& distance, std::vector< size_t >& sorted) const
+		{
+			for (size_t k = 0; k < m_frontCount; ++k)
+			{
+				const std::vector< size_t >& f(m_fronts[k]);
+
+				if (f.size() <= 2)
+				{
+					for (size_t n = 0; n < f.size(); ++n)
+						distance[f[n]] = std::numeric_limits< double >::infinity();
+
+					continue;
+				}
+
+				sorted.assign(f.begin(), f.end());
+				std::sort(sorted.begin(), sorted.end(), [this, m](size_t a, size_t b) { return (*m_costs[a])[m] < (*m_costs[b])[m]; });
+
+				const double lo((*m_costs[sorted.front()])[m]);
+				const double hi((*m_costs[sorted.back()])[m]);
+
+				distance[sorted.front()] = std::numeric_limits< double >::infinity();
+				distance[sorted.back()] = std::numeric_limits< double >::infinity();
+
+				if (hi <= lo)
+					continue;
+
+				for (size_t n = 1; n + 1 < sorted.size(); ++n)
+					distance[sorted[n]] += ((*m_costs[sorted[n + 1]])[m] - (*m_costs[sorted[n - 1]])[m]) / (hi - lo);
+			}
+		}
+
+		void crowding_parallel()
+		{
+			const size_t N(m_costs.size());
+			const size_t M(m_costs[0]->size());
+			const size_t threadCount(std::min(m_threads, M));
+
+			m_partial.resize(threadCount);
+			m_sorted.resize(threadCount);
+
+			std::vector< std::thread > threads;
+			for (size_t t = 0; t < threadCount; ++t)
+			{
+				threads.push_back(std::thread([this, t, threadCount, M, N]()
+				{
+					m_partial[t].assign(N, 0);
+
+					for (size_t m = t; m < M; m += threadCount)
+						crowding(m, m_partial[t], m_sorted[t]);
+				}));
+			}
+
+			for (size_t t = 0; t < threads.size(); ++t)
+				threads[t].join();
+
+			for (size_t t = 0; t < threadCount; ++t)
+			{
+				for (size_t i = 0; i < N; ++i)
+					m_crowding[i] += m_partial[t][i];
+			}
+		}
+	};
+
+}
+
+#endif //DE_PARETO_RANKING_HPP_INCLUDED
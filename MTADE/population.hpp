@@ -7,6 +7,8 @@
 #pragma once
 #endif
 
+#include <algorithm>
+
 #include "individual.hpp"
 
 namespace de
@@ -15,7 +17,7 @@ namespace de
 	typedef std::vector< individual_ptr > population_base;
 
 	/**
-	 * Ⱥ
+	 * 种群类
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -23,12 +25,12 @@ namespace de
 	{
 	public:
 		/**
-		 * δʼȺ
+		 * 构造包含未初始化个体的种群对象
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
-		 * @param popSize Ⱥģ()
-		 * @param varCount ÿı
+		 * @param popSize 种群规模(个体数量)
+		 * @param varCount 每个个体的变量个数
 		 */
 		population(size_t popSize, size_t varCount)
 			: population_base(popSize)
@@ -40,14 +42,14 @@ namespace de
 		}
 
 		/**
-		 * һȺͨȽбΪӦԼʩӵڵ
-		 * ֵʼ壬ȻΪÿĿ꺯Լشۡ
+		 * 构造一个种群对象并通过首先将所有变量设置为在相应约束所施加的限制内的
+		 * 随机值来初始化其个体，然后为每个个体运行目标函数以计算相关代价。
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
-		 * @param popSize Ⱥģ()
-		 * @param varCount ÿı
-		 * @param constraints ʼʱʹõԼ
+		 * @param popSize 种群规模(个体数量)
+		 * @param varCount 每个个体的变量个数
+		 * @param constraints 初始化个体时使用的约束集合
 		 */
 		population(size_t popSize, size_t varCount, constraints_ptr constraints)
 			: population_base(popSize)
@@ -62,7 +64,7 @@ namespace de
 		}
 
 		/**
-		 * һȺõĸ
+		 * 返回一个种群中最好的个体
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -79,7 +81,43 @@ namespace de
 		}
 
 		/**
-		 * Ⱥַʾʽ
+		 * 把种群缩小到指定的规模，只保留最好的个体。
+		 *
+		 * 先用部分排序把最好的size个个体移到前面，再删除其余的个体；容器不会重新分配内存，
+		 * 保留下来的个体之间的顺序不确定。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param size 新的种群规模，不大于当前规模
+		 * @param minimize 如果为true，代价越小越好，否则代价越大越好
+		 */
+		void shrink(size_t size, bool minimize)
+		{
+			shrink(size, [minimize](const individual_ptr& ind1, const individual_ptr& ind2) { return ind1->better(ind2, minimize); });
+		}
+
+		/**
+		 * 把种群缩小到指定的规模，只保留按给定的比较最好的个体，例如按可行性规则（见feasibility_rule::better）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param size 新的种群规模，不大于当前规模
+		 * @param better 比较两个个体，第一个严格优于第二个时返回true（严格弱序）
+		 */
+		template< typename Better > void shrink(size_t size, Better better)
+		{
+			assert(size > 0);
+
+			if (size >= this->size())
+				return;
+
+			std::nth_element(begin(), begin() + (size - 1), end(), better);
+
+			erase(begin() + size, end());
+		}
+
+		/**
+		 * 返回种群的字符串表示形式
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -0,0 +1,188 @@
+#ifndef DE_POPULATION_SIZE_STRATEGY_HPP_INCLUDED
+#define DE_POPULATION_SIZE_STRATEGY_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "mutation_strategy.hpp"
+
+namespace de
+{
+
+	/**
+	 * 定义种群规模策略接口的抽象基类。
+	 *
+	 * 种群规模策略根据已经使用的目标函数计算次数决定下一代的种群规模。差分进化在每一代选择之后
+	 * 调用该策略，种群只会缩小，保留最好的个体。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class population_size_strategy
+	{
+	public:
+		virtual ~population_size_strategy() {}
+
+		/**
+		 * 返回下一代的种群规模
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param evaluations 到目前为止目标函数的计算次数（包括初始种群）
+		 *
+		 * @return size_t
+		 */
+		virtual size_t operator()(size_t evaluations) = 0;
+	};
+
+	/**
+	 * A smart pointer to a population size strategy
+	 */
+	typedef std::shared_ptr< population_size_strategy > population_size_strategy_ptr;
+
+	/**
+	 * 按计算次数的预算缩小种群规模的策略的公共部分：从初始规模开始，在用完预算时达到最小规模。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class budget_population_size_strategy : public population_size_strategy
+	{
+	private:
+		const size_t m_initial;
+		const size_t m_minimum;
+		const size_t m_maxEvaluations;
+
+	public:
+		/**
+		 * constructs a budget population size strategy
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param initial 初始种群规模
+		 * @param minimum 最小种群规模，变异策略至少需要URN_DEPTH个个体
+		 * @param maxEvaluations 目标函数计算次数的预算
+		 */
+		budget_population_size_strategy(size_t initial, size_t minimum, size_t maxEvaluations)
+			: m_initial(initial), m_minimum(minimum), m_maxEvaluations(maxEvaluations)
+		{
+			assert(minimum >= URN_DEPTH);
+			assert(initial >= minimum);
+			assert(maxEvaluations > 0);
+		}
+
+		virtual size_t operator()(size_t evaluations)
+		{
+			double progress(std::min(1.0, double(evaluations) / m_maxEvaluations));
+			double size(m_initial + (double(m_minimum) - double(m_initial)) * schedule(progress));
+
+			return std::max(m_minimum, size_t(size + 0.5));
+		}
+
+		/**
+		 * 返回初始种群规模
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t initial() const { return m_initial; }
+
+		/**
+		 * 返回最小种群规模
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t minimum() const { return m_minimum; }
+
+		/**
+		 * 返回目标函数计算次数的预算
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t max_evaluations() const { return m_maxEvaluations; }
+
+	protected:
+		/**
+		 * 缩小的进度：预算使用比例为progress时，已经缩小的规模占总缩小量的比例
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param progress 0-1之间的预算使用比例
+		 *
+		 * @return double 0-1之间的值
+		 */
+		virtual double schedule(double progress) const = 0;
+	};
+
+	/**
+	 * 线性种群规模缩减（L-SHADE的LPSR）：种群规模随计算次数线性地从初始规模减小到最小规模
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class linear_population_size_strategy : public budget_population_size_strategy
+	{
+	public:
+		/**
+		 * constructs a linear population size strategy
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param initial 初始种群规模
+		 * @param minimum 最小种群规模
+		 * @param maxEvaluations 目标函数计算次数的预算
+		 */
+		linear_population_size_strategy(size_t initial, size_t minimum, size_t maxEvaluations)
+			: budget_population_size_strategy(initial, minimum, maxEvaluations)
+		{
+		}
+
+	protected:
+		virtual double schedule(double progress) const
+		{
+			return progress;
+		}
+	};
+
+	/**
+	 * 非线性种群规模缩减（NLPSR）：缩小的进度为progress^(1 - progress)，前期缩小得比线性更快，
+	 * 后期以较小的种群用完剩余的预算
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class nonlinear_population_size_strategy : public budget_population_size_strategy
+	{
+	public:
+		/**
+		 * constructs a nonlinear population size strategy
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param initial 初始种群规模
+		 * @param minimum 最小种群规模
+		 * @param maxEvaluations 目标函数计算次数的预算
+		 */
+		nonlinear_population_size_strategy(size_t initial, size_t minimum, size_t maxEvaluations)
+			: budget_population_size_strategy(initial, minimum, maxEvaluations)
+		{
+		}
+
+	protected:
+		virtual double schedule(double progress) const
+		{
+			return std::pow(progress, 1.0 - progress);
+		}
+	};
+
+}
+
+#endif //DE_POPULATION_SIZE_STRATEGY_HPP_INCLUDED
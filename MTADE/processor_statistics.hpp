@@ -0,0 +1,190 @@
+#ifndef DE_PROCESSOR_STATISTICS_HPP_INCLUDED
+#define DE_PROCESSOR_STATISTICS_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <chrono>
+#include <vector>
+
+#include "processors.hpp"
+
+namespace de
+{
+
+	/**
+	 * 统计每个处理器的计算时间和计算次数的处理器监听器。
+	 *
+	 * 每个处理器只修改自己索引对应的统计项，因此不需要加锁；统计项之间用填充隔开，
+	 * 避免不同线程写入同一缓存行。只应在处理器没有运行时（start之前或wait之后）读取统计值。
+	 *
+	 * 与处理器集合的运行时间（start到wait返回）结合，可以得到处理器在屏障处的空闲比例：
+	 * 1 - total_busy() / (count * 运行时间)。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class processor_statistics_listener : public processor_listener
+	{
+	private:
+		typedef std::chrono::steady_clock clock_type;
+
+		struct slot
+		{
+			clock_type::time_point start;
+			double busy;
+			size_t evaluations;
+			char padding[64];
+
+			slot()
+				: busy(0), evaluations(0)
+			{
+			}
+		};
+
+		std::vector< slot > m_slots;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param count 处理器的个数
+		 */
+		processor_statistics_listener(size_t count)
+			: m_slots(count)
+		{
+			assert(count > 0);
+		}
+
+		virtual void start(size_t index)
+		{
+		}
+
+		virtual void start_of(size_t index, individual_ptr individual)
+		{
+			assert(index < m_slots.size());
+			m_slots[index].start = clock_type::now();
+		}
+
+		virtual void end_of(size_t index, individual_ptr individual)
+		{
+			assert(index < m_slots.size());
+
+			slot& s(m_slots[index]);
+			s.busy += std::chrono::duration< double >(clock_type::now() - s.start).count();
+			++s.evaluations;
+		}
+
+		virtual void end(size_t index)
+		{
+		}
+
+		virtual void error(size_t index, const std::string& message)
+		{
+		}
+
+		/**
+		 * 清除所有统计值
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void reset()
+		{
+			for (size_t n = 0; n < m_slots.size(); ++n)
+				m_slots[n] = slot();
+		}
+
+		/**
+		 * 返回处理器的个数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t count() const { return m_slots.size(); }
+
+		/**
+		 * 返回一个处理器计算目标函数所用的时间（秒）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param index 处理器索引
+		 *
+		 * @return double
+		 */
+		double busy(size_t index) const { return m_slots.at(index).busy; }
+
+		/**
+		 * 返回一个处理器计算目标函数的次数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param index 处理器索引
+		 *
+		 * @return size_t
+		 */
+		size_t evaluations(size_t index) const { return m_slots.at(index).evaluations; }
+
+		/**
+		 * 返回所有处理器计算目标函数所用的时间之和（秒）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double total_busy() const
+		{
+			double busy(0);
+			for (size_t n = 0; n < m_slots.size(); ++n)
+				busy += m_slots[n].busy;
+
+			return busy;
+		}
+
+		/**
+		 * 返回所有处理器计算目标函数的总次数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t total_evaluations() const
+		{
+			size_t evaluations(0);
+			for (size_t n = 0; n < m_slots.size(); ++n)
+				evaluations += m_slots[n].evaluations;
+
+			return evaluations;
+		}
+
+		/**
+		 * 根据处理器集合的运行时间计算处理器在屏障处的空闲比例
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param elapsed 处理器集合运行的总时间（秒），即从start到wait返回的时间之和
+		 *
+		 * @return double 0-1之间的值
+		 */
+		double idle_fraction(double elapsed) const
+		{
+			if (elapsed <= 0)
+				return 0;
+
+			double idle = 1.0 - total_busy() / (elapsed * m_slots.size());
+			return idle < 0 ? 0 : idle;
+		}
+	};
+
+	/**
+	 * 指向处理器统计监听器的智能指针
+	 */
+	typedef std::shared_ptr< processor_statistics_listener > processor_statistics_listener_ptr;
+
+}
+
+#endif //DE_PROCESSOR_STATISTICS_HPP_INCLUDED
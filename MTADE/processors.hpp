@@ -8,20 +8,27 @@
 #endif
 
 #include <queue>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <functional>   // std::ref
 
 #include "boost_noncopyable.hpp"
 #include "boost_threadgroup.hpp"
+#include "cost_model.hpp"
+#include "cpu_quota.hpp"
 #include "individual.hpp"
+#include "numa.hpp"
 #include "population.hpp"
+#include "worker_tuning.hpp"
 
 namespace de
 {
 
 	/**
-	 * ڳ࣬ڴӴ¼Ĵ
+	 * 基于抽象的类，用于从处理器接收事件的处理器侦听器。
 	 *
-	 * ䷽ǴӶ̵߳õģ˾ʹ߳ͬԱ𻵡
+	 * 由于其方法是从多个线程调用的，因此具体类必须使用线程同步对象以避免数据损坏。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -30,35 +37,35 @@ namespace de
 	public:
 		virtual ~processor_listener() {}
 		/**
-		 * Ŀ꺯ĴoperatorĿͷ
+		 * 在运行目标函数的处理器operator（）的开头调用
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
+		 * @param index 处理器索引
 		 */
 		virtual void start(size_t index) = 0;
 		/**
-		 * ʹõǰıĿ꺯֮ǰ
+		 * 在使用当前个体的变量运行目标函数之前调用
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
-		 * @param individual Ŀ꺯ĵǰ
+		 * @param index 处理器索引
+		 * @param individual 运行目标函数的当前个体
 		 */
 		virtual void start_of(size_t index, individual_ptr individual) = 0;
 		/**
-		 * ʹõǰıĿ꺯áΪݵĸ廹Ŀ꺯нĳɱ
+		 * 在使用当前个体的变量运行目标函数后调用。作为参数传递的个体还具有目标函数运行结果的成本集。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
-		 * @param individual Ŀ꺯еİ۵ĵǰ塣
+		 * @param index 处理器索引
+		 * @param individual 目标函数运行的包含代价的当前个体。
 		 */
 		virtual void end_of(size_t index, individual_ptr individual) = 0;
 		/**
-		 * Ŀ꺯Ĵĩβá
+		 * 在运行目标函数的处理器运算符（）的末尾调用。
 		 *
-		 * ʹ׳쳣Ҳô˺
+		 * 即使抛出异常，也会调用此函数。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
@@ -66,21 +73,21 @@ namespace de
 		 */
 		virtual void end(size_t index) = 0;
 		/**
-		 * Ŀ꺯ڼ쳣ָʾá
+		 * 如果在目标函数运行期间引发异常并指示错误，则调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
-		 * @param message ϢϢ
+		 * @param index 处理器索引
+		 * @param message 描述错误信息的消息
 		 */
 		virtual void error(size_t index, const std::string& message) = 0;
 
 	};
 
 	/**
-	 * ִκβĴĻʵ֡
+	 * 不执行任何操作的处理器侦听器的基本实现。
 	 *
-	 * ҪͬΪûݱȡ޸ġ
+	 * 不需要同步，因为没有数据被读取或修改。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -88,56 +95,56 @@ namespace de
 	{
 	public:
 		/**
-		 * Ŀ꺯ĴoperatorĿͷá
+		 * 在运行目标函数的处理器operator（）的开头调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
+		 * @param index 处理器索引
 		 */
 		virtual void start(size_t index)
 		{
 		}
 		/**
-		 * ʹõǰıĿ꺯֮ǰá
+		 * 在使用当前个体的变量运行目标函数之前调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
-		 * @param individual Ŀ꺯еĵǰ
+		 * @param index 处理器的索引
+		 * @param individual 目标函数运行的当前个体
 		 */
 		virtual void start_of(size_t index, individual_ptr individual)
 		{
 		}
 		/**
-		 * ʹõǰıĿ꺯á ΪݵĸҲ趨ΪĿ꺯еĽ
+		 * 使用当前个体的变量运行目标函数后调用。 作为参数传递的个体也将代价设定为目标函数运行的结果。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
-		 * @param individual Ŀ꺯ݵİ۵ĵǰ塣
+		 * @param index 处理器索引
+		 * @param individual 目标函数所依据的包含代价的当前个体。
 		 */
 		virtual void end_of(size_t index, individual_ptr individual)
 		{
 		}
 		/**
-		 * Ŀ꺯Ĵoperatorĩβá
+		 * 在运行目标函数的处理器operator（）的末尾调用。
 		 *
-		 * ʹ쳣׳Ҳᱻá
+		 * 即使有异常抛出也会被调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
+		 * @param index 处理器索引
 		 */
 		virtual void end(size_t index)
 		{
 		}
 		/**
-		 * Ŀ꺯ڼ쳣ָʾá
+		 * 如果在目标函数运行期间引发异常并指示错误，则调用。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
-		 * @param message ϢϢ
+		 * @param index 处理器索引
+		 * @param message 描述错误信息的消息
 		 */
 		virtual void error(size_t index, const std::string& message)
 		{
@@ -146,12 +153,12 @@ namespace de
 
 
 	/**
-	 *ָָ
+	 *指向处理器侦听器的智能指针
 	 */
 	typedef std::shared_ptr< processor_listener > processor_listener_ptr;
 
 	/**
-	 * Ŀ꺯׳쳣
+	 * 如果目标函数出错，则抛出异常。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -159,11 +166,11 @@ namespace de
 	{
 	public:
 		/**
-		 * һobjective_function_exception
+		 * 构造一个objective_function_exception对象
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param message 쳣ĴϢ
+		 * @param message 描述引起异常的错误信息
 		 */
 		objective_function_exception(const std::string& message)
 			: exception(message.c_str())
@@ -172,16 +179,16 @@ namespace de
 	};
 
 	/**
-	 * Ŀ꺯ĽӿڡĿ꺯Ҫ󽫲ͬʵݸÿ
-	 * 봴һԴľobject_function_factoryʵ
-	 * makeԴĿ꺯ʵ
+	 * 目标函数工厂的接口。如果目标函数要求将不同的实例传递给每个处理器，
+	 * 请创建一个派生自此类的具体的object_function_factory，并实现
+	 * 虚make方法以创建目标函数的新实例。
 	 *
-	 * ʹöobject_function_exceptionûshared_ptrΪ
-	 * ģӦĶΪ캯ݡ
+	 * 使用对object_function_exception的引用或shared_ptr作为处理
+	 * 器模板参数，并将相应的对象作为构造函数参数传递。
 	 *
-	 * ӦĴཫȷӦȷΪ
+	 * 上面相应的处理器特征类将确保应用正确的行为。
 	 *
-	 * ģTĿ꺯͡
+	 * 模板参数T是目标函数的类型。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -189,29 +196,29 @@ namespace de
 	{
 	public:
 		/**
-		 * ָĿ꺯ָ
+		 * 定义指向目标函数的类型指针
 		 */
 		typedef std::shared_ptr< T > T_ptr;
 
 		/**
-		 * 
+		 * 虚析构函数
 		 *
 		 * @author louiehan (11/11/2019)
 		 */
 		virtual ~objective_function_factory() {}
 
 		/**
-		 *ʵֵķĿ꺯ʵ
+		 *在派生类中实现的方法将创建目标函数的新实例。
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @return T_ptr Ŀ꺯ָ
+		 * @return T_ptr 目标函数的智能指针
 		 */
 		virtual T_ptr make() = 0;
 	};
 
 	/**
-	 * Ŀ꺯ͨôݲƵµĻ
+	 * 目标函数通过引用传递并复制的情况下的基本处理器特征类
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -220,13 +227,14 @@ namespace de
 	public:
 		// \cond
 		typedef T  value_type;
-		static double run(T t, de::DVectorPtr vars) { return t(vars); }
+		static auto run(T t, de::DVectorPtr vars) -> decltype(t(vars)) { return t(vars); }
+		static auto run(T t, de::DVectorPtr vars, de::evaluation_context& context) -> decltype(de::invoke_objective(t, vars, context, 0)) { return de::invoke_objective(t, vars, context, 0); }
 		static T make(T t) { return t; }
 		// \endcond
 	};
 
 	/**
-	 * Ŀ꺯Ϊָ봫ݵµרô
+	 * 目标函数作为指针传递的情况下的专用处理器特征类
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -235,13 +243,14 @@ namespace de
 	public:
 		// \cond
 		typedef T*  value_type;
-		static double run(value_type t, de::DVectorPtr vars) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars) -> decltype((*t)(vars)) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars, de::evaluation_context& context) -> decltype(de::invoke_objective(*t, vars, context, 0)) { return de::invoke_objective(*t, vars, context, 0); }
 		static value_type make(value_type t) { return t; }
 		// \endcond
 	};
 
 	/**
-	 * Ŀ꺯Ϊָ봫ʱ⴦ࡣ
+	 * 当目标函数作为共享指针传递时的特殊处理器特征类。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -250,13 +259,14 @@ namespace de
 	public:
 		// \cond
 		typedef std::shared_ptr< T > value_type;
-		static double run(value_type t, de::DVectorPtr vars) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars) -> decltype((*t)(vars)) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars, de::evaluation_context& context) -> decltype(de::invoke_objective(*t, vars, context, 0)) { return de::invoke_objective(*t, vars, context, 0); }
 		static value_type make(value_type t) { return t; }
 		// \endcond
 	};
 
 	/**
-	 * յĿ꺯ָµרôࡣ
+	 * 处理器接收到目标函数工厂的指针的情况下的专用处理器特征类。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -265,12 +275,13 @@ namespace de
 	public:
 		// \cond
 		typedef std::shared_ptr< T > value_type;
-		static double run(value_type t, de::DVectorPtr vars) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars) -> decltype((*t)(vars)) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars, de::evaluation_context& context) -> decltype(de::invoke_objective(*t, vars, context, 0)) { return de::invoke_objective(*t, vars, context, 0); }
 		static value_type make(objective_function_factory< T >* off) { return off->make(); }
 		// \endcond
 	};
 	/**
-	 * յĿ꺯Ĺָµרôࡣ
+	 * 处理器接收到目标函数工厂的共享指针的情况下的专用处理器特征类。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -279,13 +290,14 @@ namespace de
 	public:
 		// \cond
 		typedef std::shared_ptr< T > value_type;
-		static double run(value_type t, de::DVectorPtr vars) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars) -> decltype((*t)(vars)) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars, de::evaluation_context& context) -> decltype(de::invoke_objective(*t, vars, context, 0)) { return de::invoke_objective(*t, vars, context, 0); }
 		static value_type make(std::shared_ptr< objective_function_factory< T > > off) { return off->make(); }
 		// \endcond
 	};
 
 	/**
-	 * յĿ꺯õµרôࡣ
+	 * 处理器接收到目标函数工厂的引用的情况下的专用处理器特征类。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -294,63 +306,262 @@ namespace de
 	public:
 		// \cond
 		typedef std::shared_ptr< T > value_type;
-		static double run(value_type t, de::DVectorPtr vars) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars) -> decltype((*t)(vars)) { return (*t)(vars); }
+		static auto run(value_type t, de::DVectorPtr vars, de::evaluation_context& context) -> decltype(de::invoke_objective(*t, vars, context, 0)) { return de::invoke_objective(*t, vars, context, 0); }
 		static value_type make(objective_function_factory< T >& off) { return off.make(); }
 		// \endcond
 	};
 
 	/**
-	 * һ߳Ŀ꺯 ߳߳вĿ꺯
+	 * 分成若干个分区（每个NUMA节点一个）的线程安全的个体队列。
 	 *
-	 * ʹӦprocessor_traitsжĿ꺯͡
+	 * 个体被放入所属节点的分区；处理器先从自己节点的分区取个体，自己的分区为空时再从其他分区取，
+	 * 因此计算在节点之间不均衡时也不会有处理器空闲。只有一个分区时与individual_queue相同。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class partitioned_queue : boost::noncopyable
+	{
+	private:
+		std::vector< std::shared_ptr< individual_queue > > m_queues;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param partitions 分区数，至少为1
+		 */
+		explicit partitioned_queue(size_t partitions = 1)
+		{
+			assert(partitions > 0);
+
+			for (size_t n = 0; n < partitions; ++n)
+				m_queues.push_back(std::make_shared< individual_queue >());
+		}
+
+		/**
+		 * 返回分区数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t partitions() const { return m_queues.size(); }
+
+		/**
+		 * 在分区的底部添加个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param ind 个体
+		 * @param partition 分区索引
+		 */
+		void push(individual_ptr ind, size_t partition = 0)
+		{
+			assert(partition < m_queues.size());
+			m_queues[partition]->push_back(ind);
+		}
+
+		/**
+		 * 从分区的顶部取出个体，分区为空时依次从其他分区取
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param partition 首先使用的分区
+		 *
+		 * @return individual_ptr 个体；所有分区都为空时为null
+		 */
+		individual_ptr pop(size_t partition = 0)
+		{
+			assert(partition < m_queues.size());
+
+			for (size_t n = 0; n < m_queues.size(); ++n)
+			{
+				individual_ptr ind(m_queues[(partition + n) % m_queues.size()]->pop());
+				if (ind)
+					return ind;
+			}
+
+			return individual_ptr();
+		}
+
+		/**
+		 * 从分区的顶部取出最多count个个体，分区为空时依次从其他分区取
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param partition 首先使用的分区
+		 * @param count 最多取出的个体数
+		 * @param batch 接收个体的向量
+		 *
+		 * @return size_t 取出的个体数；所有分区都为空时为0
+		 */
+		size_t pop(size_t partition, size_t count, std::vector< individual_ptr >& batch)
+		{
+			assert(partition < m_queues.size());
+
+			for (size_t n = 0; n < m_queues.size(); ++n)
+			{
+				const size_t popped(m_queues[(partition + n) % m_queues.size()]->pop(count, batch));
+				if (popped > 0)
+					return popped;
+			}
+
+			return 0;
+		}
+
+		/**
+		 * 删除所有分区中的个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t 删除的个体数
+		 */
+		size_t clear()
+		{
+			size_t count(0);
+			for (size_t n = 0; n < m_queues.size(); ++n)
+				count += m_queues[n]->clear();
+
+			return count;
+		}
+
+		/**
+		 * 所有分区是否都为空，只在没有处理器运行时调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool empty() const
+		{
+			for (size_t n = 0; n < m_queues.size(); ++n)
+			{
+				if (!m_queues[n]->empty())
+					return false;
+			}
+
+			return true;
+		}
+	};
+
+	/**
+	 * 处理器在一个线程中运行目标函数。 可以有许多线程在任意多个线程中并行运行目标函数。
+	 *
+	 * 处理器类使用在相应的processor_traits中定义的目标函数的类型。
+	 *
+	 * 指定了NUMA放置时，处理器线程每次运行时绑定到所属节点，目标函数（或目标函数工厂生成的目标函数）
+	 * 在处理器线程第一次运行时才创建，它分配的数据因此由所属节点首先访问（first touch），位于该节点的内存中。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
 	template < typename T > class processor : boost::noncopyable
 	{
 	private:
-		typename processor_traits< T >::value_type m_of;
-		individual_queue& m_indQueue;
+		T m_source;
+		std::unique_ptr< typename processor_traits< T >::value_type > m_of;
+		partitioned_queue& m_indQueue;
 		processor_listener_ptr m_listener;
 		size_t m_index;
 
+		numa_placement_ptr m_placement;
+		size_t m_node;
+
+		size_t m_batch;
+		size_t m_evaluations;
+		double m_busy;
+
+		cost_model_ptr m_model;
+		std::chrono::steady_clock::time_point m_finished;
+
 		bool m_result;
 
 	public:
 		/**
-		 * 캯
+		 * 处理器对象构造函数
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
-		 * @param index 
-		 * @param of Ŀ꺯Ŀ꺯ָ롢ָ롢
-		 * @param indQueue ҪĸĶ
-		 * @param listener ڴĿ꺯ڼ佫Ҫ¼֪ͨ
+		 * @param index 处理器索引
+		 * @param of 目标函数，或目标函数工厂。接受指针、共享指针、引用
+		 * @param indQueue 包含要处理的个体的队列
+		 * @param listener 在处理目标函数期间将接收重要事件通知的侦听器。
+		 * @param placement 可选的NUMA放置
+		 * @param node 处理器所属的节点，也是首先使用的队列分区
 		 */
-		processor(size_t index, T of, individual_queue& indQueue, processor_listener_ptr listener)
-			: m_of(processor_traits< T >::make(of)), m_indQueue(indQueue), m_result(false), m_listener(listener), m_index(index)
+		processor(size_t index, T of, partitioned_queue& indQueue, processor_listener_ptr listener, numa_placement_ptr placement = numa_placement_ptr(), size_t node = 0)
+			: m_source(of), m_indQueue(indQueue), m_result(false), m_listener(listener), m_index(index), m_placement(placement), m_node(node),
+			m_batch(1), m_evaluations(0), m_busy(0)
 		{
 			assert(listener);
+			assert(node < indQueue.partitions());
+
+			if (!placement)
+				m_of.reset(new typename processor_traits< T >::value_type(processor_traits< T >::make(of)));
 		}
 
 		/**
-		 * ԶжĶУĿ꺯
+		 * 对队列顶部的对象（如果有）运行目标函数
 		 *
 		 * @author louiehan (11/11/2019)
 		 */
-		void operator()()
+		void operator()() { run(true); }
+
+		/**
+		 * 对队列中的个体运行目标函数，每次从队列中取出最多batch个个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pin 有NUMA放置时是否把当前线程绑定到所属节点；在调用线程中内联计算时为false
+		 */
+		void run(bool pin)
 		{
 			m_listener->start(m_index);
 			m_result = false;
 			try
 			{
-				for (individual_ptr ind = m_indQueue.pop(); ind; ind = m_indQueue.pop())
+				if (m_placement && pin)
+					m_placement->pin(m_node);
+
+				if (!m_of)
+					m_of.reset(new typename processor_traits< T >::value_type(processor_traits< T >::make(m_source)));
+
+				// 有耗时模型时每次只取一个个体，否则先取的线程会拿走最长的几个，从长到短的顺序就没有意义了
+				const size_t count(m_model ? 1 : m_batch);
+
+				std::vector< individual_ptr > batch;
+				batch.reserve(count);
+
+				for (;;)
 				{
-					m_listener->start_of(m_index, ind);
-					double result = processor_traits< T >::run(m_of, ind->vars());
+					batch.clear();
+					if (m_indQueue.pop(m_node, count, batch) == 0)
+						break;
+
+					const std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+
+					for (size_t n = 0; n < batch.size(); ++n)
+					{
+						const individual_ptr& ind(batch[n]);
+
+						std::chrono::steady_clock::time_point begin;
+						if (m_model)
+							begin = std::chrono::steady_clock::now();
+
+						m_listener->start_of(m_index, ind);
+						// 多目标函数返回代价向量，见individual::setCost；接受evaluation_context的目标函数可以提前放弃计算
+						ind->context().start();
+						ind->setCost(processor_traits< T >::run(*m_of, ind->vars(), ind->context()));
+						m_listener->end_of(m_index, ind);
 
-					ind->setCost(result);
-					m_listener->end_of(m_index, ind);
+						if (m_model)
+							m_model->observe(ind->vars(), std::chrono::duration< double >(std::chrono::steady_clock::now() - begin).count());
+					}
+
+					m_busy += std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+					m_evaluations += batch.size();
 				}
 				m_result = true;
 
@@ -365,22 +576,71 @@ namespace de
 				m_result = false;
 				m_listener->error(m_index, e.what());
 			}
+
+			m_finished = std::chrono::steady_clock::now();
 		}
 
 		/**
-		 * ָʾ߳˳ʱǷɹ
+		 * 指示线程退出时运行是否成功结束
 		 *
 		 * @author louiehan (11/11/2019)
 		 *
 		 * @return bool
 		 */
 		bool success() const { return m_result; }
+
+		/**
+		 * 设置每次从队列中取出的个体数，只在处理器没有运行时调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param batch 批大小，至少为1
+		 */
+		void set_batch(size_t batch) { m_batch = std::max< size_t >(1, batch); }
+
+		/**
+		 * 设置耗时模型，每次计算的耗时报告给它（见cost_model::observe），null不报告。只在处理器没有运行时调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param model 耗时模型
+		 */
+		void set_cost_model(cost_model_ptr model) { m_model = model; }
+
+		/**
+		 * 返回上次运行结束（队列为空）的时间
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return std::chrono::steady_clock::time_point
+		 */
+		std::chrono::steady_clock::time_point finished() const { return m_finished; }
+
+		/**
+		 * 返回上次调用以来的计算次数和用于计算的时间（秒），并清零，只在处理器没有运行时调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param evaluations 计算次数
+		 *
+		 * @return double 用于计算的时间
+		 */
+		double take_busy(size_t& evaluations)
+		{
+			const double busy(m_busy);
+
+			evaluations = m_evaluations;
+			m_evaluations = 0;
+			m_busy = 0;
+
+			return busy;
+		}
 	};
 
 
 
 	/**
-	 * ʱ׳쳣
+	 * 发生处理器错误时抛出异常。
 	 *
 	 * @author louiehan (11/11/2019)
 	 */
@@ -388,7 +648,7 @@ namespace de
 	{
 	public:
 		/**
-		 * 캯ϢַΪ
+		 * 构造函数，以消息字符串作为参数
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -402,11 +662,55 @@ namespace de
 
 
 	/**
-	 * 
+	 * 处理器线程在一代结束时（屏障）的空闲统计：先结束的线程等待最后一个线程的时间
 	 *
-	 * ŻỰڼЭִ
+	 * @author louiehan (10/19/2026)
+	 */
+	struct barrier_statistics
+	{
+		/**
+		 * 统计的代数（使用处理器线程的计算次数）
+		 */
+		size_t generations;
+		/**
+		 * 所有线程在屏障处空闲的总时间（秒）
+		 */
+		double idleSeconds;
+		/**
+		 * 所有线程从开始到最后一个线程结束的总时间（秒）
+		 */
+		double workerSeconds;
+
+		barrier_statistics()
+			: generations(0), idleSeconds(0), workerSeconds(0)
+		{
+		}
+
+		/**
+		 * 返回每代平均的空闲时间（秒）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double mean_idle() const { return generations > 0 ? idleSeconds / generations : 0; }
+
+		/**
+		 * 返回空闲时间占线程时间的比例
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double idle_fraction() const { return workerSeconds > 0 ? idleSeconds / workerSeconds : 0; }
+	};
+
+	/**
+	 * 处理器集合
+	 *
+	 * 此类在优化会话期间启动并协调各种处理器。
 	 *
-	 * Ŀ꺯Ŀ꺯Ϊãָshared_ptr
+	 * 将目标函数或目标函数工厂的类型作为参数（引用，指针或shared_ptr）。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -419,78 +723,314 @@ namespace de
 		typedef std::shared_ptr< T > T_ptr;
 
 	private:
-		individual_queue m_indQueue;
+		T m_of;
+		processor_listener_ptr m_listener;
+		partitioned_queue m_indQueue;
 		processor_vector m_processors;
+		numa_placement_ptr m_placement;
+		size_t m_next;
 		thread_group_ptr m_threads;
 
+		worker_tuning_ptr m_tuning;
+		cpu_quota_monitor_ptr m_quota;
+		size_t m_limit;
+		size_t m_workers;
+		size_t m_started;
+		size_t m_pushed;
+		size_t m_items;
+
+		std::mutex m_runningMx;
+		std::condition_variable m_runningCv;
+		size_t m_running;
+
+		cost_model_ptr m_model;
+		barrier_statistics m_barrier;
+		std::chrono::steady_clock::time_point m_startTime;
+		bool m_measure;
+
 	public:
 		/**
-		 * һȻʹṩĿ꺯조
+		 * 作为处理器数量传递时，创建与可用的CPU数（亲和性掩码和cgroup的CPU限额，见cpu_quota）相同的处理器，
+		 * 并根据测得的目标函数耗时自动选择每次计算使用的线程数和批大小，见worker_tuning
+		 */
+		static const size_t auto_workers = 0;
+
+		/**
+		 * 构造一个处理器对象，然后使用提供的目标函数构造“计数”处理器
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
-		 * @param count Ĵ
-		 * @param of Ŀ꺯Ŀ꺯
-		 * @param listener ݸÿĴ
+		 * @param count 创建的处理器数量，或auto_workers
+		 * @param of 目标函数或目标函数工厂
+		 * @param listener 传递给每个创建的处理器的侦听器
+		 * @param placement 可选的NUMA放置：处理器线程绑定到节点，处理队列按节点分区
 		 */
-		processors(size_t count, T of, processor_listener_ptr listener)
+		processors(size_t count, T of, processor_listener_ptr listener, numa_placement_ptr placement = numa_placement_ptr())
+			: m_of(of), m_listener(listener), m_indQueue(placement ? placement->node_count() : 1), m_placement(placement), m_next(0),
+			m_limit(count), m_workers(count), m_started(0), m_pushed(0), m_items(0), m_running(0), m_measure(false)
 		{
-			assert(count > 0);
 			assert(listener);
 
-			for (size_t n = 0; n < count; ++n)
+			if (count == auto_workers)
 			{
-				processor_ptr processor(std::make_shared< processor< T > >(n, of, std::ref(m_indQueue), listener));
-				m_processors.push_back(processors< T >::processor_ptr(processor));
+				count = cpu_quota::detect().workers();
+				m_limit = count;
+				m_workers = count;
+				m_tuning = std::make_shared< worker_tuning >(count);
 			}
+
+			grow(count);
 		}
 
 		/**
-		 * 봦еĵײ
+		 * 将个体推入处理队列的底部。有NUMA放置时依次放入有处理器线程的各个节点的分区。
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
 		 * @param ind
 		 */
-		void push(individual_ptr ind) { m_indQueue.push(ind); }
+		void push(individual_ptr ind)
+		{
+			m_indQueue.push(ind, m_next++ % active_partitions());
+			++m_pushed;
+		}
+
+		/**
+		 * 设置每次计算使用的处理器线程数，0表示在调用线程中内联计算（start()返回时计算已经完成）。
+		 * 只在处理器没有运行时调用。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param workers 线程数，不超过处理器数量
+		 */
+		void set_workers(size_t workers) { m_workers = std::min(workers, m_processors.size()); }
+
 		/**
-		 * 첽д̣߳ȴɣ
+		 * 改变处理器集合的大小为count个处理器线程，需要时创建新的处理器。
+		 * 没有自动选择策略时count是目标大小：以后每次计算使用count个线程（内联计算时仍然内联）；
+		 * 有自动选择策略时count是它的最多线程数，实际的线程数由它选择。只在处理器没有运行时调用。
+		 *
+		 * 新创建的处理器的索引接着已有的处理器，侦听器要能接收这些索引（例如按最大的大小构造processor_statistics_listener）。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param count 处理器线程数，至少为1
+		 */
+		void resize(size_t count)
+		{
+			assert(count > 0);
+
+			grow(count);
+			m_limit = count;
+
+			if (m_tuning)
+				m_tuning->set_max_workers(count);
+			else if (m_workers > 0)
+				m_workers = count;
+		}
+
+		/**
+		 * 返回处理器集合的大小（最多使用的处理器线程数）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t size() const { return m_limit; }
+
+		/**
+		 * 设置CPU限额的监视器：每次计算开始时检查限额，改变时按cpu_quota::workers()调整处理器集合的大小。
+		 * null关闭监视。只在处理器没有运行时调用。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param monitor 监视器
+		 */
+		void set_quota_monitor(cpu_quota_monitor_ptr monitor)
+		{
+			m_quota = monitor;
+
+			if (monitor)
+				resize(monitor->workers());
+		}
+
+		/**
+		 * 返回CPU限额的监视器，没有时为null；它的throttling()返回被CFS限制的计数器
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return cpu_quota_monitor_ptr
+		 */
+		cpu_quota_monitor_ptr quota_monitor() const { return m_quota; }
+
+		/**
+		 * 返回每次计算使用的处理器线程数，0表示内联计算
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t workers() const { return m_workers; }
+
+		/**
+		 * 设置每个处理器每次从队列中取出的个体数，只在处理器没有运行时调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param batch 批大小，至少为1
+		 */
+		void set_batch(size_t batch)
+		{
+			for (typename processor_vector::size_type n = 0; n < m_processors.size(); ++n)
+				m_processors[n]->set_batch(batch);
+		}
+
+		/**
+		 * 设置自动选择线程数和批大小的策略，null关闭自动选择。只在处理器没有运行时调用。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param tuning 自动选择策略
+		 */
+		void set_tuning(worker_tuning_ptr tuning) { m_tuning = tuning; }
+
+		/**
+		 * 返回自动选择线程数和批大小的策略，没有时为null
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return worker_tuning_ptr
+		 */
+		worker_tuning_ptr tuning() const { return m_tuning; }
+
+		/**
+		 * 等待仍在运行的处理器线程（例如被cancel放弃的计算）结束
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		virtual ~processors()
+		{
+			if (m_threads)
+				m_threads->join_all();
+		}
+
+		/**
+		 * 异步启动所有处理器线程（它不会等待它们完成）。
+		 *
+		 * 如果上一次启动的线程还在运行（等待超时之后被放弃），先等待它们结束。
 		 *
 		 * @author louiehan (11/15/2019)
 		 */
 		void start()
 		{
-			// ÿδһ߳飬Ҫɾе߳
+			if (m_threads)
+				m_threads->join_all();
+
+			// 这次计算的个体数。上一次计算被放弃时没有调用wait，它的个体数和屏障在这里丢弃，不带到这一次
+			m_items = m_pushed;
+			m_pushed = 0;
+			m_measure = false;
+
+			if (m_quota && m_quota->poll())
+				resize(m_quota->workers());
+
+			// 内联计算：在调用线程中运行第一个处理器，没有线程同步
+			if (m_workers == 0)
+			{
+				m_started = 1;
+				m_running = 0;
+				m_processors[0]->run(false);
+				return;
+			}
+
+			m_started = std::min(m_workers, m_limit);
+			m_running = m_started;
+			m_startTime = std::chrono::steady_clock::now();
+			m_measure = true;
+
+			// 每次创建一个新线程组，不需要费心删除所有单独的线程
 			m_threads = std::make_shared< boost::thread_group >();
 
-			for (typename processor_vector::size_type n = 0; n < m_processors.size(); ++n)
+			for (typename processor_vector::size_type n = 0; n < m_started; ++n)
 			{
 				processor_ptr p(m_processors[n]);
-				std::thread* th(new std::thread(std::ref(*p)));
+				std::thread* th(new std::thread([this, p]()
+				{
+					(*p)();
+
+					std::lock_guard< std::mutex > lock(m_runningMx);
+					--m_running;
+					m_runningCv.notify_all();
+				}));
 				m_threads->add_thread(th);
 			}
 		}
 
 		/**
-		 * ٷ֮ǰȴд
+		 * 最多等待到deadline。如果所有处理器在此之前结束，与wait()相同地检查结果并返回true；
+		 * 否则返回false，处理器继续运行，可以再次调用wait_until或wait。
 		 *
-		 * ͬ
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param deadline 等待的截止时间
+		 *
+		 * @return bool 如果所有处理器都已结束，则为true
+		 */
+		template< typename Clock, typename Duration > bool wait_until(const std::chrono::time_point< Clock, Duration >& deadline)
+		{
+			{
+				std::unique_lock< std::mutex > lock(m_runningMx);
+
+				if (!m_runningCv.wait_until(lock, deadline, [this]() { return m_running == 0; }))
+					return false;
+			}
+
+			wait();
+			return true;
+		}
+
+		/**
+		 * 删除队列中还没有开始计算的个体，处理器在完成正在进行的计算之后结束。
+		 *
+		 * 被删除的个体没有代价。正在进行的计算可以用wait或wait_until等待完成（drain），
+		 * 也可以不等待（abandon），此时线程在下一次start或处理器集合析构时被等待。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t 被删除的个体数
+		 */
+		size_t cancel()
+		{
+			return m_indQueue.clear();
+		}
+
+		/**
+		 * 再返回之前等待所有处理器结束。
+		 *
+		 * 用于同步处理。
 		 *
 		 * @author louiehan (11/15/2019)
 		 */
 		void wait()
 		{
-			m_threads->join_all();
+			if (m_threads)
+				m_threads->join_all();
+
+			if (m_measure)
+				measure_barrier();
 
 			if (!m_indQueue.empty())
 				throw processors_exception("threads ended before emptying the queue");
 
 			if (!success())
 				throw processors_exception("objective function error");
+
+			if (m_tuning)
+				tune(m_items);
 		}
 
 		/**
-		 * ָʾдǷɹ
+		 * 指示所有处理器是否成功结束。
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -498,7 +1038,7 @@ namespace de
 		 */
 		bool success()
 		{
-			for (typename processor_vector::size_type n = 0; n < m_processors.size(); ++n)
+			for (typename processor_vector::size_type n = 0; n < m_started; ++n)
 			{
 				processor_ptr processor(m_processors[n]);
 				if (!processor->success())
@@ -509,7 +1049,7 @@ namespace de
 		}
 
 		/**
-		 * Ⱥеи봦С
+		 * 将群体中的所有个体推入处理队列。
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -517,16 +1057,162 @@ namespace de
 		 */
 		void push(population_ptr population)
 		{
-			std::copy(population->begin(), population->end(), std::back_inserter(m_indQueue));
+			push(*population);
+		}
+
+		/**
+		 * 将群体中的所有个体推入处理队列。有NUMA放置时种群被分成连续的分区，每个分区放入
+		 * 一个有处理器线程的节点的队列，见numa_placement::item_node。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop
+		 */
+		void push(const population& pop)
+		{
+			if (m_model)
+			{
+				// 按预测的耗时从长到短，耗时相同的保持原来的顺序；分区轮流放入，每个分区也是从长到短
+				std::vector< DVectorPtr > vars(pop.size());
+				for (population::size_type i = 0; i < pop.size(); ++i)
+					vars[i] = pop[i]->vars();
+
+				std::vector< double > costs;
+				m_model->predict(vars, costs);
+
+				std::vector< std::pair< double, population::size_type > > order;
+				order.reserve(pop.size());
+
+				for (population::size_type i = 0; i < pop.size(); ++i)
+					order.push_back(std::make_pair(-costs[i], i));
+
+				std::stable_sort(order.begin(), order.end(), [](const std::pair< double, population::size_type >& a, const std::pair< double, population::size_type >& b) { return a.first < b.first; });
+
+				const size_t partitions(active_partitions());
+				for (size_t n = 0; n < order.size(); ++n)
+					m_indQueue.push(pop[order[n].second], n % partitions);
+			}
+			else
+			{
+				const size_t partitions(active_partitions());
+				for (population::size_type i = 0; i < pop.size(); ++i)
+					m_indQueue.push(pop[i], m_placement ? m_placement->item_node(i, pop.size(), partitions) : 0);
+			}
+
+			m_pushed += pop.size();
 		}
 
 		/**
-		 * ָϵָ롣
+		 * 设置耗时模型：push(pop)按预测的耗时从长到短的顺序放入队列，使耗时长的个体先开始，
+		 * 减少一代结束时其他线程等待最后几个个体的时间。处理器把每次计算的耗时报告给模型，可以在线学习
+		 * （nearest_neighbor_cost_model），也可以由用户提供（function_cost_model）。
+		 * 有耗时模型时处理器每次从队列中取出一个个体，set_batch和自动选择的批大小不起作用。
+		 * null恢复按索引的顺序。只在处理器没有运行时调用。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param model 耗时模型
+		 */
+		void set_cost_model(cost_model_ptr model)
+		{
+			m_model = model;
+
+			for (typename processor_vector::size_type n = 0; n < m_processors.size(); ++n)
+				m_processors[n]->set_cost_model(model);
+		}
+
+		/**
+		 * 返回耗时模型，没有时为null
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return cost_model_ptr
+		 */
+		cost_model_ptr model() const { return m_model; }
+
+		/**
+		 * 返回使用处理器线程的各次计算在屏障处的空闲统计，内联计算不统计
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return const barrier_statistics&
+		 */
+		const barrier_statistics& barrier() const { return m_barrier; }
+
+		/**
+		 * 清除屏障的空闲统计
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void reset_barrier() { m_barrier = barrier_statistics(); }
+
+		/**
+		 * 指向处理器集合的智能指针。
 		 */
 		typedef std::shared_ptr< processors< T > > processors_ptr;
 
+	private:
+		// 创建处理器直到有count个；NUMA节点交错分配，与count无关
+		void grow(size_t count)
+		{
+			for (size_t n = m_processors.size(); n < count; ++n)
+			{
+				const size_t node(m_placement ? m_placement->worker_node(n) : 0);
+				processor_ptr processor(std::make_shared< processor< T > >(n, m_of, std::ref(m_indQueue), m_listener, m_placement, node));
+				processor->set_cost_model(m_model);
+				m_processors.push_back(processors< T >::processor_ptr(processor));
+			}
+		}
+
+		// 下一次计算中有处理器线程的分区数：start()启动前min(workers, size())个处理器，内联计算只使用第一个
+		size_t active_partitions() const
+		{
+			return m_placement ? m_placement->active_nodes(std::min(m_workers, m_limit)) : 1;
+		}
+
+		// 累计这次计算中每个线程从结束到最后一个线程结束的时间
+		void measure_barrier()
+		{
+			m_measure = false;
+
+			std::chrono::steady_clock::time_point last(m_startTime);
+			for (typename processor_vector::size_type n = 0; n < m_started; ++n)
+				last = std::max(last, m_processors[n]->finished());
+
+			for (typename processor_vector::size_type n = 0; n < m_started; ++n)
+				m_barrier.idleSeconds += std::chrono::duration< double >(last - std::max(m_startTime, m_processors[n]->finished())).count();
+
+			m_barrier.workerSeconds += m_started * std::chrono::duration< double >(last - m_startTime).count();
+			++m_barrier.generations;
+		}
+
+		// 把这次计算的测量结果报告给自动选择策略，到期时应用新的线程数和批大小
+		void tune(size_t items)
+		{
+			size_t evaluations(0);
+			double busy(0);
+
+			for (typename processor_vector::size_type n = 0; n < m_started; ++n)
+			{
+				size_t count(0);
+				busy += m_processors[n]->take_busy(count);
+				evaluations += count;
+			}
+
+			m_tuning->observe(evaluations, busy);
+
+			if (m_tuning->due())
+			{
+				m_tuning->tune(items);
+				set_workers(m_tuning->workers());
+				set_batch(m_tuning->batch());
+			}
+		}
+
 	};
 
+	template< typename T > const size_t processors< T >::auto_workers;
+
 }
 
 #endif //DE_PROCESSORS_HPP_INCLUDED
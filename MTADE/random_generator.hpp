@@ -14,12 +14,44 @@
 namespace de
 {
 
+	/**
+	 * 随机数引擎的类型
+	 */
+	typedef std::mt19937 random_engine;
+
+	/**
+	 * 返回当前线程的随机数引擎。
+	 *
+	 * 每个线程有独立的引擎（随机数流），因此在不同线程中同时运行的多个差分进化实例
+	 * 不会相互干扰，只要在运行之前用seed_generator设定各自的种子，结果就是可重现的。
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @return random_engine&
+	 */
+	inline random_engine& generator()
+	{
+		static thread_local random_engine gen;
+		return gen;
+	}
+
+	/**
+	 * 设定当前线程的随机数引擎的种子
+	 *
+	 * @author louiehan (10/19/2026)
+	 *
+	 * @param seed 种子
+	 */
+	inline void seed_generator(unsigned long seed)
+	{
+		generator().seed(static_cast< random_engine::result_type >(seed));
+	}
+
 	inline double genrand(double min = 0, double max = 1)
 	{
-		static std::mt19937 gen;
 		std::uniform_real_distribution<> dist(min, max);
 
-		return dist(gen);
+		return dist(generator());
 	}
 
 	inline int genintrand(double min, double max, bool upperexclusive = false)
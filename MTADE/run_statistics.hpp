@@ -0,0 +1,374 @@
+#ifndef DE_RUN_STATISTICS_HPP_INCLUDED
+#define DE_RUN_STATISTICS_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include "population.hpp"
+#include "selection_strategy.hpp"
+
+namespace de
+{
+
+	/**
+	 * 优化过程的运行统计：代数、目标函数计算次数、最佳个体、当前种群代价的范围和运行时间。
+	 *
+	 * 统计值由差分进化在运行过程中增量维护：种群代价的范围来自选择策略报告的下一代个体
+	 * （selection_listener::survived），不需要另外扫描种群。终止策略根据这些统计值决定是否停止。
+	 *
+	 * 该对象同时是选择监听器，比较结果会转发给构造时指定的下一个监听器（例如自适应的变异策略）。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class run_statistics : public selection_listener
+	{
+	private:
+		typedef std::chrono::steady_clock clock_type;
+
+		selection_listener_ptr m_next;
+		bool m_minimize;
+
+		size_t m_generation;
+		size_t m_evaluations;
+		size_t m_cutoffs;
+		size_t m_censored;
+		size_t m_popSize;
+		individual_ptr m_best;
+
+		double m_minCost;
+		double m_maxCost;
+
+		size_t m_finite;
+
+		size_t m_survivors;
+		size_t m_nextFinite;
+		double m_nextMinCost;
+		double m_nextMaxCost;
+
+		clock_type::time_point m_start;
+		size_t m_startGeneration;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param minimize 如果为true，代价越小越好，否则代价越大越好
+		 * @param next 转发比较结果的选择监听器，可以为空
+		 */
+		run_statistics(bool minimize, selection_listener_ptr next = selection_listener_ptr())
+			: m_next(next), m_minimize(minimize), m_generation(0), m_evaluations(0), m_cutoffs(0), m_censored(0), m_popSize(0),
+			m_minCost(0), m_maxCost(0), m_finite(0), m_survivors(0), m_nextFinite(0), m_nextMinCost(0), m_nextMaxCost(0), m_start(clock_type::now()), m_startGeneration(0)
+		{
+		}
+
+		/**
+		 * 用已经计算过的初始种群初始化统计值
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 初始种群
+		 * @param best 初始种群中最好的个体
+		 */
+		void init(const population& pop, individual_ptr best)
+		{
+			init(pop, best, pop.size());
+		}
+
+		/**
+		 * 用已经计算过的初始种群初始化统计值，初始种群中只有一部分个体计算了目标函数（见feasibility_rule）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param pop 初始种群
+		 * @param best 初始种群中最好的个体
+		 * @param evaluations 初始种群的计算次数
+		 */
+		void init(const population& pop, individual_ptr best, size_t evaluations)
+		{
+			assert(!pop.empty());
+
+			m_generation = 0;
+			m_startGeneration = 0;
+			m_evaluations = evaluations;
+			m_cutoffs = 0;
+			m_censored = 0;
+			m_popSize = pop.size();
+			m_best = best;
+
+			m_minCost = std::numeric_limits< double >::max();
+			m_maxCost = -std::numeric_limits< double >::max();
+			m_finite = 0;
+
+			for (population::size_type i = 0; i < pop.size(); ++i)
+			{
+				if (!std::isfinite(pop[i]->cost()))
+					continue;
+
+				m_minCost = std::min(m_minCost, pop[i]->cost());
+				m_maxCost = std::max(m_maxCost, pop[i]->cost());
+				++m_finite;
+			}
+		}
+
+		/**
+		 * 开始计时并记录开始的代，在优化过程（每次run_until）开始时调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		void start()
+		{
+			m_start = clock_type::now();
+			m_startGeneration = m_generation;
+		}
+
+		/**
+		 * 在一代结束时调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param evaluations 这一代的计算次数
+		 * @param best 到目前为止最好的个体
+		 * @param cutoffs 其中有截断代价的计算次数（见evaluation_context）
+		 * @param censored 其中提前放弃的计算次数
+		 */
+		void end_generation(size_t evaluations, individual_ptr best, size_t cutoffs = 0, size_t censored = 0)
+		{
+			assert(censored <= cutoffs && cutoffs <= evaluations);
+
+			++m_generation;
+			m_evaluations += evaluations;
+			m_cutoffs += cutoffs;
+			m_censored += censored;
+			m_best = best;
+		}
+
+		/**
+		 * 种群缩小之后调用。被删除的个体不再计入，代价的范围在下一次选择之后更新，
+		 * 在此之前范围可能偏大。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param popSize 新的种群规模
+		 */
+		void resize(size_t popSize)
+		{
+			m_popSize = popSize;
+		}
+
+		virtual void selected(size_t i, individual_ptr parent, individual_ptr trial, bool won)
+		{
+			if (m_next)
+				m_next->selected(i, parent, trial, won);
+		}
+
+		virtual void survived(individual_ptr ind)
+		{
+			assert(ind);
+
+			// 被可行性规则拒绝的个体的代价是无穷大，不计入代价的范围
+			if (std::isfinite(ind->cost()))
+			{
+				if (m_nextFinite == 0)
+				{
+					m_nextMinCost = ind->cost();
+					m_nextMaxCost = ind->cost();
+				}
+				else
+				{
+					m_nextMinCost = std::min(m_nextMinCost, ind->cost());
+					m_nextMaxCost = std::max(m_nextMaxCost, ind->cost());
+				}
+
+				++m_nextFinite;
+			}
+
+			++m_survivors;
+
+			if (m_next)
+				m_next->survived(ind);
+		}
+
+		virtual void end_selection()
+		{
+			if (m_survivors > 0)
+			{
+				m_minCost = m_nextMinCost;
+				m_maxCost = m_nextMaxCost;
+				m_finite = m_nextFinite;
+				m_popSize = m_survivors;
+				m_survivors = 0;
+				m_nextFinite = 0;
+			}
+
+			if (m_next)
+				m_next->end_selection();
+		}
+
+		/**
+		 * 如果为true，代价越小越好，否则代价越大越好
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool minimize() const { return m_minimize; }
+
+		/**
+		 * 返回已经完成的代数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t generation() const { return m_generation; }
+
+		/**
+		 * 返回这次优化过程（上次调用start()）开始以来完成的代数；generation()是从初始种群开始的总代数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t run_generations() const { return m_generation - m_startGeneration; }
+
+		/**
+		 * 返回目标函数的计算次数，包括初始种群
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t evaluations() const { return m_evaluations; }
+
+		/**
+		 * 返回有截断代价的计算次数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t cutoff_evaluations() const { return m_cutoffs; }
+
+		/**
+		 * 返回提前放弃（代价被截断）的计算次数。被截断的代价不计入种群代价的范围，因为这些试验个体总是落败
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t censored() const { return m_censored; }
+
+		/**
+		 * 返回有截断代价的计算中提前放弃的比例，没有这样的计算时为0
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double censored_rate() const { return m_cutoffs > 0 ? double(m_censored) / m_cutoffs : 0.0; }
+
+		/**
+		 * 返回当前的种群规模
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t population_size() const { return m_popSize; }
+
+		/**
+		 * 返回到目前为止最好的个体
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return individual_ptr
+		 */
+		individual_ptr best() const { return m_best; }
+
+		/**
+		 * 返回到目前为止最好的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double best_cost() const { assert(m_best); return m_best->cost(); }
+
+		/**
+		 * 返回当前种群中最小的代价。代价的范围只包括有限的代价，被可行性规则拒绝（代价为无穷大）的个体不计入；
+		 * 没有有限的代价时min_cost和max_cost没有意义
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double min_cost() const { return m_minCost; }
+
+		/**
+		 * 返回当前种群中最大的代价
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double max_cost() const { return m_maxCost; }
+
+		/**
+		 * 返回当前种群代价的范围（最大代价 - 最小代价），只包括有限的代价；没有有限的代价时为正无穷大
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double spread() const { return m_finite > 0 ? m_maxCost - m_minCost : std::numeric_limits< double >::infinity(); }
+
+		/**
+		 * 返回从优化过程开始到现在的时间（秒）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double elapsed() const { return std::chrono::duration< double >(clock_type::now() - m_start).count(); }
+	};
+
+	/**
+	 * A smart pointer to run statistics
+	 */
+	typedef std::shared_ptr< run_statistics > run_statistics_ptr;
+
+	/**
+	 * 需要读取运行统计的侦听器（例如按实际的计算次数记录的target_listener）实现的接口：
+	 * 侦听器派生自它时，差分进化在构造时把自己的运行统计交给侦听器。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class statistics_listener
+	{
+	public:
+		virtual ~statistics_listener() {}
+
+		/**
+		 * 接收差分进化的运行统计，它在每一代结束、调用endGeneration之前更新
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param stats 运行统计
+		 */
+		virtual void attach(run_statistics_ptr stats) = 0;
+	};
+
+}
+
+#endif //DE_RUN_STATISTICS_HPP_INCLUDED
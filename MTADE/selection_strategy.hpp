@@ -13,9 +13,57 @@ namespace de
 {
 
 	/**
-	 * ѡԽӿڵĳࡣ
+	 * 选择监听器，选择策略通过它报告每个试验个体与其父个体（同一索引的旧个体）比较的结果。
 	 *
-	 * ֽʹѡȷѸ塣
+	 * 自适应的变异策略（如shade_mutation_strategy）根据这些结果调整参数。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class selection_listener
+	{
+	public:
+		virtual ~selection_listener() {}
+
+		/**
+		 * 报告一个试验个体的比较结果
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param i 个体的索引
+		 * @param parent 父个体
+		 * @param trial 试验个体
+		 * @param won 如果试验个体不比父个体差，则为true
+		 */
+		virtual void selected(size_t i, individual_ptr parent, individual_ptr trial, bool won) = 0;
+
+		/**
+		 * 报告进入下一代的一个个体，每次选择对下一代的每个个体调用一次。缺省不做任何事情。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param ind 进入下一代的个体
+		 */
+		virtual void survived(individual_ptr ind)
+		{
+		}
+
+		/**
+		 * 在一次选择的所有结果报告完毕之后调用
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		virtual void end_selection() = 0;
+	};
+
+	/**
+	 * 指向选择监听器的智能指针
+	 */
+	typedef std::shared_ptr< selection_listener > selection_listener_ptr;
+
+	/**
+	 * 定义选择策略接口的抽象基类。
+	 *
+	 * 差分进化使用选择策略来确定最佳个体。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -25,7 +73,7 @@ namespace de
 		virtual ~selection_strategy() {}
 
 		/**
-		 * زapplies the selection strategy
+		 * 重载操作符（）applies the selection strategy
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -35,8 +83,19 @@ namespace de
 		 *  			  the best individual on return
 		 * @param minimize if true, it will minimize, if false it will
 		 *  			   maximize
+		 * @param listener 可选的选择监听器，接收每个试验个体的比较结果
 		 */
-		virtual void operator()(population_ptr& pop1, population_ptr& pop2, individual_ptr& bestInd, bool minimize) = 0;
+		virtual void operator()(population_ptr& pop1, population_ptr& pop2, individual_ptr& bestInd, bool minimize, selection_listener_ptr listener = selection_listener_ptr()) = 0;
+
+		/**
+		 * 选择策略是否是一对一的：试验个体只与同一索引的父个体比较。一对一的选择策略让差分进化把父个体的代价
+		 * 作为试验个体的截断代价（见evaluation_context），并且必须让代价被截断的试验个体落败。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		virtual bool one_to_one() const { return false; }
 	};
 
 	/**
@@ -45,7 +104,7 @@ namespace de
 	typedef std::shared_ptr< selection_strategy > selection_strategy_ptr;
 
 	/**
-	 * ѡԸÿĴۺĽĿ꺯С󻯣
+	 * 选择策略根据每个个体的代价和期望的结果（即目标函数的最小化或最大化）对两代个体进行排序。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -53,7 +112,7 @@ namespace de
 	{
 	public:
 		/**
-		 * ز() applies the selection strategy
+		 * 重载操作符() applies the selection strategy
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -63,16 +122,32 @@ namespace de
 		 *  			  the best individual on return
 		 * @param minimize if true, it will minimize, if false it will
 		 *  			   maximize
+		 * @param listener 可选的选择监听器，接收每个试验个体的比较结果
 		 */
-		void operator()(population_ptr& pop1, population_ptr& pop2, individual_ptr& bestInd, bool minimize)
+		void operator()(population_ptr& pop1, population_ptr& pop2, individual_ptr& bestInd, bool minimize, selection_listener_ptr listener = selection_listener_ptr())
 		{
 			assert(pop1);
 			assert(pop2);
 
 			assert(pop1->size() == pop2->size());
 
+			// 排序会打乱索引，因此在排序之前报告同一索引的比较结果
+			if (listener)
+			{
+				for (size_t i = 0; i < pop1->size(); ++i)
+					listener->selected(i, (*pop1)[i], (*pop2)[i], (*pop2)[i]->better_or_equal((*pop1)[i], minimize));
+			}
+
 			sort_across(*pop1, *pop2, minimize);
 
+			if (listener)
+			{
+				for (size_t i = 0; i < pop1->size(); ++i)
+					listener->survived((*pop1)[i]);
+
+				listener->end_selection();
+			}
+
 			// this is the best
 			bestInd = (*pop1)[0];
 		}
@@ -111,7 +186,7 @@ namespace de
 	};
 
 	/**
-	 * ѡԱȽͬһӦĸ壬ѡһѸ塣
+	 * 选择策略比较两代与同一索引相对应的个体，并选择下一代的最佳个体。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -119,7 +194,7 @@ namespace de
 	{
 	public:
 		/**
-		 * ز applies the selection strategy
+		 * 重载操作符（） applies the selection strategy
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
@@ -129,8 +204,9 @@ namespace de
 		 *  			  the best individual on return
 		 * @param minimize if true, it will minimize, if false it will
 		 *  			   maximize
+		 * @param listener 可选的选择监听器，接收每个试验个体的比较结果
 		 */
-		void operator()(population_ptr& pop1, population_ptr& pop2, individual_ptr& bestInd, bool minimize)
+		void operator()(population_ptr& pop1, population_ptr& pop2, individual_ptr& bestInd, bool minimize, selection_listener_ptr listener = selection_listener_ptr())
 		{
 			assert(pop1);
 			assert(pop2);
@@ -140,8 +216,13 @@ namespace de
 			for (size_t i = 0; i < pop1->size(); ++i)
 			{
 				individual_ptr crt((*pop2)[i]);
+				// 代价被截断的试验个体已经确定差于父个体，它的代价只是一个界
+				const bool won(!crt->censored() && crt->better_or_equal((*pop1)[i], minimize));
+
+				if (listener)
+					listener->selected(i, (*pop1)[i], crt, won);
 
-				if (crt->better_or_equal((*pop1)[i], minimize))
+				if (won)
 				{
 					if (crt->better_or_equal(bestInd, minimize))
 						bestInd = crt;
@@ -149,10 +230,18 @@ namespace de
 				else
 					(*pop2)[i] = (*pop1)[i];
 
+				if (listener)
+					listener->survived((*pop2)[i]);
+
 			}
 
+			if (listener)
+				listener->end_selection();
+
 			std::swap(pop1, pop2);
 		}
+
+		virtual bool one_to_one() const { return true; }
 	};
 
 }
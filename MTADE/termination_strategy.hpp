@@ -7,15 +7,22 @@
 #pragma once
 #endif
 
+#include <vector>
+
+#include "run_statistics.hpp"
+
 namespace de
 {
 
 	/**
-	 * ˾սʹõĽӿڵĳࡣ
+	 * 定义了具体终结策略类所使用的接口的抽象基类。
+	 *
+	 * 终止策略定义了用于停止优化过程的逻辑。 可以很简单，例如达到
+	 * 最大进化代数时退出的进化代数计数器，也可以实现更复杂的算法，如
+	 * 通过确定何时达到合理的最佳值来尝试最小化执行步骤的数量。
 	 *
-	 * ֹԶֹͣŻ̵߼ Ժܼ򵥣ﵽ
-	 * ʱ˳ĽҲʵָӵ㷨
-	 * ͨȷʱﵽֵСִв
+	 * 差分进化在每一代之前调用event(const run_statistics&)，它的缺省实现调用只使用最优个体和
+	 * 进化代数的event(best, genCount)；派生类重载其中之一即可。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -25,17 +32,35 @@ namespace de
 		virtual ~termination_strategy() {}
 
 		/**
-		 * Żֹж¼
+		 * 优化进程终止判定事件
 		 *
 		 * @author louiehan (11/15/2019)
 		 *
-		 * @param best ǰŸ
-		 * @param genCount 
+		 * @param best 当前最优个体
+		 * @param genCount 这次运行（run_until）开始以来的进化代数
 		 *
 		 * @return bool return true to continue, or false to stop the
 		 *  	   optimization process
 		 */
-		virtual bool event(individual_ptr best, size_t genCount) = 0;
+		virtual bool event(individual_ptr best, size_t genCount)
+		{
+			return true;
+		}
+
+		/**
+		 * 根据运行统计判定是否终止优化进程
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param stats 差分进化增量维护的运行统计
+		 *
+		 * @return bool return true to continue, or false to stop the
+		 *  	   optimization process
+		 */
+		virtual bool event(const run_statistics& stats)
+		{
+			return event(stats.best(), stats.run_generations());
+		}
 	};
 
 	/**
@@ -44,7 +69,9 @@ namespace de
 	typedef std::shared_ptr< termination_strategy > termination_strategy_ptr;
 
 	/**
-	 * ֹԵĻʵ֣ѽֹͣŻ
+	 * 终止策略的基本实现：如果已进化到最大代数，则停止优化过程
+	 *
+	 * 代数从每次run_until开始时计算，提前停止之后再次运行时重新得到maxGen代。
 	 *
 	 * @author louiehan (11/15/2019)
 	 */
@@ -66,12 +93,272 @@ namespace de
 		{
 		}
 
+		using termination_strategy::event;
+
 		virtual bool event(individual_ptr best, size_t genCount)
 		{
 			return genCount < m_maxGen;
 		}
 	};
 
+	/**
+	 * 最优代价达到目标（最小化时小于或等于目标，最大化时大于或等于目标）时停止优化过程
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class target_termination_strategy : public termination_strategy
+	{
+	private:
+		const double m_target;
+
+	public:
+		/**
+		 * constructs a target_termination_strategy object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param target 目标代价
+		 */
+		target_termination_strategy(double target)
+			: m_target(target)
+		{
+		}
+
+		using termination_strategy::event;
+
+		virtual bool event(const run_statistics& stats)
+		{
+			return stats.minimize() ? stats.best_cost() > m_target : stats.best_cost() < m_target;
+		}
+	};
+
+	/**
+	 * 停滞时停止优化过程：连续maxGen代最优代价的改进都不超过epsilon
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class stagnation_termination_strategy : public termination_strategy
+	{
+	private:
+		const size_t m_maxGen;
+		const double m_epsilon;
+
+		double m_reference;
+		size_t m_referenceGen;
+		bool m_started;
+
+	public:
+		/**
+		 * constructs a stagnation_termination_strategy object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param maxGen 允许没有改进的最大代数
+		 * @param epsilon 最优代价的改进超过此值才算作改进
+		 */
+		stagnation_termination_strategy(size_t maxGen, double epsilon)
+			: m_maxGen(maxGen), m_epsilon(epsilon), m_reference(0), m_referenceGen(0), m_started(false)
+		{
+		}
+
+		using termination_strategy::event;
+
+		virtual bool event(const run_statistics& stats)
+		{
+			const double cost(stats.best_cost());
+			const double improvement(stats.minimize() ? m_reference - cost : cost - m_reference);
+
+			if (!m_started || stats.generation() < m_referenceGen || improvement > m_epsilon)
+			{
+				// 第一次调用或者重新开始运行时也以当前代为参照
+				m_reference = cost;
+				m_referenceGen = stats.generation();
+				m_started = true;
+			}
+
+			return stats.generation() - m_referenceGen < m_maxGen;
+		}
+	};
+
+	/**
+	 * 当前种群代价的范围（最大代价 - 最小代价）小于容差时停止优化过程
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class spread_termination_strategy : public termination_strategy
+	{
+	private:
+		const double m_tolerance;
+
+	public:
+		/**
+		 * constructs a spread_termination_strategy object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param tolerance 代价范围的容差
+		 */
+		spread_termination_strategy(double tolerance)
+			: m_tolerance(tolerance)
+		{
+		}
+
+		using termination_strategy::event;
+
+		virtual bool event(const run_statistics& stats)
+		{
+			return stats.spread() >= m_tolerance;
+		}
+	};
+
+	/**
+	 * 目标函数的计算次数达到上限时停止优化过程。
+	 *
+	 * 每一代计算整个种群，因此实际的计算次数最多比上限多出种群规模减一次。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class max_evaluations_termination_strategy : public termination_strategy
+	{
+	private:
+		const size_t m_maxEvaluations;
+
+	public:
+		/**
+		 * constructs a max_evaluations_termination_strategy object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param maxEvaluations 目标函数计算次数的上限，包括初始种群
+		 */
+		max_evaluations_termination_strategy(size_t maxEvaluations)
+			: m_maxEvaluations(maxEvaluations)
+		{
+		}
+
+		using termination_strategy::event;
+
+		virtual bool event(const run_statistics& stats)
+		{
+			return stats.evaluations() < m_maxEvaluations;
+		}
+	};
+
+	/**
+	 * 运行时间达到上限时停止优化过程。只在两代之间检查，正在进行的一代会先完成。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class time_termination_strategy : public termination_strategy
+	{
+	private:
+		const double m_seconds;
+
+	public:
+		/**
+		 * constructs a time_termination_strategy object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param seconds 运行时间的上限（秒）
+		 */
+		time_termination_strategy(double seconds)
+			: m_seconds(seconds)
+		{
+		}
+
+		using termination_strategy::event;
+
+		virtual bool event(const run_statistics& stats)
+		{
+			return stats.elapsed() < m_seconds;
+		}
+	};
+
+	/**
+	 * 组合终止策略：所有的子策略都要求停止时（AND）才停止优化过程
+	 *
+	 * 每次都调用所有的子策略，使有状态的子策略（如停滞）能看到每一代。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class and_termination_strategy : public termination_strategy
+	{
+	private:
+		const std::vector< termination_strategy_ptr > m_strategies;
+
+	public:
+		/**
+		 * constructs an and_termination_strategy object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param strategies 子策略
+		 */
+		and_termination_strategy(const std::vector< termination_strategy_ptr >& strategies)
+			: m_strategies(strategies)
+		{
+			assert(!strategies.empty());
+		}
+
+		using termination_strategy::event;
+
+		virtual bool event(const run_statistics& stats)
+		{
+			bool cont(false);
+
+			for (size_t n = 0; n < m_strategies.size(); ++n)
+			{
+				if (m_strategies[n]->event(stats))
+					cont = true;
+			}
+
+			return cont;
+		}
+	};
+
+	/**
+	 * 组合终止策略：任何一个子策略要求停止时（OR）就停止优化过程
+	 *
+	 * 每次都调用所有的子策略，使有状态的子策略（如停滞）能看到每一代。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class or_termination_strategy : public termination_strategy
+	{
+	private:
+		const std::vector< termination_strategy_ptr > m_strategies;
+
+	public:
+		/**
+		 * constructs an or_termination_strategy object
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param strategies 子策略
+		 */
+		or_termination_strategy(const std::vector< termination_strategy_ptr >& strategies)
+			: m_strategies(strategies)
+		{
+			assert(!strategies.empty());
+		}
+
+		using termination_strategy::event;
+
+		virtual bool event(const run_statistics& stats)
+		{
+			bool cont(true);
+
+			for (size_t n = 0; n < m_strategies.size(); ++n)
+			{
+				if (!m_strategies[n]->event(stats))
+					cont = false;
+			}
+
+			return cont;
+		}
+	};
+
 }
 
 #endif //DE_TERMINATION_STRATEGY_HPP_INCLUDED
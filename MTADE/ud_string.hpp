@@ -11,7 +11,7 @@
 
 namespace udstr {
 	/**
-	* ʹʽԶָʽַиȥַ
+	* 使用正则表达式对多种格式的字符串进行切割，去除多余的字符
 	*
 	* @author louiehan (11/15/2019)
 	*
@@ -30,7 +30,7 @@ namespace udstr {
 	}
 
 	/**
-	* ʹstlģ庯ʵַдת
+	* 使用stl模板函数实现字符串大写转化
 	*
 	* @author louiehan (11/15/2019)
 	*
@@ -47,7 +47,7 @@ namespace udstr {
 	}
 
 	/**
-	* ʹstlģ庯ʵַСдת
+	* 使用stl模板函数实现字符串小写转化
 	*
 	* @author louiehan (11/15/2019)
 	*
@@ -58,10 +58,10 @@ namespace udstr {
 		typename AL = std::allocator<E>>
 		inline std::basic_string<E, TR, AL> tolower(const std::basic_string<E, TR, AL>&src) {
 		auto dst = src;
-		// ʹõǰlocale
+		// 使用当前的locale设置
 		static const std::locale loc("");
-		// lambdaʽַÿַԪתΪСд
-		// std::stringԪΪchar,std::wstringԪΪwchar_t
+		// lambda表达式负责将字符串的每个字符元素转换为小写
+		// std::string的元素类型为char,std::wstring的元素类型为wchar_t
 		transform(src.begin(), src.end(), dst.begin(), [&](E c)->E {return std::tolower(c, loc); });
 		return dst;
 	}
@@ -0,0 +1,230 @@
+#ifndef DE_WORKER_TUNING_HPP_INCLUDED
+#define DE_WORKER_TUNING_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace de
+{
+
+	/**
+	 * 根据测得的目标函数耗时选择处理器线程数和每次从队列中取出的个体数（批大小）。
+	 *
+	 * 处理器集合每次计算结束后报告计算次数和处理器线程用于计算的总时间，由此估计每次计算的耗时c。
+	 * 第一次计算（初始种群）之后和此后每interval次计算之后重新选择：w个线程计算n个个体的时间估计为
+	 * w * o + ceil(n / w) * c，其中o是创建并等待一个线程的开销；在调用线程中串行计算（内联）的时间为n * c，
+	 * 没有线程同步。取时间最短的一种；内联计算不能被截止时间或停止请求中断，只在n * c不超过inlineLimit时使用。
+	 *
+	 * 批大小使每次取出的个体的计算时间至少为grain，以分摊队列的同步开销，但每个线程至少取4次，以保持负载均衡；
+	 * 内联计算时一次取出所有个体。
+	 *
+	 * @author louiehan (10/19/2026)
+	 */
+	class worker_tuning
+	{
+	private:
+		size_t m_maxWorkers;
+		const size_t m_interval;
+		const double m_grain;
+		const double m_inlineLimit;
+
+		double m_threadCost;
+		double m_cost;
+
+		size_t m_rounds;
+		size_t m_evaluations;
+		double m_busy;
+
+		size_t m_workers;
+		size_t m_batch;
+
+	public:
+		/**
+		 * 构造函数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param maxWorkers 最多的处理器线程数，至少为1
+		 * @param interval 重新选择的间隔（计算次数）
+		 * @param grain 每批个体的最短计算时间（秒）
+		 * @param inlineLimit 内联计算一次的最长时间（秒）
+		 */
+		explicit worker_tuning(size_t maxWorkers, size_t interval = 20, double grain = 50e-6, double inlineLimit = 1e-3)
+			: m_maxWorkers(maxWorkers), m_interval(std::max< size_t >(1, interval)), m_grain(grain), m_inlineLimit(inlineLimit),
+			m_threadCost(-1), m_cost(0), m_rounds(0), m_evaluations(0), m_busy(0), m_workers(maxWorkers), m_batch(1)
+		{
+			assert(maxWorkers > 0);
+		}
+
+		/**
+		 * 报告一次计算的结果
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param evaluations 计算次数
+		 * @param busy 处理器线程用于计算的总时间（秒）
+		 */
+		void observe(size_t evaluations, double busy)
+		{
+			++m_rounds;
+			m_evaluations += evaluations;
+			m_busy += busy;
+		}
+
+		/**
+		 * 是否应该重新选择：第一次计算之后，以及此后每interval次计算之后
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return bool
+		 */
+		bool due() const { return m_evaluations > 0 && (m_cost == 0 || m_rounds >= m_interval); }
+
+		/**
+		 * 根据上次选择以来的测量结果重新选择线程数和批大小
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param items 每次计算的个体数
+		 */
+		void tune(size_t items)
+		{
+			if (m_evaluations == 0 || items == 0)
+				return;
+
+			if (m_threadCost < 0)
+				m_threadCost = measure_thread_cost();
+
+			m_cost = std::max(m_busy / m_evaluations, 1e-9);
+			m_rounds = 0;
+			m_evaluations = 0;
+			m_busy = 0;
+
+			const double n(static_cast< double >(items));
+
+			size_t best(0);
+			double bestTime(n * m_cost <= m_inlineLimit ? n * m_cost : std::numeric_limits< double >::max());
+
+			for (size_t w = 1; w <= m_maxWorkers; ++w)
+			{
+				const double time(w * m_threadCost + std::ceil(n / w) * m_cost);
+				if (time < bestTime)
+				{
+					best = w;
+					bestTime = time;
+				}
+			}
+
+			m_workers = best;
+
+			// 内联计算时没有负载均衡的问题，一次取出所有个体
+			if (best == 0)
+			{
+				m_batch = items;
+				return;
+			}
+
+			const size_t balanced(std::max< size_t >(1, items / (4 * best)));
+			m_batch = std::min(balanced, static_cast< size_t >(std::ceil(m_grain / m_cost)));
+			m_batch = std::max< size_t >(1, m_batch);
+		}
+
+		/**
+		 * 改变最多的处理器线程数（例如CPU限额改变时），下一次计算之后重新选择
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param maxWorkers 最多的处理器线程数，至少为1
+		 */
+		void set_max_workers(size_t maxWorkers)
+		{
+			assert(maxWorkers > 0);
+
+			m_maxWorkers = maxWorkers;
+			m_workers = std::min(m_workers, maxWorkers);
+			m_cost = 0;
+		}
+
+		/**
+		 * 返回最多的处理器线程数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t max_workers() const { return m_maxWorkers; }
+
+		/**
+		 * 返回选择的处理器线程数，0表示在调用线程中内联计算
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t workers() const { return m_workers; }
+
+		/**
+		 * 返回选择的批大小
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return size_t
+		 */
+		size_t batch() const { return m_batch; }
+
+		/**
+		 * 返回最近一次选择时估计的每次计算的耗时（秒），还没有选择时为0
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double cost() const { return m_cost; }
+
+		/**
+		 * 返回测得的创建并等待一个线程的开销（秒），还没有测量时为负数
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		double thread_cost() const { return m_threadCost; }
+
+		/**
+		 * 测量创建并等待一个线程的平均开销（秒）
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @return double
+		 */
+		static double measure_thread_cost()
+		{
+			const size_t count(16);
+			const std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+
+			for (size_t n = 0; n < count; ++n)
+				std::thread([]() {}).join();
+
+			return std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count() / count;
+		}
+	};
+
+	/**
+	 * A smart pointer to a worker_tuning
+	 */
+	typedef std::shared_ptr< worker_tuning > worker_tuning_ptr;
+
+}
+
+#endif //DE_WORKER_TUNING_HPP_INCLUDED
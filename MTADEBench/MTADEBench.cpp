@@ -0,0 +1,67 @@
+// MTADEBench.cpp : 定义基准测试控制台应用程序的入口点。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <string>
+
+#include "benchmarks.h"
+
+namespace
+{
+	typedef int(*benchmark_entry)(int argc, char* argv[]);
+
+	struct benchmark_info
+	{
+		const char* name;
+		benchmark_entry entry;
+		const char* description;
+	};
+
+	const benchmark_info benchmarks[] =
+	{
+		{ "micro", micro_benchmark, "microbenchmarks of the core components: micro [component] [--min-time seconds]" },
+		{ "scaling", scaling_benchmark, "strong and weak scaling of processors<T>: scaling [--threads N] [--cost us] [--variance v] [--individuals n] [--per-thread n] [--rounds n]" },
+		{ "ert", ert_benchmark, "expected running time to reach cost targets per strategy: ert [--spec file] [--targets t1,t2,...] [--report ert|ecdf] [--points n]" },
+		{ "deadline", deadline_benchmark, "latency overshoot of run_for and stop tokens: deadline [--threads N] [--np n] [--runs n] [--tolerance ms]" },
+		{ "repair", repair_benchmark, "throughput and convergence of the range constraint repair modes: repair [throughput|convergence] [--min-time seconds] [--d n] [--np n] [--generations n] [--runs n]" },
+		{ "policy", policy_benchmark, "overhead of runtime strategies versus compile-time policies: policy [engine|fixed] [--np n] [--generations n] [--min-time seconds]" },
+		{ "mo", multi_objective_benchmark, "non-dominated sorting and multi-objective DE (GDE3): mo [ranking|gde3] [--min-time seconds] [--np n] [--generations n] [--threads N]" },
+		{ "feasibility", feasibility_benchmark, "penalty versus feasibility pre-check for nonlinear constraints: feasibility [--d n] [--np n] [--generations n] [--threads N] [--cost us]" },
+		{ "cutoff", cutoff_benchmark, "early abort of objectives past the parent's cost: cutoff [--points n] [--degree n] [--np n] [--generations n] [--threads N]" },
+		{ "async", async_benchmark, "throughput of blocking versus asynchronous I/O-bound objectives: async [--np n] [--generations n] [--latency us]" },
+		{ "numa", numa_benchmark, "NUMA-aware placement of processor threads and objective data: numa [--nodes n] [--threads N] [--data-mb n] [--np n] [--generations n]" },
+		{ "autotune", autotune_benchmark, "automatic worker count and inline evaluation by measured objective cost: autotune [--threads N] [--np n] [--generations n]" },
+		{ "quota", quota_benchmark, "processor count from the cgroup CPU quota and affinity mask, with throttling counters: quota [--threads N] [--cost us] [--np n] [--generations n]" },
+		{ "ipop", ipop_benchmark, "IPOP restarts versus a single run on rastrigin: ipop [--d n] [--np n] [--evaluations n] [--runs n] [--threads N] [--concurrent n]" },
+		{ "scheduler", scheduler_benchmark, "many jobs with their own pools versus one shared evaluation scheduler: scheduler [--jobs n] [--threads N] [--workers N] [--cost us] [--np n] [--generations n]" },
+		{ "coalesce", coalesce_benchmark, "batch objective calls per individual, per job and coalesced across jobs: coalesce [--jobs n] [--call us] [--item us] [--batch n] [--wait us] [--np n] [--generations n]" },
+		{ "ordering", ordering_benchmark, "index order versus longest-first order from a learned or given cost model: ordering [--threads N] [--cost us] [--ratio r] [--np n] [--generations n]" },
+	};
+
+	void usage()
+	{
+		std::cerr << "usage: MTADEBench <benchmark> [options]" << std::endl;
+
+		for (size_t n = 0; n < sizeof(benchmarks) / sizeof(benchmarks[0]); ++n)
+			std::cerr << "  " << benchmarks[n].description << std::endl;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		usage();
+		return 1;
+	}
+
+	for (size_t n = 0; n < sizeof(benchmarks) / sizeof(benchmarks[0]); ++n)
+	{
+		if (std::string(argv[1]) == benchmarks[n].name)
+			return benchmarks[n].entry(argc, argv);
+	}
+
+	usage();
+	return 1;
+}
@@ -0,0 +1,239 @@
+// async_benchmark.cpp : 异步目标函数的吞吐量测试。
+//
+// 目标函数模拟等待本地模拟器的计算：代价在固定的延迟之后才可用，计算本身几乎不占用CPU。
+// 阻塞的版本在处理器线程中等待（processors< T >，每个进行中的计算占用一个线程）；
+// 异步的版本把计算交给模拟器线程，立即返回async_cost（async_processors< T >，少数执行线程）。
+// 对每种配置运行相同的差分进化，输出每秒的计算次数和平均同时进行的计算个数。
+//
+
+#include "stdafx.h"
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "differential_evolution.hpp"
+#include "async_processors.hpp"
+#include "processor_statistics.hpp"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	double sphere(const DVector& vars)
+	{
+		double sum(0);
+		for (DVector::size_type j = 0; j < vars.size(); ++j)
+			sum += vars[j] * vars[j];
+
+		return sum;
+	}
+
+	/**
+	 * 模拟器：在一个线程中按到期时间完成提交的计算
+	 */
+	class simulator : boost::noncopyable
+	{
+	private:
+		typedef std::chrono::steady_clock clock_type;
+
+		struct job
+		{
+			clock_type::time_point due;
+			async_promise promise;
+			double cost;
+
+			bool operator<(const job& other) const { return due > other.due; }
+		};
+
+		std::priority_queue< job > m_jobs;
+		std::mutex m_mx;
+		std::condition_variable m_cv;
+		bool m_stop;
+		std::thread m_thread;
+
+	public:
+		simulator()
+			: m_stop(false), m_thread([this]() { run(); })
+		{
+		}
+
+		~simulator()
+		{
+			{
+				std::lock_guard< std::mutex > lock(m_mx);
+				m_stop = true;
+			}
+
+			m_cv.notify_all();
+			m_thread.join();
+		}
+
+		async_cost submit(double cost, std::chrono::microseconds latency)
+		{
+			job j = { clock_type::now() + latency, async_promise(), cost };
+			async_cost result(j.promise.get_cost());
+
+			{
+				std::lock_guard< std::mutex > lock(m_mx);
+				m_jobs.push(j);
+			}
+
+			m_cv.notify_all();
+			return result;
+		}
+
+	private:
+		void run()
+		{
+			std::unique_lock< std::mutex > lock(m_mx);
+
+			while (!m_stop)
+			{
+				if (m_jobs.empty())
+				{
+					m_cv.wait(lock);
+					continue;
+				}
+
+				if (clock_type::now() < m_jobs.top().due)
+				{
+					m_cv.wait_until(lock, m_jobs.top().due);
+					continue;
+				}
+
+				job j(m_jobs.top());
+				m_jobs.pop();
+
+				// 完成代价时调用处理器集合的回调，不能持有锁
+				lock.unlock();
+				j.promise.set_cost(j.cost);
+				lock.lock();
+			}
+		}
+	};
+
+	class async_sphere
+	{
+	private:
+		simulator& m_simulator;
+		const std::chrono::microseconds m_latency;
+
+	public:
+		async_sphere(simulator& s, std::chrono::microseconds latency)
+			: m_simulator(s), m_latency(latency)
+		{
+		}
+
+		async_cost operator()(DVectorPtr args) { return m_simulator.submit(sphere(*args), m_latency); }
+	};
+
+	class blocking_sphere
+	{
+	private:
+		const std::chrono::microseconds m_latency;
+
+	public:
+		explicit blocking_sphere(std::chrono::microseconds latency)
+			: m_latency(latency)
+		{
+		}
+
+		double operator()(DVectorPtr args)
+		{
+			std::this_thread::sleep_for(m_latency);
+			return sphere(*args);
+		}
+	};
+
+	typedef std::shared_ptr< blocking_sphere > blocking_sphere_ptr;
+	typedef std::shared_ptr< async_sphere > async_sphere_ptr;
+
+	typedef basic_differential_evolution< blocking_sphere_ptr, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		parallel_evaluator< blocking_sphere_ptr > > blocking_de;
+	typedef basic_differential_evolution< async_sphere_ptr, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		async_evaluator< async_sphere_ptr > > async_de;
+
+	template< typename DE, typename Evaluator > void run(csv_report& report, const std::string& method, const Evaluator& evaluator,
+		processor_statistics_listener_ptr statistics, size_t threads, size_t concurrency, size_t varCount, size_t popSize, size_t generations, size_t latency)
+	{
+		seed_generator(1);
+
+		constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -100.0, 100.0));
+
+		DE de(varCount, popSize, evaluator, constraints, true,
+			max_gen_termination_strategy(generations), tournament_selection_strategy(), mutation_strategy_1(varCount, mutation_strategy_arguments(0.5, 0.9)));
+
+		statistics->reset();
+
+		stopwatch sw;
+		de.run();
+		double seconds(sw.elapsed());
+
+		const size_t evaluations(de.evaluations() - popSize);
+
+		report.row(method, params()("threads", threads)("concurrency", concurrency)("NP", popSize)("generations", generations)("latency_us", latency).str(),
+			evaluations, evaluations / seconds, statistics->total_busy() / seconds, de.best()->cost());
+	}
+
+	void bench_async(csv_report& report, size_t popSize, size_t generations, size_t latency)
+	{
+		const size_t varCount(10);
+		const std::chrono::microseconds l(latency);
+
+		const size_t threadCounts[] = { 1, 4, 16, 64 };
+		for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); ++t)
+		{
+			processor_statistics_listener_ptr statistics(std::make_shared< processor_statistics_listener >(threadCounts[t]));
+			processors< blocking_sphere_ptr >::processors_ptr _processors(std::make_shared< processors< blocking_sphere_ptr > >(threadCounts[t], std::make_shared< blocking_sphere >(l), statistics));
+
+			run< blocking_de >(report, "blocking", parallel_evaluator< blocking_sphere_ptr >(_processors), statistics, threadCounts[t], threadCounts[t], varCount, popSize, generations, latency);
+		}
+
+		simulator s;
+
+		const size_t concurrencies[] = { 1, 16, 64, 256 };
+		for (size_t c = 0; c < sizeof(concurrencies) / sizeof(concurrencies[0]); ++c)
+		{
+			processor_statistics_listener_ptr statistics(std::make_shared< processor_statistics_listener >(concurrencies[c]));
+			async_processors< async_sphere_ptr >::processors_ptr _processors(std::make_shared< async_processors< async_sphere_ptr > >(1, concurrencies[c], std::make_shared< async_sphere >(s, l), statistics));
+
+			run< async_de >(report, "async", async_evaluator< async_sphere_ptr >(_processors), statistics, 1, concurrencies[c], varCount, popSize, generations, latency);
+		}
+	}
+}
+
+int async_benchmark(int argc, char* argv[])
+{
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "256")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "5")));
+	const size_t latency(std::stoul(option(argc, argv, "--latency", "500")));
+
+	try
+	{
+		// evaluations不包括初始种群，mean_in_flight是平均同时进行的计算个数
+		csv_report report(std::cout, "method,params,evaluations,evaluations_per_second,mean_in_flight,best_cost");
+
+		bench_async(report, popSize, generations, latency);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,107 @@
+// autotune_benchmark.cpp : 自动选择处理器线程数和批大小（processors< T >::auto_workers）的测试。
+//
+// 对耗时不同的合成目标函数运行相同的差分进化，比较三种计算方式：
+// serial：serial_evaluator，在调用线程中计算；
+// fixed：固定线程数的处理器集合，每次取一个个体；
+// auto：worker_tuning根据测得的耗时选择线程数（或内联计算）和批大小，运行中定期重新选择。
+// 输出每秒的计算次数，以及auto最后选择的线程数、批大小和估计的每次计算耗时。
+//
+
+#include "stdafx.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "differential_evolution.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	typedef basic_differential_evolution< synthetic_function, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		serial_evaluator< synthetic_function > > serial_de;
+	typedef basic_differential_evolution< synthetic_function, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		parallel_evaluator< synthetic_function > > parallel_de;
+
+	template< typename DE, typename Evaluator > double run(const Evaluator& evaluator, size_t varCount, size_t popSize, size_t generations, size_t& evaluations)
+	{
+		seed_generator(1);
+
+		constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -100.0, 100.0));
+
+		DE de(varCount, popSize, evaluator, constraints, true,
+			max_gen_termination_strategy(generations), tournament_selection_strategy(), mutation_strategy_1(varCount, mutation_strategy_arguments(0.5, 0.9)));
+
+		stopwatch sw;
+		de.run();
+		double seconds(sw.elapsed());
+
+		evaluations = de.evaluations();
+		return seconds;
+	}
+
+	void bench_autotune(csv_report& report, size_t threads, size_t popSize, size_t generations)
+	{
+		const size_t varCount(10);
+		const double costs[] = { 0, 2, 20, 200 };
+
+		for (size_t c = 0; c < sizeof(costs) / sizeof(costs[0]); ++c)
+		{
+			const synthetic_function of(costs[c], 0.5);
+			// 耗时最长的一组减少代数，使运行时间相近
+			const size_t g(costs[c] >= 200 ? std::max< size_t >(1, generations / 20) : generations);
+			const std::string p(params()("cost_us", costs[c])("threads", threads)("NP", popSize)("generations", g).str());
+
+			size_t evaluations(0);
+			double seconds(run< serial_de >(serial_evaluator< synthetic_function >(of), varCount, popSize, g, evaluations));
+			report.row("serial", p, evaluations, evaluations / seconds, 0, 1, "");
+
+			processors< synthetic_function >::processors_ptr fixed(std::make_shared< processors< synthetic_function > >(threads, of, std::make_shared< null_processor_listener >()));
+			seconds = run< parallel_de >(parallel_evaluator< synthetic_function >(fixed), varCount, popSize, g, evaluations);
+			report.row("fixed", p, evaluations, evaluations / seconds, threads, 1, "");
+
+			// 与auto_workers相同，但最多使用threads个线程
+			processors< synthetic_function >::processors_ptr tuned(std::make_shared< processors< synthetic_function > >(threads, of, std::make_shared< null_processor_listener >()));
+			tuned->set_tuning(std::make_shared< worker_tuning >(threads));
+			seconds = run< parallel_de >(parallel_evaluator< synthetic_function >(tuned), varCount, popSize, g, evaluations);
+			report.row("auto", p, evaluations, evaluations / seconds, tuned->workers(), tuned->tuning()->batch(), tuned->tuning()->cost() * 1e6);
+		}
+	}
+}
+
+int autotune_benchmark(int argc, char* argv[])
+{
+	const size_t threads(std::stoul(option(argc, argv, "--threads", std::to_string(std::max< size_t >(1, std::thread::hardware_concurrency())))));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "64")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "400")));
+
+	try
+	{
+		// 在计时之前标定合成负载
+		synthetic_function::iterations_per_microsecond();
+
+		// workers为0表示内联计算；estimated_cost_us只对auto有意义
+		csv_report report(std::cout, "method,params,evaluations,evaluations_per_second,workers,batch,estimated_cost_us");
+
+		bench_autotune(report, threads, popSize, generations);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,254 @@
+#ifndef DE_BENCHMARK_HPP_INCLUDED
+#define DE_BENCHMARK_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+namespace de
+{
+	namespace bench
+	{
+
+		typedef std::chrono::steady_clock bench_clock;
+
+		/**
+		 * 简单的计时器，以秒为单位返回自构造（或重新开始）以来经过的时间。
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		class stopwatch
+		{
+		private:
+			bench_clock::time_point m_start;
+
+		public:
+			stopwatch()
+				: m_start(bench_clock::now())
+			{
+			}
+
+			/**
+			 * 重新开始计时
+			 *
+			 * @author louiehan (10/19/2026)
+			 */
+			void restart() { m_start = bench_clock::now(); }
+
+			/**
+			 * 返回经过的时间（秒）
+			 *
+			 * @author louiehan (10/19/2026)
+			 *
+			 * @return double
+			 */
+			double elapsed() const
+			{
+				return std::chrono::duration< double >(bench_clock::now() - m_start).count();
+			}
+		};
+
+		/**
+		 * 将计算结果写入volatile变量，防止编译器把被测代码当作无用代码删除。
+		 *
+		 * 只应在单线程的测量循环中使用。
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		template< typename T > struct sink
+		{
+			static volatile T value;
+		};
+
+		template< typename T > volatile T sink< T >::value;
+
+		inline void do_not_optimize(double value)
+		{
+			sink< double >::value = value;
+		}
+
+		inline void do_not_optimize(const void* p)
+		{
+			sink< const void* >::value = p;
+		}
+
+		/**
+		 * 测量结果：标定后的迭代次数和每次操作耗时的中位数（纳秒）。
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		struct measurement
+		{
+			size_t iterations;
+			double ns_per_op;
+		};
+
+		/**
+		 * 测量一个操作的耗时。
+		 *
+		 * 先把迭代次数加倍直到单次采样的耗时超过minTime，然后重复采样samples次，
+		 * 取每次操作耗时的中位数，以减少调度和缓存带来的抖动。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param f 函数对象，f(iterations)执行iterations次被测操作
+		 * @param minTime 单次采样的最短时间（秒）
+		 * @param samples 采样次数
+		 *
+		 * @return measurement
+		 */
+		template< typename F > measurement measure(F f, double minTime = 0.05, size_t samples = 5)
+		{
+			assert(samples > 0);
+
+			size_t iterations = 1;
+
+			for (;;)
+			{
+				stopwatch sw;
+				f(iterations);
+				if (sw.elapsed() >= minTime || iterations >= (size_t(1) << 40))
+					break;
+
+				iterations *= 2;
+			}
+
+			std::vector< double > ns;
+			for (size_t s = 0; s < samples; ++s)
+			{
+				stopwatch sw;
+				f(iterations);
+				ns.push_back(sw.elapsed() * 1.0e9 / iterations);
+			}
+
+			std::sort(ns.begin(), ns.end());
+
+			measurement m = { iterations, ns[ns.size() / 2] };
+			return m;
+		}
+
+		/**
+		 * 测量一个带有准备步骤的操作，并扣除准备步骤本身的耗时。
+		 *
+		 * 用于每次迭代之前都必须恢复输入数据的操作（例如会修改种群的选择策略）。
+		 *
+		 * @author louiehan (10/19/2026)
+		 *
+		 * @param setup 函数对象，setup(iterations)只执行准备步骤
+		 * @param f 函数对象，f(iterations)执行准备步骤和被测操作
+		 * @param minTime 单次采样的最短时间（秒）
+		 *
+		 * @return measurement
+		 */
+		template< typename S, typename F > measurement measure_net(S setup, F f, double minTime = 0.05)
+		{
+			measurement total(measure(f, minTime));
+			measurement base(measure(setup, minTime));
+
+			total.ns_per_op = std::max(0.0, total.ns_per_op - base.ns_per_op);
+			return total;
+		}
+
+		/**
+		 * 以CSV格式输出测量结果。
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		class csv_report
+		{
+		private:
+			std::ostream& m_os;
+
+		public:
+			/**
+			 * 构造函数，立即输出表头
+			 *
+			 * @author louiehan (10/19/2026)
+			 *
+			 * @param os 输出流
+			 * @param header 以逗号分隔的列名
+			 */
+			csv_report(std::ostream& os, const std::string& header)
+				: m_os(os)
+			{
+				m_os << header << std::endl;
+			}
+
+			/**
+			 * 输出一行，各个字段以逗号分隔
+			 *
+			 * @author louiehan (10/19/2026)
+			 */
+			template< typename... Args > void row(const Args&... args)
+			{
+				std::ostringstream os;
+				write(os, args...);
+				m_os << os.str() << std::endl;
+			}
+
+		private:
+			template< typename A > static void write(std::ostringstream& os, const A& a)
+			{
+				os << a;
+			}
+
+			template< typename A, typename... Args > static void write(std::ostringstream& os, const A& a, const Args&... args)
+			{
+				os << a << ',';
+				write(os, args...);
+			}
+		};
+
+		/**
+		 * 生成"name=value"形式的参数描述，用于CSV的参数列。
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		class params
+		{
+		private:
+			std::ostringstream m_os;
+
+		public:
+			template< typename V > params& operator()(const std::string& name, const V& value)
+			{
+				if (!m_os.str().empty())
+					m_os << ';';
+
+				m_os << name << '=' << value;
+				return *this;
+			}
+
+			std::string str() const { return m_os.str(); }
+		};
+
+		/**
+		 * 命令行中的可选项："--name value"，不存在时返回缺省值
+		 *
+		 * @author louiehan (10/19/2026)
+		 */
+		inline std::string option(int argc, char* argv[], const std::string& name, const std::string& def)
+		{
+			for (int n = 1; n + 1 < argc; ++n)
+			{
+				if (name == argv[n])
+					return argv[n + 1];
+			}
+
+			return def;
+		}
+
+	}
+}
+
+#endif //DE_BENCHMARK_HPP_INCLUDED
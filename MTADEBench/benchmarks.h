@@ -0,0 +1,103 @@
+#ifndef DE_BENCHMARKS_H_INCLUDED
+#define DE_BENCHMARKS_H_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+#pragma once
+#endif
+
+/**
+ * 各个基准测试的入口函数，由MTADEBench.cpp根据命令行的第一个参数选择。
+ *
+ * argv[1]为基准测试的名字，其余参数由各个基准测试自行解析；测量结果以CSV格式输出到标准输出。
+ *
+ * @author louiehan (10/19/2026)
+ */
+
+/**
+ * 核心组件的微基准测试：个体队列、Urn、变异策略、约束修复、选择策略和种群最佳个体查找。
+ */
+int micro_benchmark(int argc, char* argv[]);
+
+/**
+ * 处理器集合的强伸缩性和弱伸缩性测试，输出加速比、并行效率和屏障空闲比例。
+ */
+int scaling_benchmark(int argc, char* argv[]);
+
+/**
+ * 变异策略和选择策略的达到目标时间基准测试，输出每个目标的期望运行时间（ERT）或经验累积分布（ECDF）。
+ */
+int ert_benchmark(int argc, char* argv[]);
+
+/**
+ * 有截止时间的运行和停止令牌的延迟测试，输出返回时间超出预算的部分。
+ */
+int deadline_benchmark(int argc, char* argv[]);
+
+/**
+ * 范围约束越界修复方式的吞吐量和收敛性比较。
+ */
+int repair_benchmark(int argc, char* argv[]);
+
+/**
+ * 编译时策略的差分进化与运行时策略的差分进化的开销比较。
+ */
+int policy_benchmark(int argc, char* argv[]);
+
+/**
+ * 非支配排序的吞吐量和多目标差分进化（GDE3）的收敛性测试。
+ */
+int multi_objective_benchmark(int argc, char* argv[]);
+
+/**
+ * 非线性约束的罚函数法与可行性预检（Deb规则、epsilon约束法）的计算次数和收敛性比较。
+ */
+int feasibility_benchmark(int argc, char* argv[]);
+
+/**
+ * 一对一选择时目标函数超过截断代价提前放弃计算的命中率和节省的时间。
+ */
+int cutoff_benchmark(int argc, char* argv[]);
+
+/**
+ * 等待模拟器的目标函数在阻塞的处理器线程和异步处理器集合上的吞吐量比较。
+ */
+int async_benchmark(int argc, char* argv[]);
+
+/**
+ * NUMA放置（线程亲和性、按节点分区的队列、处理器线程中创建的目标函数）的吞吐量比较。
+ */
+int numa_benchmark(int argc, char* argv[]);
+
+/**
+ * 串行计算、固定线程数和自动选择线程数（或内联计算）的吞吐量比较。
+ */
+int autotune_benchmark(int argc, char* argv[]);
+
+/**
+ * 按硬件线程数和按CPU限额确定大小的处理器集合的吞吐量和被CFS限制的时间比较。
+ */
+int quota_benchmark(int argc, char* argv[]);
+
+/**
+ * 在rastrigin上比较不重启的运行和IPOP重启（顺序的和同时进行的）。
+ */
+int ipop_benchmark(int argc, char* argv[]);
+
+/**
+ * 每个作业有自己的处理器集合和多个作业共享一个计算调度器（公平分配和优先级）的比较。
+ */
+int scheduler_benchmark(int argc, char* argv[]);
+
+/**
+ * 每个个体一次调用、每个作业一代一次调用和多个作业的个体合并成一次批量目标函数调用的比较。
+ */
+int coalesce_benchmark(int argc, char* argv[]);
+
+/**
+ * 按索引和按预测耗时从长到短（学习的和给定的耗时模型）计算一代的屏障空闲时间比较。
+ */
+int ordering_benchmark(int argc, char* argv[]);
+
+#endif //DE_BENCHMARKS_H_INCLUDED
@@ -0,0 +1,124 @@
+// coalesce_benchmark.cpp : 把多个差分进化作业的个体合并成批量目标函数调用（evaluation_coalescer）的测试。
+//
+// --jobs个差分进化作业同时运行，每个作业在自己的线程中，目标函数是合成的批量目标函数：
+// 每次调用有--call微秒的固定开销，每个个体再加--item微秒。比较四种方式：
+// per_individual：每个个体一次调用（批大小为1）；
+// per_job：每个作业有自己的合并器，一次调用包含一个作业的一代；
+// shared_nowait：所有作业共享一个合并器，批大小为--batch，不等待（有等待的个体就开始调用）；
+// shared：同上，但最多等待--wait微秒以凑满一批。
+// 输出调用次数、平均批大小、个体的平均等待时间、运行时间和每秒的计算次数。
+//
+
+#include "stdafx.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "differential_evolution.hpp"
+#include "evaluation_coalescer.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	typedef basic_differential_evolution< batch_objective_function_ptr, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		coalesced_evaluator > coalesced_de;
+
+	size_t run_job(evaluation_coalescer_ptr coalescer, size_t job, size_t varCount, size_t popSize, size_t generations)
+	{
+		seed_generator(1 + job);
+
+		constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -100.0, 100.0));
+
+		coalesced_de de(varCount, popSize, coalesced_evaluator(coalescer), constraints, true,
+			max_gen_termination_strategy(generations), tournament_selection_strategy(), mutation_strategy_1(varCount, mutation_strategy_arguments(0.5, 0.9)));
+
+		de.run();
+		return de.evaluations();
+	}
+
+	void bench_coalesce(csv_report& report, size_t jobs, double callCost, double itemCost, size_t batchSize, double wait, size_t popSize, size_t generations)
+	{
+		const size_t varCount(10);
+		const char* methods[] = { "per_individual", "per_job", "shared_nowait", "shared" };
+
+		for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m)
+		{
+			batch_objective_function_ptr of(std::make_shared< synthetic_batch_function >(callCost, itemCost));
+
+			const size_t size(m == 0 ? 1 : m == 1 ? popSize : batchSize);
+			const std::chrono::microseconds maxWait(m == 3 ? static_cast< long long >(wait) : 0);
+
+			// 只有shared方式的作业共享一个合并器
+			std::vector< evaluation_coalescer_ptr > coalescers;
+			for (size_t j = 0; j < (m >= 2 ? 1 : jobs); ++j)
+				coalescers.push_back(std::make_shared< evaluation_coalescer >(of, size, maxWait));
+
+			std::vector< size_t > evaluations(jobs, 0);
+			std::vector< std::thread > runners;
+
+			stopwatch sw;
+
+			for (size_t j = 0; j < jobs; ++j)
+				runners.push_back(std::thread([&, j]() { evaluations[j] = run_job(coalescers[m >= 2 ? 0 : j], j, varCount, popSize, generations); }));
+
+			for (size_t j = 0; j < runners.size(); ++j)
+				runners[j].join();
+
+			const double seconds(sw.elapsed());
+
+			size_t count(0), calls(0);
+			double waitSeconds(0);
+			for (size_t j = 0; j < jobs; ++j)
+				count += evaluations[j];
+
+			for (size_t c = 0; c < coalescers.size(); ++c)
+			{
+				const coalescing_statistics statistics(coalescers[c]->statistics());
+				calls += statistics.calls;
+				waitSeconds += statistics.waitSeconds;
+			}
+
+			report.row(methods[m], params()("jobs", jobs)("call_us", callCost)("item_us", itemCost)("batch", size)("wait_us", maxWait.count())("NP", popSize)("generations", generations).str(),
+				calls, calls > 0 ? double(count) / calls : 0, count > 0 ? waitSeconds / count * 1e6 : 0, seconds, count / seconds);
+		}
+	}
+}
+
+int coalesce_benchmark(int argc, char* argv[])
+{
+	const size_t jobs(std::stoul(option(argc, argv, "--jobs", "8")));
+	const double callCost(std::stod(option(argc, argv, "--call", "200")));
+	const double itemCost(std::stod(option(argc, argv, "--item", "2")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "20")));
+	const size_t batchSize(std::stoul(option(argc, argv, "--batch", std::to_string(std::max< size_t >(1, jobs) * popSize))));
+	const double wait(std::stod(option(argc, argv, "--wait", "1000")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "50")));
+
+	try
+	{
+		csv_report report(std::cout, "method,params,calls,mean_batch,mean_wait_us,seconds,evaluations_per_second");
+
+		bench_coalesce(report, std::max< size_t >(1, jobs), callCost, itemCost, std::max< size_t >(1, batchSize), wait, popSize, generations);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+// cutoff_benchmark.cpp : 截断代价和提前放弃计算的测试。
+//
+// 目标函数是多项式对一组数据点的拟合误差（残差平方和），每个数据点一项。使用一对一的选择时，
+// 差分进化把父个体的代价作为试验个体的截断代价，目标函数在部分和超过截断代价时放弃计算。
+// 比较完整计算和提前放弃两种方式：两者使用相同的种子，应该得到相同的最佳代价；
+// 输出计算次数、提前放弃的比例、实际计算的数据点比例和运行时间。
+//
+
+#include "stdafx.h"
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cmath>
+
+#include "differential_evolution.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	/**
+	 * 多项式拟合误差：sum((p(t_k) - y_k)^2)，p的系数是前D个变量
+	 */
+	class fit_function : public objective_function
+	{
+	private:
+		std::vector< double > m_t;
+		std::vector< double > m_y;
+		const size_t m_degree;
+		const bool m_abort;
+		std::atomic< size_t > m_terms;
+
+	public:
+		using objective_function::operator();
+
+		fit_function(size_t points, size_t degree, bool abort)
+			: objective_function("fit function"), m_t(points), m_y(points), m_degree(degree), m_abort(abort), m_terms(0)
+		{
+			// 数据点来自带噪声的sin，顺序是随机的，部分和在整个数据集上均匀增长
+			for (size_t k = 0; k < points; ++k)
+			{
+				m_t[k] = genrand(-1.0, 1.0);
+				m_y[k] = std::sin(3.0 * m_t[k]) + genrand(-0.05, 0.05);
+			}
+		}
+
+		virtual double operator()(DVectorPtr args)
+		{
+			evaluation_context context;
+			return (*this)(args, context);
+		}
+
+		virtual double operator()(DVectorPtr args, evaluation_context& context)
+		{
+			const bool abort(m_abort && context.has_cutoff());
+			double sum(0);
+			size_t k(0);
+
+			for (; k < m_t.size(); ++k)
+			{
+				double p(0);
+				for (size_t j = m_degree + 1; j-- > 0;)
+					p = p * m_t[k] + (*args)[j];
+
+				sum += (p - m_y[k]) * (p - m_y[k]);
+
+				// 每64个数据点检查一次，比较的开销可以忽略
+				if (abort && (k & 63) == 63 && context.exceeded(sum))
+				{
+					m_terms += k + 1;
+					return context.lose(sum);
+				}
+			}
+
+			m_terms += k;
+			return sum;
+		}
+
+		size_t terms() const { return m_terms; }
+	};
+
+	void bench_cutoff(csv_report& report, size_t points, size_t degree, size_t popSize, size_t generations, size_t threads)
+	{
+		const char* methods[] = { "full", "early_abort" };
+
+		for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m)
+		{
+			seed_generator(1);
+
+			const size_t varCount(degree + 1);
+			std::shared_ptr< fit_function > function(std::make_shared< fit_function >(points, degree, m == 1));
+
+			constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -5.0, 5.0));
+			processors< objective_function_ptr >::processors_ptr _processors(std::make_shared< processors< objective_function_ptr > >(threads, function, std::make_shared< null_processor_listener >()));
+
+			differential_evolution< objective_function_ptr > de(varCount, popSize, _processors, constraints, true,
+				std::make_shared< max_gen_termination_strategy >(generations), std::make_shared< tournament_selection_strategy >(),
+				std::make_shared< mutation_strategy_1 >(varCount, mutation_strategy_arguments(0.5, 0.9)), std::make_shared< quiet_listener >());
+
+			stopwatch sw;
+			de.run();
+			double seconds(sw.elapsed());
+
+			const run_statistics& stats(de.statistics());
+
+			report.row(methods[m], params()("points", points)("degree", degree)("NP", popSize)("generations", generations)("threads", threads).str(),
+				stats.evaluations(), stats.censored_rate(), double(function->terms()) / (double(stats.evaluations()) * points), seconds, de.best()->cost());
+		}
+	}
+}
+
+int cutoff_benchmark(int argc, char* argv[])
+{
+	const size_t points(std::stoul(option(argc, argv, "--points", "10000")));
+	const size_t degree(std::stoul(option(argc, argv, "--degree", "5")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "40")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "300")));
+	const size_t threads(std::stoul(option(argc, argv, "--threads", "1")));
+
+	try
+	{
+		// censored_rate是有截断代价的计算中提前放弃的比例，terms_fraction是实际计算的数据点占完整计算的比例
+		csv_report report(std::cout, "method,params,evaluations,censored_rate,terms_fraction,seconds,best_cost");
+
+		bench_cutoff(report, points, degree, popSize, generations, threads);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+// deadline_benchmark.cpp : 有截止时间的运行（run_for）和停止令牌的延迟测试。
+//
+// 对不同的目标函数耗时、时间预算和取消方式（drain/abandon），测量run_for或停止请求之后
+// 实际返回的时间超出预算的部分（overshoot）。drain的超出时间应不超过一次目标函数计算的时间，
+// abandon应接近于零。每个组合检查最大的超出时间：drain不超过最长的一次计算（cost_us的1.5倍）加--tolerance毫秒，
+// abandon不超过--tolerance毫秒，超出时pass为0，所有组合结束后报告失败并返回1。
+// 线程数超过CPU数时线程轮流运行，drain要等待的不止一次计算，检查没有意义；abandon时被放弃的计算仍占用CPU，
+// 处理器线程加上调用线程超过CPU数时，调用线程偶尔要等一个调度周期才能返回。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <algorithm>
+
+#include "differential_evolution.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	const size_t VAR_COUNT = 10;
+	// 合成函数的耗时在cost的(1 - VARIANCE)到(1 + VARIANCE)倍之间
+	const double VARIANCE = 0.5;
+
+	/**
+	 * 运行一次，返回从开始（或停止请求）到返回的时间超出预算的部分（秒）以及完成的代数
+	 */
+	std::pair< double, size_t > run_once(const synthetic_function& of, size_t threads, size_t popSize, double budget, bool useToken, cancellation mode)
+	{
+		constraints_ptr constraints(std::make_shared< constraints >(VAR_COUNT, -100.0, 100.0));
+		processor_listener_ptr listener(std::make_shared< null_processor_listener >());
+		processors< synthetic_function >::processors_ptr _processors(std::make_shared< processors< synthetic_function > >(threads, of, listener));
+
+		differential_evolution< synthetic_function > de(VAR_COUNT, popSize, _processors, constraints, true,
+			std::make_shared< max_gen_termination_strategy >(size_t(-1)), std::make_shared< tournament_selection_strategy >(),
+			std::make_shared< mutation_strategy_1 >(VAR_COUNT, mutation_strategy_arguments(0.5, 0.9)), std::make_shared< quiet_listener >());
+
+		const std::chrono::duration< double > duration(budget);
+		stopwatch sw;
+
+		if (useToken)
+		{
+			stop_source source;
+			std::thread stopper([&]()
+			{
+				std::this_thread::sleep_for(duration);
+				source.request_stop();
+			});
+
+			de.run_until(std::chrono::steady_clock::time_point::max(), source.token(), mode);
+			double elapsed(sw.elapsed());
+
+			stopper.join();
+			return std::make_pair(elapsed - budget, de.statistics().generation());
+		}
+		else
+		{
+			de.run_for(duration, stop_token(), mode);
+			return std::make_pair(sw.elapsed() - budget, de.statistics().generation());
+		}
+	}
+}
+
+int deadline_benchmark(int argc, char* argv[])
+{
+	const size_t threads(std::stoul(option(argc, argv, "--threads", std::to_string(std::max< size_t >(1, std::thread::hardware_concurrency())))));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "50")));
+	const size_t runs(std::stoul(option(argc, argv, "--runs", "10")));
+	// 调度和唤醒线程的时间，毫秒
+	const double tolerance(std::stod(option(argc, argv, "--tolerance", "5")));
+
+	const double costs[] = { 100, 1000, 10000 };
+	const double budgets[] = { 0.01, 0.05, 0.2 };
+	const cancellation modes[] = { cancellation::drain, cancellation::abandon };
+	const char* modeNames[] = { "drain", "abandon" };
+
+	try
+	{
+		// 在计时之前标定合成负载
+		synthetic_function::iterations_per_microsecond();
+
+		csv_report report(std::cout, "trigger,mode,cost_us,threads,budget_ms,runs,mean_overshoot_ms,max_overshoot_ms,mean_generations,bound_ms,pass");
+
+		size_t failures(0);
+
+		for (int trigger = 0; trigger < 2; ++trigger)
+		{
+			for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+			{
+				for (size_t c = 0; c < sizeof(costs) / sizeof(costs[0]); ++c)
+				{
+					for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); ++b)
+					{
+						synthetic_function of(costs[c], VARIANCE);
+
+						double total(0);
+						double worst(0);
+						double generations(0);
+
+						for (size_t r = 0; r < runs; ++r)
+						{
+							std::pair< double, size_t > result(run_once(of, threads, popSize, budgets[b], trigger == 1, modes[m]));
+
+							total += result.first;
+							worst = r == 0 ? result.first : std::max(worst, result.first);
+							generations += result.second;
+						}
+
+						// drain等待正在进行的计算完成，abandon不等待
+						const double bound(modes[m] == cancellation::drain ? costs[c] * (1 + VARIANCE) / 1000 + tolerance : tolerance);
+						const bool pass(worst * 1000 <= bound);
+						failures += pass ? 0 : 1;
+
+						report.row(trigger == 1 ? "stop_token" : "deadline", modeNames[m], costs[c], threads, budgets[b] * 1000,
+							runs, total / runs * 1000, worst * 1000, generations / runs, bound, pass ? 1 : 0);
+					}
+				}
+			}
+		}
+
+		if (failures > 0)
+		{
+			std::cerr << failures << " configuration(s) exceeded the overshoot bound" << std::endl;
+			return 1;
+		}
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
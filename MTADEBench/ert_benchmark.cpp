@@ -0,0 +1,149 @@
+// ert_benchmark.cpp : 变异策略和选择策略的达到目标时间（ERT）基准测试。
+//
+// 每次运行记录一组目标代价第一次被达到时的计算次数，对重复运行计算期望运行时间（ERT）
+// 和经验累积分布函数（ECDF），按函数和策略输出。计算次数与线程数无关，因此结果只反映
+// 策略本身的收敛速度。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cmath>
+
+#include "experiment.hpp"
+#include "convergence.hpp"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	/**
+	 * 为每次运行创建目标监听器并保存下来的实验执行器
+	 */
+	class ert_runner : public experiment_runner
+	{
+	private:
+		const std::vector< double > m_targets;
+		std::vector< target_listener_ptr > m_listeners;
+
+	public:
+		ert_runner(const sweep_spec& spec, const std::vector< double >& targets)
+			: experiment_runner(spec), m_targets(targets), m_listeners(configs().size() * spec.repetitions)
+		{
+		}
+
+		/**
+		 * 返回一个配置的所有运行的目标监听器
+		 */
+		std::vector< target_listener_ptr > runs(size_t config) const
+		{
+			const size_t repetitions(spec().repetitions);
+			return std::vector< target_listener_ptr >(m_listeners.begin() + config * repetitions, m_listeners.begin() + (config + 1) * repetitions);
+		}
+
+	protected:
+		virtual listener_ptr make_listener(size_t config, size_t repetition)
+		{
+			// 每次运行只写自己的位置，不需要加锁
+			target_listener_ptr listener(std::make_shared< target_listener >(m_targets, configs()[config].popSize, spec().minimize));
+			m_listeners[config * spec().repetitions + repetition] = listener;
+
+			return listener;
+		}
+	};
+
+	std::vector< double > parse_targets(const std::string& str)
+	{
+		std::vector< std::string > values(udstr::bs_split(str, std::string("[\\s,;]+")));
+		std::vector< double > targets;
+
+		for (size_t n = 0; n < values.size(); ++n)
+		{
+			if (!values[n].empty())
+				targets.push_back(std::stod(values[n]));
+		}
+
+		if (targets.empty())
+			throw experiment_exception("no targets in \"" + str + "\"");
+
+		return targets;
+	}
+}
+
+int ert_benchmark(int argc, char* argv[])
+{
+	const std::string specPath(option(argc, argv, "--spec", ""));
+	const std::string report(option(argc, argv, "--report", "ert"));
+	const size_t points(std::stoul(option(argc, argv, "--points", "20")));
+
+	try
+	{
+		const std::vector< double > targets(parse_targets(option(argc, argv, "--targets", "1e2,1e1,1,1e-1,1e-2,1e-4,1e-6,1e-8")));
+
+		// 缺省比较所有变异策略和选择策略，规格文件中的参数覆盖缺省值
+		sweep_spec spec;
+		spec.functions = { "sphere", "rastrigin", "rosenbrock" };
+		spec.mutations = { 1, 2, 3, 4, 5, 6 };
+		spec.selections = { "best_parent_child", "tournament" };
+		spec.generations = 300;
+		spec.repetitions = 15;
+
+		if (!specPath.empty())
+			spec.load(specPath);
+
+		if (report != "ert" && report != "ecdf")
+			throw experiment_exception("unknown report \"" + report + "\" - expected ert or ecdf");
+
+		ert_runner runner(spec, targets);
+		runner.run();
+
+		if (report == "ert")
+		{
+			csv_report out(std::cout, "function,mutation,selection,weight,crossover,pop_size,target,successes,runs,ert");
+
+			for (size_t c = 0; c < runner.configs().size(); ++c)
+			{
+				const experiment_config& config(runner.configs()[c]);
+				std::vector< target_listener_ptr > runs(runner.runs(c));
+
+				for (size_t t = 0; t < targets.size(); ++t)
+					out.row(config.function, config.mutation, config.selection, config.weight, config.crossover, config.popSize,
+						targets[t], successes(runs, t), runs.size(), expected_running_time(runs, t));
+			}
+		}
+		else
+		{
+			csv_report out(std::cout, "function,mutation,selection,weight,crossover,pop_size,evaluations,fraction");
+
+			for (size_t c = 0; c < runner.configs().size(); ++c)
+			{
+				const experiment_config& config(runner.configs()[c]);
+				std::vector< target_listener_ptr > runs(runner.runs(c));
+
+				// 计算次数在初始种群和最大计算次数之间按对数均匀取点
+				const double first(double(config.popSize));
+				const double last(double(config.popSize) * (spec.generations + 1));
+
+				for (size_t k = 0; k < points; ++k)
+				{
+					double budget(points > 1 ? first * std::pow(last / first, double(k) / (points - 1)) : last);
+					out.row(config.function, config.mutation, config.selection, config.weight, config.crossover, config.popSize,
+						size_t(budget + 0.5), ecdf(runs, size_t(budget + 0.5)));
+				}
+			}
+		}
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,144 @@
+// feasibility_benchmark.cpp : 非线性约束的可行性预检测试。
+//
+// 在有计算代价的球函数（synthetic_function）上加约束sum(x) >= D，最优解为x = (1, ..., 1)，代价为D。
+// 比较三种处理约束的方式：在目标函数中加罚项（每个试验个体都计算昂贵的目标函数）、
+// Deb的可行性规则和epsilon约束法（违反约束的试验个体在生产者一侧被拒绝，不计算目标函数）。
+// 输出目标函数的计算次数、被拒绝的个体数、运行时间，以及最好个体的代价和违反程度。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "differential_evolution.hpp"
+#include "feasibility.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	/**
+	 * 约束sum(x) >= D的违反程度
+	 */
+	class sum_constraint : public constraint_function
+	{
+	public:
+		virtual double operator()(DVectorPtr args)
+		{
+			double sum(0);
+			for (DVector::size_type j = 0; j < args->size(); ++j)
+				sum += (*args)[j];
+
+			return double(args->size()) - sum;
+		}
+	};
+
+	/**
+	 * 罚函数法：计算目标函数后加上违反程度乘以罚系数
+	 */
+	class penalty_function : public objective_function
+	{
+	private:
+		objective_function_ptr m_function;
+		constraint_function_ptr m_constraint;
+		const double m_penalty;
+
+	public:
+		penalty_function(objective_function_ptr function, constraint_function_ptr constraint, double penalty)
+			: objective_function("penalty function"), m_function(function), m_constraint(constraint), m_penalty(penalty)
+		{
+		}
+
+		virtual double operator()(DVectorPtr args)
+		{
+			return (*m_function)(args) + m_penalty * std::max(0.0, (*m_constraint)(args));
+		}
+	};
+
+	double sphere(const DVector& vars)
+	{
+		double sum(0);
+		for (DVector::size_type j = 0; j < vars.size(); ++j)
+			sum += vars[j] * vars[j];
+
+		return sum;
+	}
+
+	void bench_methods(csv_report& report, size_t varCount, size_t popSize, size_t generations, size_t threads, double cost)
+	{
+		const char* methods[] = { "penalty", "deb", "epsilon" };
+
+		constraint_function_ptr constraint(std::make_shared< sum_constraint >());
+		objective_function_ptr expensive(std::make_shared< synthetic_function >(cost, 0.0));
+
+		for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m)
+		{
+			seed_generator(1);
+
+			const std::string method(methods[m]);
+
+			// epsilon从初始种群的典型违反程度（约D）开始，在前一半的代数内递减到0
+			feasibility_rule_ptr rule;
+			if (method == "deb")
+				rule = std::make_shared< feasibility_rule >(constraint);
+			else if (method == "epsilon")
+				rule = std::make_shared< feasibility_rule >(constraint, double(varCount), generations / 2);
+
+			objective_function_ptr function(rule ? expensive : std::make_shared< penalty_function >(expensive, constraint, 1e3));
+			selection_strategy_ptr selection(rule ? selection_strategy_ptr(std::make_shared< feasibility_selection_strategy >(rule)) : std::make_shared< tournament_selection_strategy >());
+
+			constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -5.0, 5.0));
+			processors< objective_function_ptr >::processors_ptr _processors(std::make_shared< processors< objective_function_ptr > >(threads, function, std::make_shared< null_processor_listener >()));
+
+			differential_evolution< objective_function_ptr > de(varCount, popSize, _processors, constraints, true,
+				std::make_shared< max_gen_termination_strategy >(generations), selection,
+				std::make_shared< mutation_strategy_1 >(varCount, mutation_strategy_arguments(0.5, 0.9)), std::make_shared< quiet_listener >(),
+				population_size_strategy_ptr(), rule);
+
+			stopwatch sw;
+			de.run();
+			double seconds(sw.elapsed());
+
+			const DVectorPtr vars(de.best()->vars());
+
+			report.row(method, params()("D", varCount)("NP", popSize)("generations", generations)("threads", threads)("cost_us", cost).str(),
+				de.statistics().evaluations(), de.rejected(), seconds, sphere(*vars), std::max(0.0, (*constraint)(vars)));
+		}
+	}
+}
+
+int feasibility_benchmark(int argc, char* argv[])
+{
+	const size_t varCount(std::stoul(option(argc, argv, "--d", "10")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "50")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "300")));
+	const size_t threads(std::stoul(option(argc, argv, "--threads", "1")));
+	const double cost(std::stod(option(argc, argv, "--cost", "20")));
+
+	try
+	{
+		// best_cost是最好个体的球函数值（不含罚项），最优值为D；best_violation为0表示可行
+		csv_report report(std::cout, "method,params,evaluations,rejected,seconds,best_cost,best_violation");
+
+		bench_methods(report, varCount, popSize, generations, threads, cost);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
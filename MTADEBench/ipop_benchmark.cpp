@@ -0,0 +1,129 @@
+// ipop_benchmark.cpp : IPOP重启（ipop_restarts< T >）在多峰函数上的测试。
+//
+// 在rastrigin（D维，[-5.12, 5.12]）上用相同的目标函数计算次数预算比较：
+// single：一次不重启的运行，种群规模为--np，直到计算次数用完；
+// ipop：停滞时以两倍的种群规模重启，重启时20%的个体在已知最佳个体附近播种；
+// ipop_concurrent：同样的重启，但--concurrent次运行同时进行，共享同一个处理器集合。
+// 每种方式用不同的种子重复--runs次，输出最终代价的平均值、中位数、最好值，平均的计算次数，以及平均运行时间。
+// 计算次数可以超出预算，最多是每个同时进行的运行的一代。
+// 缺省的种群规模（8）太小，不重启的运行经常过早收敛；种群足够大时不重启的运行本身就能找到最优解。
+//
+
+#include "stdafx.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "differential_evolution.hpp"
+#include "ipop_restarts.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	mutation_strategy_ptr make_mutation(size_t varCount)
+	{
+		return std::make_shared< mutation_strategy_1 >(varCount, mutation_strategy_arguments(0.5, 0.9));
+	}
+
+	void bench_ipop(csv_report& report, size_t varCount, size_t popSize, size_t budget, size_t stagnation, size_t runs, size_t threads, size_t concurrent)
+	{
+		const char* methods[] = { "single", "ipop", "ipop_concurrent" };
+
+		for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m)
+		{
+			std::vector< double > costs;
+			double seconds(0);
+			size_t restarts(0), evaluations(0);
+
+			for (size_t r = 0; r < runs; ++r)
+			{
+				objective_function_ptr of(std::make_shared< rastrigin_function >());
+				constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -5.12, 5.12));
+				processors< objective_function_ptr >::processors_ptr _processors(std::make_shared< processors< objective_function_ptr > >(threads, of, std::make_shared< null_processor_listener >()));
+
+				stopwatch sw;
+
+				if (m == 0)
+				{
+					seed_generator(1000 + r);
+
+					differential_evolution< objective_function_ptr > de(varCount, popSize, _processors, constraints, true,
+						std::make_shared< max_evaluations_termination_strategy >(budget), std::make_shared< tournament_selection_strategy >(),
+						make_mutation(varCount), std::make_shared< quiet_listener >());
+
+					de.run();
+					costs.push_back(de.best()->cost());
+					evaluations += de.evaluations();
+				}
+				else
+				{
+					ipop_options options(popSize);
+					options.maxEvaluations = budget;
+					options.runs = 100;
+					options.maxGenerations = budget;
+					options.stagnationGenerations = stagnation;
+					options.stagnationEpsilon = 1e-8;
+					options.concurrent = m == 2 ? concurrent : 1;
+					options.seed = 1000 + r * 100;
+
+					ipop_restarts< objective_function_ptr > ipop(varCount, _processors, constraints, true, std::make_shared< tournament_selection_strategy >(), make_mutation, options);
+
+					ipop.run();
+					costs.push_back(ipop.best()->cost());
+					restarts += ipop.runs().size();
+					evaluations += ipop.evaluations();
+				}
+
+				seconds += sw.elapsed();
+			}
+
+			std::sort(costs.begin(), costs.end());
+
+			double mean(0);
+			for (size_t n = 0; n < costs.size(); ++n)
+				mean += costs[n] / costs.size();
+
+			report.row(methods[m], params()("D", varCount)("NP", popSize)("budget", budget)("stagnation", stagnation)("threads", threads)("concurrent", m == 2 ? concurrent : 1).str(),
+				runs, double(restarts) / runs, mean, costs[costs.size() / 2], costs.front(), double(evaluations) / runs, seconds / runs);
+		}
+	}
+}
+
+int ipop_benchmark(int argc, char* argv[])
+{
+	const size_t varCount(std::stoul(option(argc, argv, "--d", "10")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "8")));
+	const size_t budget(std::stoul(option(argc, argv, "--evaluations", "200000")));
+	const size_t stagnation(std::stoul(option(argc, argv, "--stagnation", "100")));
+	const size_t runs(std::stoul(option(argc, argv, "--runs", "5")));
+	const size_t threads(std::stoul(option(argc, argv, "--threads", "1")));
+	const size_t concurrent(std::stoul(option(argc, argv, "--concurrent", "4")));
+
+	try
+	{
+		// mean_runs是每次重复的平均运行次数（single为0）
+		csv_report report(std::cout, "method,params,repetitions,mean_runs,mean_cost,median_cost,best_cost,mean_evaluations,mean_seconds");
+
+		bench_ipop(report, varCount, popSize, budget, stagnation, runs, threads, concurrent);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
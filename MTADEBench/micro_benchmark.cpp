@@ -0,0 +1,472 @@
+// micro_benchmark.cpp : 核心组件的微基准测试。
+//
+// 每个组件在一组参数上分别测量，结果按"component,variant,params,iterations,ns_per_op"输出，
+// 以便按组件定位性能退化。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "individual.hpp"
+#include "population.hpp"
+#include "mutation_strategy.hpp"
+#include "selection_strategy.hpp"
+#include "experiment.hpp"
+#include "constraint_table.hpp"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	/**
+	 * Urn是mutation_strategy的受保护的嵌套类，通过派生类将其类型公开给基准测试。
+	 *
+	 * 该类不会被实例化。
+	 */
+	class urn_access : public mutation_strategy
+	{
+	public:
+		typedef mutation_strategy::Urn urn;
+	};
+
+	/**
+	 * 生成一个种群并为每个个体设定随机的代价
+	 */
+	population_ptr make_population(size_t popSize, size_t varCount)
+	{
+		constraints_ptr constraints(std::make_shared< constraints >(varCount, -100.0, 100.0));
+		population_ptr pop(std::make_shared< population >(popSize, varCount, constraints));
+
+		for (population::size_type i = 0; i < pop->size(); ++i)
+			(*pop)[i]->setCost(genrand(0, 1000));
+
+		return pop;
+	}
+
+	/**
+	 * 生成同一类型的约束集合，每个变量的范围都是[-10, 10]
+	 */
+	constraints_ptr make_constraints(const std::string& type, size_t varCount)
+	{
+		constraints_ptr constraints(std::make_shared< constraints >(varCount, -10.0, 10.0));
+
+		DVector values;
+		for (int v = -10; v <= 10; v += 2)
+			values.push_back(v);
+
+		for (constraints::size_type j = 0; j < constraints->size(); ++j)
+		{
+			if (type == "int")
+				(*constraints)[j] = std::make_shared< int_constraint >(-10, 10);
+			else if (type == "set")
+				(*constraints)[j] = std::make_shared< set_constraint >(values);
+			else if (type == "bool")
+				(*constraints)[j] = std::make_shared< boolean_constraint >();
+		}
+
+		return constraints;
+	}
+
+	void bench_individual_queue(csv_report& report, double minTime)
+	{
+		const size_t threadCounts[] = { 1, 2, 4, 8 };
+
+		for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); ++t)
+		{
+			const size_t threads = threadCounts[t];
+			individual_queue queue;
+			individual_ptr ind(std::make_shared< individual >(10));
+
+			// 每次迭代由每个线程各执行一次push_back和pop，按线程总数折算为单次操作的耗时
+			measurement m(measure([&](size_t iterations)
+			{
+				std::vector< std::thread > workers;
+				for (size_t n = 0; n < threads; ++n)
+				{
+					workers.push_back(std::thread([&]()
+					{
+						for (size_t i = 0; i < iterations; ++i)
+						{
+							queue.push_back(ind);
+							queue.pop();
+						}
+					}));
+				}
+
+				for (size_t n = 0; n < workers.size(); ++n)
+					workers[n].join();
+			}, minTime));
+
+			report.row("individual_queue", "push_back+pop", params()("threads", threads).str(), m.iterations, m.ns_per_op / (2 * threads));
+		}
+	}
+
+	void bench_urn(csv_report& report, double minTime)
+	{
+		const size_t sizes[] = { 5, 8, 64, 1024 };
+
+		for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+		{
+			const size_t NP = sizes[s];
+
+			measurement m(measure([&](size_t iterations)
+			{
+				for (size_t i = 0; i < iterations; ++i)
+				{
+					urn_access::urn urn(NP, i % NP);
+					do_not_optimize(double(urn[3]));
+				}
+			}, minTime));
+
+			report.row("Urn", "sample4", params()("NP", NP).str(), m.iterations, m.ns_per_op);
+		}
+	}
+
+	void bench_mutation_strategies(csv_report& report, double minTime)
+	{
+		const size_t varCounts[] = { 2, 10, 100, 1000 };
+		const size_t popSizes[] = { 20, 200 };
+		const double crossovers[] = { 0.1, 0.9 };
+
+		for (size_t n = 1; n <= 5; ++n)
+		{
+			for (size_t d = 0; d < sizeof(varCounts) / sizeof(varCounts[0]); ++d)
+			{
+				for (size_t p = 0; p < sizeof(popSizes) / sizeof(popSizes[0]); ++p)
+				{
+					for (size_t c = 0; c < sizeof(crossovers) / sizeof(crossovers[0]); ++c)
+					{
+						const size_t D = varCounts[d];
+						const size_t NP = popSizes[p];
+
+						population_ptr pop(make_population(NP, D));
+						individual_ptr best(pop->best(true));
+						mutation_strategy_ptr strategy(make_mutation_strategy(n, D, mutation_strategy_arguments(0.5, crossovers[c])));
+
+						measurement m(measure([&](size_t iterations)
+						{
+							for (size_t i = 0; i < iterations; ++i)
+							{
+								mutation_strategy::mutation_info info((*strategy)(*pop, best, i % NP));
+								do_not_optimize(std::get< 0 >(info).get());
+							}
+						}, minTime));
+
+						std::ostringstream variant;
+						variant << "mutation_strategy_" << n;
+
+						report.row("mutation_strategy", variant.str(), params()("D", D)("NP", NP)("CR", crossovers[c]).str(), m.iterations, m.ns_per_op);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * 逐个变量抽随机数的指数交叉，即交叉策略独立出来之前变异策略中的循环，作为比较的基准
+	 */
+	struct per_coordinate_exponential
+	{
+		template< typename F > void operator()(size_t varCount, double CR, F apply)
+		{
+			size_t j = genintrand(0, varCount, true);
+			size_t k = 0;
+
+			do
+			{
+				apply(j);
+
+				j = (j + 1) % varCount;
+				++k;
+			} while (genrand() < CR && k < varCount);
+		}
+	};
+
+	/**
+	 * 逐个变量抽随机数的二项交叉，作为比较的基准
+	 */
+	struct per_coordinate_binomial
+	{
+		template< typename F > void operator()(size_t varCount, double CR, F apply)
+		{
+			const size_t jrand(genintrand(0, varCount, true));
+
+			for (size_t j = 0; j < varCount; ++j)
+			{
+				if (j == jrand || genrand() < CR)
+					apply(j);
+			}
+		}
+	};
+
+	template< typename C > void bench_crossover(csv_report& report, const std::string& variant, double minTime)
+	{
+		const size_t varCounts[] = { 10, 100, 1000 };
+		const double crossovers[] = { 0.1, 0.5, 0.9 };
+
+		for (size_t d = 0; d < sizeof(varCounts) / sizeof(varCounts[0]); ++d)
+		{
+			for (size_t c = 0; c < sizeof(crossovers) / sizeof(crossovers[0]); ++c)
+			{
+				const size_t D = varCounts[d];
+				const double CR = crossovers[c];
+
+				C crossover;
+				size_t selected(0);
+
+				measurement m(measure([&](size_t iterations)
+				{
+					for (size_t i = 0; i < iterations; ++i)
+						crossover(D, CR, [&](size_t j) { selected += j + 1; });
+
+					do_not_optimize(double(selected));
+				}, minTime));
+
+				report.row("crossover", variant, params()("D", D)("CR", CR).str(), m.iterations, m.ns_per_op);
+			}
+		}
+	}
+
+	void bench_trial_generation(csv_report& report, double minTime)
+	{
+		const size_t strategies[] = { 1, 6 };
+		const size_t varCounts[] = { 10, 100, 1000 };
+		const double crossovers[] = { 0.1, 0.9 };
+		const size_t NP = 200;
+
+		for (size_t s = 0; s < sizeof(strategies) / sizeof(strategies[0]); ++s)
+		{
+			for (size_t d = 0; d < sizeof(varCounts) / sizeof(varCounts[0]); ++d)
+			{
+				for (size_t c = 0; c < sizeof(crossovers) / sizeof(crossovers[0]); ++c)
+				{
+					const size_t D = varCounts[d];
+
+					population_ptr pop(make_population(NP, D));
+					individual_ptr best(pop->best(true));
+					// 与make_population的范围相同，父个体满足约束
+					constraints_ptr constraints(std::make_shared< de::constraints >(D, -100.0, 100.0));
+					constraint_table_ptr table(std::make_shared< constraint_table >(*constraints));
+
+					// fused：变异策略在生成试验个体时只修复改变了的变量；full_repair：生成之后再检查整个个体
+					for (int fused = 1; fused >= 0; --fused)
+					{
+						mutation_strategy_ptr strategy(make_mutation_strategy(strategies[s], D, mutation_strategy_arguments(0.5, crossovers[c])));
+						strategy->set_constraint_table(fused ? table : constraint_table_ptr());
+
+						measurement m(measure([&](size_t iterations)
+						{
+							for (size_t i = 0; i < iterations; ++i)
+							{
+								mutation_strategy::mutation_info info((*strategy)(*pop, best, i % NP));
+
+								if (!fused)
+									table->repair(*std::get< 0 >(info)->vars(), *std::get< 1 >(info));
+
+								do_not_optimize(std::get< 0 >(info).get());
+							}
+						}, minTime));
+
+						std::ostringstream variant;
+						variant << "mutation_strategy_" << strategies[s] << (fused ? "_fused" : "_full_repair");
+
+						report.row("trial_generation", variant.str(), params()("D", D)("NP", NP)("CR", crossovers[c]).str(), m.iterations, m.ns_per_op);
+					}
+				}
+			}
+		}
+	}
+
+	void bench_ensure_constraints(csv_report& report, double minTime)
+	{
+		const char* types[] = { "real", "int", "set", "bool" };
+		const size_t varCounts[] = { 10, 100, 1000 };
+		const double outOfRange[] = { 0.0, 0.5 };
+
+		for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t)
+		{
+			for (size_t d = 0; d < sizeof(varCounts) / sizeof(varCounts[0]); ++d)
+			{
+				for (size_t o = 0; o < sizeof(outOfRange) / sizeof(outOfRange[0]); ++o)
+				{
+					const size_t D = varCounts[d];
+					constraints_ptr constraints(make_constraints(types[t], D));
+
+					// 一部分变量越界，修复后每次迭代前都要恢复原值
+					DVector input(D);
+					for (size_t j = 0; j < D; ++j)
+						input[j] = genrand() < outOfRange[o] ? genrand(10.0, 20.0) : genrand(-10.0, 10.0);
+
+					DVectorPtr origin(std::make_shared< DVector >(D, 0.0));
+					individual ind(D);
+
+					measurement m(measure_net([&](size_t iterations)
+					{
+						for (size_t i = 0; i < iterations; ++i)
+						{
+							*ind.vars() = input;
+							do_not_optimize(ind.vars().get());
+						}
+					},
+						[&](size_t iterations)
+					{
+						for (size_t i = 0; i < iterations; ++i)
+						{
+							*ind.vars() = input;
+							ind.ensureConstraints(constraints, origin);
+							do_not_optimize(ind.vars().get());
+						}
+					}, minTime));
+
+					report.row("ensureConstraints", types[t], params()("D", D)("out_of_range", outOfRange[o]).str(), m.iterations, m.ns_per_op);
+
+					// 同样的修复，由扁平约束表完成
+					constraint_table table(*constraints);
+
+					measurement mt(measure_net([&](size_t iterations)
+					{
+						for (size_t i = 0; i < iterations; ++i)
+						{
+							*ind.vars() = input;
+							do_not_optimize(ind.vars().get());
+						}
+					},
+						[&](size_t iterations)
+					{
+						for (size_t i = 0; i < iterations; ++i)
+						{
+							*ind.vars() = input;
+							table.repair(*ind.vars(), *origin);
+							do_not_optimize(ind.vars().get());
+						}
+					}, minTime));
+
+					report.row("constraint_table", types[t], params()("D", D)("out_of_range", outOfRange[o]).str(), mt.iterations, mt.ns_per_op);
+				}
+			}
+		}
+	}
+
+	template< typename S > void bench_selection_strategy(csv_report& report, const std::string& variant, double minTime)
+	{
+		const size_t popSizes[] = { 20, 200, 2000 };
+
+		for (size_t p = 0; p < sizeof(popSizes) / sizeof(popSizes[0]); ++p)
+		{
+			const size_t NP = popSizes[p];
+
+			const population_ptr parents(make_population(NP, 10));
+			const population_ptr children(make_population(NP, 10));
+
+			population_ptr pop1(std::make_shared< population >(*parents));
+			population_ptr pop2(std::make_shared< population >(*children));
+			individual_ptr best;
+			S strategy;
+
+			// 选择策略会重排或交换种群，每次迭代之前从原始种群复制指针
+			auto reset = [&]()
+			{
+				pop1->assign(parents->begin(), parents->end());
+				pop2->assign(children->begin(), children->end());
+				best = (*parents)[0];
+			};
+
+			measurement m(measure_net([&](size_t iterations)
+			{
+				for (size_t i = 0; i < iterations; ++i)
+				{
+					reset();
+					do_not_optimize(best.get());
+				}
+			},
+				[&](size_t iterations)
+			{
+				for (size_t i = 0; i < iterations; ++i)
+				{
+					reset();
+					strategy(pop1, pop2, best, true);
+					do_not_optimize(best.get());
+				}
+			}, minTime));
+
+			report.row("selection_strategy", variant, params()("NP", NP).str(), m.iterations, m.ns_per_op);
+		}
+	}
+
+	void bench_population_best(csv_report& report, double minTime)
+	{
+		const size_t popSizes[] = { 20, 200, 2000, 20000 };
+
+		for (size_t p = 0; p < sizeof(popSizes) / sizeof(popSizes[0]); ++p)
+		{
+			const size_t NP = popSizes[p];
+			population_ptr pop(make_population(NP, 10));
+
+			measurement m(measure([&](size_t iterations)
+			{
+				for (size_t i = 0; i < iterations; ++i)
+					do_not_optimize(pop->best(i % 2 == 0).get());
+			}, minTime));
+
+			report.row("population", "best", params()("NP", NP).str(), m.iterations, m.ns_per_op);
+		}
+	}
+}
+
+int micro_benchmark(int argc, char* argv[])
+{
+	const std::string component(argc > 2 && std::string(argv[2]).compare(0, 2, "--") != 0 ? argv[2] : "");
+	const double minTime(std::stod(option(argc, argv, "--min-time", "0.05")));
+
+	try
+	{
+		csv_report report(std::cout, "component,variant,params,iterations,ns_per_op");
+
+		if (component.empty() || component == "individual_queue")
+			bench_individual_queue(report, minTime);
+
+		if (component.empty() || component == "Urn")
+			bench_urn(report, minTime);
+
+		if (component.empty() || component == "mutation_strategy")
+			bench_mutation_strategies(report, minTime);
+
+		if (component.empty() || component == "crossover")
+		{
+			bench_crossover< per_coordinate_exponential >(report, "per_coordinate_exponential", minTime);
+			bench_crossover< exponential_crossover >(report, "exponential", minTime);
+			bench_crossover< per_coordinate_binomial >(report, "per_coordinate_binomial", minTime);
+			bench_crossover< binomial_crossover >(report, "binomial", minTime);
+		}
+
+		if (component.empty() || component == "trial_generation")
+			bench_trial_generation(report, minTime);
+
+		if (component.empty() || component == "ensureConstraints" || component == "constraint_table")
+			bench_ensure_constraints(report, minTime);
+
+		if (component.empty() || component == "selection_strategy")
+		{
+			bench_selection_strategy< best_parent_child_selection_strategy >(report, "best_parent_child", minTime);
+			bench_selection_strategy< tournament_selection_strategy >(report, "tournament", minTime);
+		}
+
+		if (component.empty() || component == "population")
+			bench_population_best(report, minTime);
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,240 @@
+// multi_objective_benchmark.cpp : 非支配排序和多目标差分进化（GDE3）的测试。
+//
+// ranking：对随机的代价向量，比较O(M N^2)的快速非支配排序（Deb等人）与pareto_ranking的ENS-BS排序，
+// 以及pareto_ranking在大种群上的并行版本；
+// gde3：在ZDT1和DTLZ2上运行multi_objective_differential_evolution，用存档到已知Pareto前沿的平均距离衡量收敛性。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cmath>
+
+#include "differential_evolution.hpp"
+#include "multi_objective_differential_evolution.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	/**
+	 * 快速非支配排序（NSGA-II）：两两比较得到每个解被支配的次数和它支配的解，逐层剥离前沿
+	 */
+	size_t fast_non_dominated_sort(const std::vector< const std::vector< double >* >& costs, std::vector< size_t >& rank)
+	{
+		const size_t N(costs.size());
+
+		std::vector< std::vector< size_t > > dominated(N);
+		std::vector< size_t > count(N, 0);
+		std::vector< size_t > current;
+
+		for (size_t p = 0; p < N; ++p)
+		{
+			for (size_t q = 0; q < N; ++q)
+			{
+				if (dominates(*costs[p], *costs[q]))
+					dominated[p].push_back(q);
+				else if (dominates(*costs[q], *costs[p]))
+					++count[p];
+			}
+
+			if (count[p] == 0)
+				current.push_back(p);
+		}
+
+		rank.assign(N, 0);
+		size_t fronts(0);
+
+		while (!current.empty())
+		{
+			std::vector< size_t > next;
+
+			for (size_t n = 0; n < current.size(); ++n)
+			{
+				rank[current[n]] = fronts;
+
+				for (size_t k = 0; k < dominated[current[n]].size(); ++k)
+				{
+					if (--count[dominated[current[n]][k]] == 0)
+						next.push_back(dominated[current[n]][k]);
+				}
+			}
+
+			current.swap(next);
+			++fronts;
+		}
+
+		return fronts;
+	}
+
+	void bench_ranking(csv_report& report, double minTime)
+	{
+		const size_t objectiveCounts[] = { 2, 3, 5 };
+		const size_t sizes[] = { 100, 1000, 10000, 100000 };
+
+		for (size_t o = 0; o < sizeof(objectiveCounts) / sizeof(objectiveCounts[0]); ++o)
+		{
+			for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+			{
+				const size_t M = objectiveCounts[o];
+				const size_t N = sizes[s];
+
+				// 三个以上目标时随机的解大多在少数几个很大的前沿中，前沿分配接近O(M N^2)，只测量到10000个解
+				if (M > 2 && N > 10000)
+					continue;
+
+				std::vector< std::vector< double > > points(N, std::vector< double >(M));
+				for (size_t i = 0; i < N; ++i)
+				{
+					for (size_t m = 0; m < M; ++m)
+						points[i][m] = genrand();
+				}
+
+				std::vector< const std::vector< double >* > costs(N);
+				for (size_t i = 0; i < N; ++i)
+					costs[i] = &points[i];
+
+				pareto_ranking serial(N + 1);
+				pareto_ranking parallel(0);
+
+				measurement ms(measure([&](size_t iterations)
+				{
+					for (size_t i = 0; i < iterations; ++i)
+					{
+						serial(costs);
+						do_not_optimize(serial.rank().data());
+					}
+				}, minTime, 3));
+
+				measurement mp(measure([&](size_t iterations)
+				{
+					for (size_t i = 0; i < iterations; ++i)
+					{
+						parallel(costs);
+						do_not_optimize(parallel.rank().data());
+					}
+				}, minTime, 3));
+
+				const std::string p(params()("M", M)("N", N)("fronts", serial.front_count()).str());
+
+				// 两两比较的排序在大种群上太慢，只测量到10000个解
+				if (N <= 10000)
+				{
+					std::vector< size_t > rank;
+
+					measurement mf(measure([&](size_t iterations)
+					{
+						for (size_t i = 0; i < iterations; ++i)
+						{
+							fast_non_dominated_sort(costs, rank);
+							do_not_optimize(rank.data());
+						}
+					}, minTime, 3));
+
+					report.row("ranking", "fast_non_dominated_sort", p, mf.iterations, mf.ns_per_op, "", "", "");
+				}
+
+				// ENS-BS的时间包括拥挤距离
+				report.row("ranking", "pareto_ranking", p, ms.iterations, ms.ns_per_op, "", "", "");
+				report.row("ranking", "pareto_ranking_parallel", p, mp.iterations, mp.ns_per_op, "", "", "");
+			}
+		}
+	}
+
+	struct problem
+	{
+		const char* name;
+		multi_objective_function_ptr function;
+		size_t varCount;
+	};
+
+	// 存档中每个解到已知Pareto前沿的距离：ZDT1为f2与1 - sqrt(f1)之差，DTLZ2为到单位球面的距离
+	double front_distance(const std::string& name, const std::vector< double >& f)
+	{
+		if (name == "zdt1")
+			return std::fabs(f[1] - (1.0 - std::sqrt(f[0])));
+
+		double norm(0);
+		for (size_t m = 0; m < f.size(); ++m)
+			norm += f[m] * f[m];
+
+		return std::fabs(std::sqrt(norm) - 1.0);
+	}
+
+	void bench_gde3(csv_report& report, size_t popSize, size_t generations, size_t threads)
+	{
+		const problem problems[] =
+		{
+			{ "zdt1", std::make_shared< zdt1_function >(), 30 },
+			{ "dtlz2", std::make_shared< dtlz2_function >(3), 12 },
+		};
+
+		for (size_t p = 0; p < sizeof(problems) / sizeof(problems[0]); ++p)
+		{
+			seed_generator(1);
+
+			constraints_ptr constraints(std::make_shared< de::constraints >(problems[p].varCount, 0.0, 1.0));
+			processors< multi_objective_function_ptr >::processors_ptr _processors(std::make_shared< processors< multi_objective_function_ptr > >(threads, problems[p].function, std::make_shared< null_processor_listener >()));
+
+			multi_objective_differential_evolution< multi_objective_function_ptr > de(problems[p].varCount, popSize, _processors, constraints,
+				std::make_shared< mutation_strategy_1 >(problems[p].varCount, mutation_strategy_arguments(0.5, 0.1)), popSize);
+
+			stopwatch sw;
+			de.run(generations);
+			double seconds(sw.elapsed());
+
+			const std::vector< individual_ptr >& members(de.archive().members());
+
+			double sum(0), worst(0);
+			for (size_t i = 0; i < members.size(); ++i)
+			{
+				const double d(front_distance(problems[p].name, members[i]->costs()));
+				sum += d;
+				worst = std::max(worst, d);
+			}
+
+			report.row("gde3", problems[p].name, params()("D", problems[p].varCount)("NP", popSize)("generations", generations)("threads", threads).str(),
+				de.evaluations(), seconds / de.evaluations() * 1e9, members.size(), sum / members.size(), worst);
+		}
+	}
+}
+
+int multi_objective_benchmark(int argc, char* argv[])
+{
+	const std::string part(argc > 2 && std::string(argv[2]).compare(0, 2, "--") != 0 ? argv[2] : "");
+	const double minTime(std::stod(option(argc, argv, "--min-time", "0.05")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "100")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "250")));
+	const size_t threads(std::stoul(option(argc, argv, "--threads", "1")));
+
+	try
+	{
+		// ranking行的ns_per_op是一次排序的时间，gde3行是每次目标函数计算的时间，iterations为计算次数
+		csv_report report(std::cout, "part,method,params,iterations,ns_per_op,archive_size,mean_front_distance,max_front_distance");
+
+		if (part.empty() || part == "ranking")
+			bench_ranking(report, minTime);
+
+		if (part.empty() || part == "gde3")
+			bench_gde3(report, popSize, generations, threads);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,144 @@
+// numa_benchmark.cpp : NUMA放置（线程亲和性、按节点分区的队列和first touch）的测试。
+//
+// 每个处理器有一个目标函数的实例（目标函数工厂），实例持有一个较大的数据表，每次计算扫描其中的一段。
+// none：处理器线程不绑定，所有实例在调用线程中创建，数据表位于调用线程所在节点的内存中；
+// numa：处理器线程绑定到节点，实例在绑定之后的处理器线程中创建，数据表由所属节点首先访问，
+// 种群按节点分区放入队列。
+// 没有NUMA的机器上可以用--nodes模拟多个节点，此时只能验证正确性和额外的开销，不能期望加速。
+//
+// 选项：--nodes（0表示检测）、--threads、--data-mb（每个实例的数据表大小）、--np、--generations
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "differential_evolution.hpp"
+#include "numa.hpp"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	/**
+	 * 带数据表的球面函数：sum(x_i^2)加上数据表中由变量确定的一段的平均值
+	 */
+	class table_sphere
+	{
+	private:
+		std::vector< double > m_table;
+
+	public:
+		explicit table_sphere(size_t size)
+			: m_table(size)
+		{
+			// 写入整个数据表，页面在这里被首先访问
+			for (size_t k = 0; k < m_table.size(); ++k)
+				m_table[k] = 1e-9 * (k % 1024);
+		}
+
+		double operator()(DVectorPtr args) const
+		{
+			const DVector& x(*args);
+			double sum(0);
+
+			for (size_t j = 0; j < x.size(); ++j)
+				sum += x[j] * x[j];
+
+			// 每次计算读取数据表的八分之一，起点取决于变量
+			const size_t window(m_table.size() / 8);
+			const size_t first(static_cast< size_t >(std::abs(x[0]) * 1e6) % (m_table.size() - window + 1));
+
+			double table(0);
+			for (size_t k = first; k < first + window; ++k)
+				table += m_table[k];
+
+			return sum + table / window;
+		}
+	};
+
+	typedef std::shared_ptr< table_sphere > table_sphere_ptr;
+
+	class table_sphere_factory : public objective_function_factory< table_sphere >
+	{
+	private:
+		const size_t m_size;
+
+	public:
+		explicit table_sphere_factory(size_t size)
+			: m_size(size)
+		{
+		}
+
+		virtual T_ptr make() { return std::make_shared< table_sphere >(m_size); }
+	};
+
+	typedef std::shared_ptr< objective_function_factory< table_sphere > > factory_ptr;
+
+	typedef basic_differential_evolution< factory_ptr, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		parallel_evaluator< factory_ptr > > numa_de;
+
+	void bench_numa(csv_report& report, size_t nodes, size_t threads, size_t dataMb, size_t popSize, size_t generations)
+	{
+		const size_t varCount(10);
+		const numa_topology topology(nodes == 0 ? numa_topology::detect() : numa_topology::emulated(nodes));
+		const char* methods[] = { "none", "numa" };
+
+		for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m)
+		{
+			seed_generator(1);
+
+			numa_placement_ptr placement(m == 1 ? std::make_shared< numa_placement >(topology) : numa_placement_ptr());
+			factory_ptr factory(std::make_shared< table_sphere_factory >(dataMb * 1024 * 1024 / sizeof(double)));
+
+			// 构造和创建实例的时间不计入，none在这里创建所有实例，numa在第一次计算时创建
+			processors< factory_ptr >::processors_ptr _processors(std::make_shared< processors< factory_ptr > >(threads, factory, std::make_shared< null_processor_listener >(), placement));
+			constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -100.0, 100.0));
+
+			numa_de de(varCount, popSize, parallel_evaluator< factory_ptr >(_processors), constraints, true,
+				max_gen_termination_strategy(generations), tournament_selection_strategy(), mutation_strategy_1(varCount, mutation_strategy_arguments(0.5, 0.9)));
+
+			stopwatch sw;
+			de.run();
+			double seconds(sw.elapsed());
+
+			report.row(methods[m], params()("nodes", topology.node_count())("threads", threads)("data_mb", dataMb)("NP", popSize)("generations", generations).str(),
+				de.evaluations(), de.evaluations() / seconds, seconds, de.best()->cost());
+		}
+	}
+}
+
+int numa_benchmark(int argc, char* argv[])
+{
+	const size_t nodes(std::stoul(option(argc, argv, "--nodes", "2")));
+	const size_t threads(std::stoul(option(argc, argv, "--threads", "4")));
+	const size_t dataMb(std::stoul(option(argc, argv, "--data-mb", "16")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "64")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "50")));
+
+	try
+	{
+		// seconds包括numa创建实例的时间；两种方式使用相同的种子，best_cost应该相同
+		csv_report report(std::cout, "method,params,evaluations,evaluations_per_second,seconds,best_cost");
+
+		bench_numa(report, nodes, threads, dataMb, popSize, generations);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+// ordering_benchmark.cpp : 按预测耗时从长到短的顺序计算一代（processors::set_cost_model）的测试。
+//
+// 目标函数的耗时取决于第一个变量：从--cost微秒线性增加到--ratio倍（x0从下界到上界），代价为平方和。
+// 用相同的种子运行相同的差分进化，比较三种顺序：
+// index：按个体的索引放入队列；
+// learned：nearest_neighbor_cost_model从已完成的计算中学习耗时；
+// oracle：function_cost_model直接给出耗时公式。
+// 输出运行时间、每秒的计算次数、每代在屏障处的平均空闲时间和空闲时间占线程时间的比例。
+// 处理器线程数超过CPU数时线程轮流运行，屏障处的空闲时间没有意义。
+//
+
+#include "stdafx.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "cost_model.hpp"
+#include "differential_evolution.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	const double lower(-100), upper(100);
+
+	// 耗时随第一个变量线性变化的目标函数
+	class skewed_function : public objective_function
+	{
+	private:
+		const double m_cost;
+		const double m_ratio;
+
+	public:
+		skewed_function(double cost, double ratio)
+			: objective_function("skewed function"), m_cost(cost), m_ratio(ratio)
+		{
+		}
+
+		virtual double operator()(de::DVectorPtr args)
+		{
+			return synthetic_function(micros(args), 0)(args);
+		}
+
+		double micros(de::DVectorPtr args) const
+		{
+			const double x0 = (*args)[0];
+			const double x(std::min(upper, std::max(lower, x0)));
+			return m_cost * (1 + (m_ratio - 1) * (x - lower) / (upper - lower));
+		}
+	};
+
+	typedef basic_differential_evolution< std::shared_ptr< skewed_function >, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		parallel_evaluator< std::shared_ptr< skewed_function > > > ordering_de;
+
+	void bench_ordering(csv_report& report, size_t threads, double cost, double ratio, size_t popSize, size_t generations)
+	{
+		const size_t varCount(10);
+		const char* methods[] = { "index", "learned", "oracle" };
+
+		std::shared_ptr< skewed_function > of(std::make_shared< skewed_function >(cost, ratio));
+
+		for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m)
+		{
+			seed_generator(1);
+
+			processors< std::shared_ptr< skewed_function > >::processors_ptr _processors(
+				std::make_shared< processors< std::shared_ptr< skewed_function > > >(threads, of, std::make_shared< null_processor_listener >()));
+
+			if (m == 1)
+				_processors->set_cost_model(std::make_shared< nearest_neighbor_cost_model >());
+			else if (m == 2)
+				_processors->set_cost_model(std::make_shared< function_cost_model >([of](DVectorPtr vars) { return of->micros(vars); }));
+
+			constraints_ptr constraints(std::make_shared< de::constraints >(varCount, lower, upper));
+
+			ordering_de de(varCount, popSize, parallel_evaluator< std::shared_ptr< skewed_function > >(_processors), constraints, true,
+				max_gen_termination_strategy(generations), tournament_selection_strategy(), mutation_strategy_1(varCount, mutation_strategy_arguments(0.5, 0.9)));
+
+			stopwatch sw;
+			de.run();
+			const double seconds(sw.elapsed());
+
+			const barrier_statistics& barrier(_processors->barrier());
+
+			report.row(methods[m], params()("threads", threads)("cost_us", cost)("ratio", ratio)("NP", popSize)("generations", generations).str(),
+				seconds, de.evaluations() / seconds, barrier.mean_idle() * 1e3, barrier.idle_fraction());
+		}
+	}
+}
+
+int ordering_benchmark(int argc, char* argv[])
+{
+	const size_t threads(std::stoul(option(argc, argv, "--threads", std::to_string(std::max< unsigned >(1, std::thread::hardware_concurrency())))));
+	const double cost(std::stod(option(argc, argv, "--cost", "100")));
+	const double ratio(std::stod(option(argc, argv, "--ratio", "10")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "20")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "50")));
+
+	try
+	{
+		csv_report report(std::cout, "order,params,seconds,evaluations_per_second,mean_idle_ms,idle_fraction");
+
+		bench_ordering(report, std::max< size_t >(1, threads), cost, std::max(1.0, ratio), popSize, generations);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
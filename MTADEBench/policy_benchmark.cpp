@@ -0,0 +1,240 @@
+// policy_benchmark.cpp : 编译时策略（basic_differential_evolution）与运行时策略（differential_evolution）的开销比较。
+//
+// 在耗时很短的目标函数上运行相同的差分进化（相同的种子、变异、选择和终止条件），比较三种组合：
+// runtime：differential_evolution< T >，共享指针持有的策略，单线程的处理器集合；
+// dynamic_serial：运行时策略的适配器，但在调用线程中串行计算目标函数，隔离出线程同步的开销；
+// policy：具体的策略类型和内联的目标函数对象，没有虚函数调用和线程同步。
+//
+// fixed部分比较只有几个变量的小问题：变量在运行时确定的policy（每个个体一个堆上的vector）
+// 与变量个数在编译时确定的differential_evolution< T, D >（变量存放在个体内的std::array中）。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <array>
+#include <memory>
+#include <string>
+
+#include "differential_evolution.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	/**
+	 * 可以内联的球面函数，使用所有的变量：f(x) = sum(x_i^2)
+	 */
+	struct inline_sphere
+	{
+		double operator()(DVectorPtr args) const
+		{
+			double sum(0);
+			const DVector& x(*args);
+
+			for (size_t j = 0; j < x.size(); ++j)
+				sum += x[j] * x[j];
+
+			return sum;
+		}
+	};
+
+	/**
+	 * 通过虚函数调用的同一个球面函数（sphere_function只使用前两个变量）
+	 */
+	class dynamic_sphere : public objective_function
+	{
+	public:
+		dynamic_sphere()
+			: objective_function("sphere function")
+		{
+		}
+
+		virtual double operator()(DVectorPtr args)
+		{
+			return inline_sphere()(args);
+		}
+	};
+
+	/**
+	 * 固定维数的球面函数
+	 */
+	struct array_sphere
+	{
+		template< size_t D > double operator()(const std::array< double, D >& x) const
+		{
+			double sum(0);
+
+			for (size_t j = 0; j < D; ++j)
+				sum += x[j] * x[j];
+
+			return sum;
+		}
+	};
+
+	typedef basic_differential_evolution< objective_function_ptr, dynamic_mutation, dynamic_selection, dynamic_termination, dynamic_listener, serial_evaluator< objective_function_ptr > > dynamic_serial_de;
+	typedef basic_differential_evolution< inline_sphere, mutation_strategy_1, best_parent_child_selection_strategy, max_gen_termination_strategy > policy_de;
+	typedef basic_differential_evolution< inline_sphere, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy > policy_tournament_de;
+
+	struct result
+	{
+		measurement m;
+		size_t evaluations;
+		double cost;
+	};
+
+	template< typename F > result bench_engine(F run, double minTime)
+	{
+		result r = { { 0, 0 }, 0, 0 };
+
+		r.m = measure([&](size_t iterations)
+		{
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				seed_generator(1);
+				run(r.evaluations, r.cost);
+				do_not_optimize(r.cost);
+			}
+		}, minTime, 3);
+
+		return r;
+	}
+
+	void bench_policy(csv_report& report, size_t popSize, size_t generations, double minTime)
+	{
+		const size_t varCounts[] = { 2, 10, 100 };
+
+		for (size_t d = 0; d < sizeof(varCounts) / sizeof(varCounts[0]); ++d)
+		{
+			const size_t D = varCounts[d];
+			const mutation_strategy_arguments args(0.5, 0.9);
+
+			constraints_ptr constraints(std::make_shared< de::constraints >(D, -100.0, 100.0));
+			objective_function_ptr of(std::make_shared< dynamic_sphere >());
+
+			result runtime(bench_engine([&](size_t& evaluations, double& cost)
+			{
+				processors< objective_function_ptr >::processors_ptr _processors(std::make_shared< processors< objective_function_ptr > >(1, of, std::make_shared< null_processor_listener >()));
+
+				differential_evolution< objective_function_ptr > de(D, popSize, _processors, constraints, true,
+					std::make_shared< max_gen_termination_strategy >(generations), std::make_shared< best_parent_child_selection_strategy >(),
+					std::make_shared< mutation_strategy_1 >(D, args), std::make_shared< quiet_listener >());
+
+				de.run();
+				evaluations = de.evaluations();
+				cost = de.best()->cost();
+			}, minTime));
+
+			result dynamicSerial(bench_engine([&](size_t& evaluations, double& cost)
+			{
+				dynamic_serial_de de(D, popSize, serial_evaluator< objective_function_ptr >(of), constraints, true,
+					dynamic_termination(std::make_shared< max_gen_termination_strategy >(generations)), dynamic_selection(std::make_shared< best_parent_child_selection_strategy >()),
+					dynamic_mutation(std::make_shared< mutation_strategy_1 >(D, args)), dynamic_listener(std::make_shared< quiet_listener >()));
+
+				de.run();
+				evaluations = de.evaluations();
+				cost = de.best()->cost();
+			}, minTime));
+
+			result policy(bench_engine([&](size_t& evaluations, double& cost)
+			{
+				policy_de de(D, popSize, serial_evaluator< inline_sphere >(inline_sphere()), constraints, true,
+					max_gen_termination_strategy(generations), best_parent_child_selection_strategy(), mutation_strategy_1(D, args));
+
+				de.run();
+				evaluations = de.evaluations();
+				cost = de.best()->cost();
+			}, minTime));
+
+			const char* names[] = { "runtime", "dynamic_serial", "policy" };
+			const result* results[] = { &runtime, &dynamicSerial, &policy };
+
+			for (size_t n = 0; n < sizeof(results) / sizeof(results[0]); ++n)
+			{
+				const result& r(*results[n]);
+
+				report.row(names[n], params()("D", D)("NP", popSize)("generations", generations).str(), r.m.iterations, r.m.ns_per_op,
+					r.m.ns_per_op / r.evaluations, runtime.m.ns_per_op / r.m.ns_per_op, r.cost);
+			}
+		}
+	}
+
+	template< size_t D > void bench_fixed(csv_report& report, size_t popSize, size_t generations, double minTime)
+	{
+		const mutation_strategy_arguments args(0.5, 0.9);
+		constraints_ptr constraints(std::make_shared< de::constraints >(D, -100.0, 100.0));
+
+		// 与固定维数的版本相同，使用一对一的选择
+		result policy(bench_engine([&](size_t& evaluations, double& cost)
+		{
+			policy_tournament_de de(D, popSize, serial_evaluator< inline_sphere >(inline_sphere()), constraints, true,
+				max_gen_termination_strategy(generations), tournament_selection_strategy(), mutation_strategy_1(D, args));
+
+			de.run();
+			evaluations = de.evaluations();
+			cost = de.best()->cost();
+		}, minTime));
+
+		result fixed(bench_engine([&](size_t& evaluations, double& cost)
+		{
+			differential_evolution< array_sphere, D > de(popSize, array_sphere(), constraints, true, args);
+
+			de.run(generations);
+			evaluations = de.evaluations();
+			cost = de.best().cost();
+		}, minTime));
+
+		const char* names[] = { "policy", "fixed" };
+		const result* results[] = { &policy, &fixed };
+
+		for (size_t n = 0; n < sizeof(results) / sizeof(results[0]); ++n)
+		{
+			const result& r(*results[n]);
+
+			report.row(names[n], params()("D", D)("NP", popSize)("generations", generations).str(), r.m.iterations, r.m.ns_per_op,
+				r.m.ns_per_op / r.evaluations, policy.m.ns_per_op / r.m.ns_per_op, r.cost);
+		}
+	}
+}
+
+int policy_benchmark(int argc, char* argv[])
+{
+	const std::string part(argc > 2 && std::string(argv[2]).compare(0, 2, "--") != 0 ? argv[2] : "");
+	const double minTime(std::stod(option(argc, argv, "--min-time", "0.2")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "50")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "200")));
+
+	try
+	{
+		// ns_per_op是每次运行（包括构造和初始种群）的时间；三种组合使用相同的种子，best_cost应该相同
+		csv_report report(std::cout, "engine,params,iterations,ns_per_op,ns_per_evaluation,speedup,best_cost");
+
+		if (part.empty() || part == "engine")
+			bench_policy(report, popSize, generations, minTime);
+
+		// fixed行的speedup相对于同一维数的policy行
+		if (part.empty() || part == "fixed")
+		{
+			bench_fixed< 2 >(report, popSize, generations, minTime);
+			bench_fixed< 3 >(report, popSize, generations, minTime);
+			bench_fixed< 5 >(report, popSize, generations, minTime);
+			bench_fixed< 10 >(report, popSize, generations, minTime);
+		}
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
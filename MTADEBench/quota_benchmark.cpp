@@ -0,0 +1,93 @@
+// quota_benchmark.cpp : 按CPU限额（cgroup的cpu.max和亲和性掩码）确定处理器线程数的测试。
+//
+// 先输出检测到的亲和性、CPU限额和不会被限制的线程数；然后用CPU密集的合成目标函数运行相同的差分进化，
+// 比较按硬件线程数（或--threads）创建的处理器集合和auto_workers（按限额确定大小，并监视限额的改变），
+// 输出每秒的计算次数和运行期间被CFS限制的周期数和时间。没有CPU限额时两者的线程数相同或只受亲和性影响。
+//
+
+#include "stdafx.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "differential_evolution.hpp"
+#include "cpu_quota.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	typedef basic_differential_evolution< synthetic_function, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		parallel_evaluator< synthetic_function > > parallel_de;
+
+	void run(csv_report& report, const std::string& method, processors< synthetic_function >::processors_ptr _processors, size_t popSize, size_t generations, double cost)
+	{
+		seed_generator(1);
+
+		const size_t varCount(10);
+		constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -100.0, 100.0));
+
+		parallel_de de(varCount, popSize, parallel_evaluator< synthetic_function >(_processors), constraints, true,
+			max_gen_termination_strategy(generations), tournament_selection_strategy(), mutation_strategy_1(varCount, mutation_strategy_arguments(0.5, 0.9)));
+
+		// 每次运行使用自己的监视器，计数器从这里开始
+		cpu_quota_monitor monitor;
+
+		stopwatch sw;
+		de.run();
+		double seconds(sw.elapsed());
+
+		const cpu_throttling throttling(monitor.throttling());
+
+		report.row(method, params()("cost_us", cost)("NP", popSize)("generations", generations).str(), _processors->size(), de.evaluations() / seconds,
+			throttling.periods, throttling.throttled, throttling.throttledSeconds);
+	}
+}
+
+int quota_benchmark(int argc, char* argv[])
+{
+	const size_t threads(std::stoul(option(argc, argv, "--threads", std::to_string(std::max< size_t >(1, std::thread::hardware_concurrency())))));
+	const double cost(std::stod(option(argc, argv, "--cost", "100")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "64")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "50")));
+
+	try
+	{
+		const cpu_quota quota(cpu_quota::detect());
+		std::cerr << "affinity: " << quota.affinity() << " cpus, limit: " << (quota.limit() > 0 ? std::to_string(quota.limit()) : std::string("none"))
+			<< ", workers: " << quota.workers() << std::endl;
+
+		// 在计时之前标定合成负载
+		synthetic_function::iterations_per_microsecond();
+
+		// throttled_periods和throttled_seconds来自cgroup的cpu.stat，没有cgroup时为0
+		csv_report report(std::cout, "method,params,threads,evaluations_per_second,periods,throttled_periods,throttled_seconds");
+
+		const synthetic_function of(cost, 0.5);
+
+		run(report, "hardware", std::make_shared< processors< synthetic_function > >(threads, of, std::make_shared< null_processor_listener >()), popSize, generations, cost);
+
+		processors< synthetic_function >::processors_ptr sized(std::make_shared< processors< synthetic_function > >(processors< synthetic_function >::auto_workers, of, std::make_shared< null_processor_listener >()));
+		sized->set_quota_monitor(std::make_shared< cpu_quota_monitor >());
+		run(report, "quota", sized, popSize, generations, cost);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
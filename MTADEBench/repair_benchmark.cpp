@@ -0,0 +1,185 @@
+// repair_benchmark.cpp : 范围约束越界修复方式（repair_mode）的吞吐量和收敛性测试。
+//
+// throughput：对每种修复方式、变量类型、变量个数和越界比例，测量约束表修复一个试验个体的时间；
+// convergence：对每种修复方式，在最优解位于定义域内部和边界上的目标函数上运行差分进化，
+// 比较若干次运行后的最佳代价。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "differential_evolution.hpp"
+#include "constraint_table.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	const repair_mode modes[] = { repair_mode::random, repair_mode::reflect, repair_mode::wrap, repair_mode::clamp, repair_mode::midpoint };
+	const char* modeNames[] = { "random", "reflect", "wrap", "clamp", "midpoint" };
+
+	void bench_throughput(csv_report& report, double minTime)
+	{
+		const char* types[] = { "real", "int" };
+		const size_t varCounts[] = { 10, 100, 1000 };
+		const double outOfRange[] = { 0.1, 0.5 };
+
+		for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+		{
+			for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t)
+			{
+				for (size_t d = 0; d < sizeof(varCounts) / sizeof(varCounts[0]); ++d)
+				{
+					for (size_t o = 0; o < sizeof(outOfRange) / sizeof(outOfRange[0]); ++o)
+					{
+						const size_t D = varCounts[d];
+
+						constraints c(D, -10.0, 10.0);
+						for (size_t j = 0; j < D; ++j)
+						{
+							if (t == 0)
+								c[j] = std::make_shared< real_constraint >(-10.0, 10.0, modes[m]);
+							else
+								c[j] = std::make_shared< int_constraint >(-10.0, 10.0, modes[m]);
+						}
+
+						constraint_table table(c);
+
+						// 越界的值可能越过整个范围，用来检验reflect和wrap的取模
+						DVector input(D);
+						DVector origin(D);
+						for (size_t j = 0; j < D; ++j)
+						{
+							input[j] = genrand() < outOfRange[o] ? genrand(10.0, 40.0) * (genrand() < 0.5 ? -1 : 1) : genrand(-10.0, 10.0);
+							origin[j] = genrand(-10.0, 10.0);
+						}
+
+						DVector vars(D);
+
+						measurement mt(measure_net([&](size_t iterations)
+						{
+							for (size_t i = 0; i < iterations; ++i)
+							{
+								vars = input;
+								do_not_optimize(vars.data());
+							}
+						},
+							[&](size_t iterations)
+						{
+							for (size_t i = 0; i < iterations; ++i)
+							{
+								vars = input;
+								table.repair(vars, origin);
+								do_not_optimize(vars.data());
+							}
+						}, minTime));
+
+						report.row("throughput", modeNames[m], params()("type", types[t])("D", D)("out_of_range", outOfRange[o]).str(), mt.iterations, mt.ns_per_op, "", "", "");
+					}
+				}
+			}
+		}
+	}
+
+	struct problem
+	{
+		const char* name;
+		objective_function_ptr function;
+		double min;
+		double max;
+	};
+
+	void bench_convergence(csv_report& report, size_t varCount, size_t popSize, size_t generations, size_t runs)
+	{
+		// 第二个rastrigin问题把定义域截到[0, 5.12]，最优解位于边界上
+		const problem problems[] =
+		{
+			{ "rastrigin", std::make_shared< rastrigin_function >(), -5.12, 5.12 },
+			{ "rastrigin_boundary", std::make_shared< rastrigin_function >(), 0.0, 5.12 },
+			{ "rosenbrock", std::make_shared< rosenbrock_function >(), -30.0, 30.0 },
+		};
+
+		for (size_t p = 0; p < sizeof(problems) / sizeof(problems[0]); ++p)
+		{
+			for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+			{
+				std::vector< double > costs;
+				stopwatch sw;
+
+				for (size_t r = 0; r < runs; ++r)
+				{
+					// 每种修复方式使用相同的种子序列
+					seed_generator(static_cast< unsigned int >(r + 1));
+
+					constraints_ptr constraints(std::make_shared< de::constraints >(varCount, problems[p].min, problems[p].max));
+					constraints->set_repair_mode(modes[m]);
+
+					processor_listener_ptr listener(std::make_shared< null_processor_listener >());
+					processors< objective_function_ptr >::processors_ptr _processors(std::make_shared< processors< objective_function_ptr > >(1, problems[p].function, listener));
+
+					differential_evolution< objective_function_ptr > de(varCount, popSize, _processors, constraints, true,
+						std::make_shared< max_gen_termination_strategy >(generations), std::make_shared< best_parent_child_selection_strategy >(),
+						std::make_shared< mutation_strategy_1 >(varCount, mutation_strategy_arguments(0.5, 0.9)), std::make_shared< quiet_listener >());
+
+					de.run();
+
+					costs.push_back(de.best()->cost());
+				}
+
+				double seconds(sw.elapsed());
+				std::sort(costs.begin(), costs.end());
+
+				double mean(0);
+				for (size_t r = 0; r < costs.size(); ++r)
+					mean += costs[r];
+				mean /= costs.size();
+
+				report.row("convergence", modeNames[m], params()("function", problems[p].name)("D", varCount)("NP", popSize)("generations", generations).str(),
+					runs, seconds / runs * 1e9, mean, costs[costs.size() / 2], costs.front());
+			}
+		}
+	}
+}
+
+int repair_benchmark(int argc, char* argv[])
+{
+	const std::string part(argc > 2 && std::string(argv[2]).compare(0, 2, "--") != 0 ? argv[2] : "");
+	const double minTime(std::stod(option(argc, argv, "--min-time", "0.05")));
+	const size_t varCount(std::stoul(option(argc, argv, "--d", "10")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "50")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "300")));
+	const size_t runs(std::stoul(option(argc, argv, "--runs", "10")));
+
+	try
+	{
+		// throughput行的ns_per_op是每个试验个体的修复时间，convergence行是每次运行的时间
+		csv_report report(std::cout, "part,mode,params,iterations,ns_per_op,mean_cost,median_cost,best_cost");
+
+		if (part.empty() || part == "throughput")
+			bench_throughput(report, minTime);
+
+		if (part.empty() || part == "convergence")
+			bench_convergence(report, varCount, popSize, generations, runs);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
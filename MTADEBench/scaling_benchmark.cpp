@@ -0,0 +1,119 @@
+// scaling_benchmark.cpp : 处理器集合（processors<T>）的强伸缩性和弱伸缩性测试。
+//
+// 强伸缩性：每轮计算固定数量的个体，线程数从1增加到N；
+// 弱伸缩性：每轮计算的个体数与线程数成正比。
+// 目标函数是耗时和耗时变化范围都可调的合成函数，结果按CSV输出加速比、并行效率和屏障空闲比例。
+//
+
+#include "stdafx.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <algorithm>
+
+#include "processors.hpp"
+#include "population.hpp"
+#include "objective_function.h"
+#include "processor_statistics.hpp"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	const size_t VAR_COUNT = 10;
+
+	/**
+	 * 用指定的线程数计算若干轮种群，返回总的运行时间（秒）
+	 */
+	double run_rounds(size_t threads, population_ptr pop, const synthetic_function& of, processor_statistics_listener_ptr listener, size_t rounds)
+	{
+		processors< synthetic_function > _processors(threads, of, listener);
+
+		// 第一轮用于预热，不计时
+		_processors.push(pop);
+		_processors.start();
+		_processors.wait();
+
+		listener->reset();
+
+		double elapsed(0);
+		for (size_t r = 0; r < rounds; ++r)
+		{
+			_processors.push(pop);
+
+			stopwatch sw;
+			_processors.start();
+			_processors.wait();
+			elapsed += sw.elapsed();
+		}
+
+		return elapsed;
+	}
+}
+
+int scaling_benchmark(int argc, char* argv[])
+{
+	const size_t hardwareThreads(std::max< size_t >(1, std::thread::hardware_concurrency()));
+
+	const size_t maxThreads(std::stoul(option(argc, argv, "--threads", std::to_string(hardwareThreads))));
+	const double cost(std::stod(option(argc, argv, "--cost", "100")));
+	const double variance(std::stod(option(argc, argv, "--variance", "0.5")));
+	const size_t individuals(std::stoul(option(argc, argv, "--individuals", "2000")));
+	const size_t perThread(std::stoul(option(argc, argv, "--per-thread", "200")));
+	const size_t rounds(std::stoul(option(argc, argv, "--rounds", "3")));
+
+	try
+	{
+		synthetic_function of(cost, variance);
+		constraints_ptr constraints(std::make_shared< constraints >(VAR_COUNT, -100.0, 100.0));
+
+		// 在计时之前标定合成负载
+		synthetic_function::iterations_per_microsecond();
+
+		csv_report report(std::cout, "mode,threads,individuals,rounds,seconds,speedup,efficiency,idle_fraction,evaluations_per_second");
+
+		const char* modes[] = { "strong", "weak" };
+
+		for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+		{
+			const bool strong(m == 0);
+			double baseThroughput(0);
+
+			for (size_t threads = 1; threads <= maxThreads; ++threads)
+			{
+				const size_t popSize(strong ? individuals : perThread * threads);
+
+				population_ptr pop(std::make_shared< population >(popSize, VAR_COUNT, constraints));
+				processor_statistics_listener_ptr listener(std::make_shared< processor_statistics_listener >(threads));
+
+				double elapsed(run_rounds(threads, pop, of, listener, rounds));
+				double throughput(popSize * rounds / elapsed);
+
+				if (threads == 1)
+					baseThroughput = throughput;
+
+				// 强伸缩性的加速比为T1/Tn；弱伸缩性为按工作量折算的加速比（吞吐量之比）
+				double speedup(throughput / baseThroughput);
+
+				report.row(modes[m], threads, popSize, rounds, elapsed, speedup, speedup / threads, listener->idle_fraction(elapsed), throughput);
+			}
+		}
+	}
+	catch (const processors_exception&)
+	{
+		std::cerr << "an error occurred while running the processors" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+// scheduler_benchmark.cpp : 多个差分进化作业共享一个计算调度器（evaluation_scheduler）的测试。
+//
+// --jobs个小的差分进化作业同时运行，每个作业在自己的线程中，目标函数是耗时--cost微秒的合成函数。比较三种方式：
+// owned：每个作业有自己的处理器集合（--threads个线程），总线程数为jobs * threads；
+// fair_share：所有作业使用同一个调度器（--workers个处理器线程，0表示按CPU限额），按权重平分处理器时间；
+// priority：同一个调度器使用priority策略，一半的作业优先级为1，另一半为0。
+// 输出总的运行时间、每秒的计算次数、作业运行时间的平均值和最大值、高优先级和低优先级作业的平均运行时间，
+// 以及调度器中计算的平均排队时间。
+//
+
+#include "stdafx.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "differential_evolution.hpp"
+#include "evaluation_scheduler.hpp"
+#include "objective_function.h"
+
+#include "benchmark.hpp"
+#include "benchmarks.h"
+
+using namespace de;
+using namespace de::bench;
+
+namespace
+{
+	typedef basic_differential_evolution< synthetic_function, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		parallel_evaluator< synthetic_function > > owned_de;
+	typedef basic_differential_evolution< synthetic_function, mutation_strategy_1, tournament_selection_strategy, max_gen_termination_strategy, quiet_listener,
+		scheduled_evaluator< synthetic_function > > scheduled_de;
+
+	template< typename DE, typename Evaluator > size_t run_job(const Evaluator& evaluator, size_t job, size_t varCount, size_t popSize, size_t generations)
+	{
+		seed_generator(1 + job);
+
+		constraints_ptr constraints(std::make_shared< de::constraints >(varCount, -100.0, 100.0));
+
+		DE de(varCount, popSize, evaluator, constraints, true,
+			max_gen_termination_strategy(generations), tournament_selection_strategy(), mutation_strategy_1(varCount, mutation_strategy_arguments(0.5, 0.9)));
+
+		de.run();
+		return de.evaluations();
+	}
+
+	void bench_scheduler(csv_report& report, size_t jobs, size_t threads, size_t workers, double cost, size_t popSize, size_t generations)
+	{
+		const size_t varCount(10);
+		const synthetic_function of(cost, 0.5);
+		const char* methods[] = { "owned", "fair_share", "priority" };
+
+		for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m)
+		{
+			evaluation_scheduler_ptr scheduler;
+			if (m > 0)
+				scheduler = std::make_shared< evaluation_scheduler >(workers, m == 1 ? scheduling_policy::fair_share : scheduling_policy::priority);
+
+			std::vector< evaluation_scheduler::job_ptr > handles;
+			for (size_t j = 0; scheduler && j < jobs; ++j)
+				handles.push_back(scheduler->add_job(1, m == 2 && j % 2 == 0 ? 1 : 0));
+
+			std::vector< double > seconds(jobs, 0);
+			std::vector< size_t > evaluations(jobs, 0);
+			std::vector< std::thread > runners;
+
+			stopwatch sw;
+
+			for (size_t j = 0; j < jobs; ++j)
+			{
+				runners.push_back(std::thread([&, j]()
+				{
+					stopwatch job;
+
+					if (m == 0)
+					{
+						processors< synthetic_function >::processors_ptr _processors(std::make_shared< processors< synthetic_function > >(threads, of, std::make_shared< null_processor_listener >()));
+						evaluations[j] = run_job< owned_de >(parallel_evaluator< synthetic_function >(_processors), j, varCount, popSize, generations);
+					}
+					else
+						evaluations[j] = run_job< scheduled_de >(scheduled_evaluator< synthetic_function >(handles[j], of), j, varCount, popSize, generations);
+
+					seconds[j] = job.elapsed();
+				}));
+			}
+
+			for (size_t j = 0; j < runners.size(); ++j)
+				runners[j].join();
+
+			const double total(sw.elapsed());
+
+			size_t count(0);
+			double mean(0), high(0), low(0), wait(0);
+			for (size_t j = 0; j < jobs; ++j)
+			{
+				count += evaluations[j];
+				mean += seconds[j] / jobs;
+				(j % 2 == 0 ? high : low) += seconds[j];
+
+				if (scheduler)
+				{
+					const job_metrics metrics(handles[j]->metrics());
+					wait += metrics.waitSeconds;
+					scheduler->remove_job(handles[j]);
+				}
+			}
+
+			const size_t highJobs((jobs + 1) / 2), lowJobs(jobs / 2);
+
+			report.row(methods[m], params()("jobs", jobs)("cost_us", cost)("NP", popSize)("generations", generations).str(),
+				m == 0 ? jobs * threads : scheduler->workers(), total, count / total, mean, *std::max_element(seconds.begin(), seconds.end()),
+				high / highJobs, lowJobs > 0 ? low / lowJobs : 0, count > 0 ? wait / count * 1e6 : 0);
+		}
+	}
+}
+
+int scheduler_benchmark(int argc, char* argv[])
+{
+	const size_t jobs(std::stoul(option(argc, argv, "--jobs", "16")));
+	const size_t threads(std::stoul(option(argc, argv, "--threads", std::to_string(std::max< unsigned >(1, std::thread::hardware_concurrency())))));
+	const size_t workers(std::stoul(option(argc, argv, "--workers", "0")));
+	const double cost(std::stod(option(argc, argv, "--cost", "20")));
+	const size_t popSize(std::stoul(option(argc, argv, "--np", "20")));
+	const size_t generations(std::stoul(option(argc, argv, "--generations", "50")));
+
+	try
+	{
+		// threads是计算目标函数的线程总数；high_seconds和low_seconds是偶数和奇数编号的作业（priority中高和低优先级）的平均运行时间
+		csv_report report(std::cout, "method,params,threads,seconds,evaluations_per_second,mean_job_seconds,max_job_seconds,high_seconds,low_seconds,mean_wait_us");
+
+		bench_scheduler(report, std::max< size_t >(1, jobs), threads, workers, cost, popSize, generations);
+	}
+	catch (const differential_evolution_exception&)
+	{
+		std::cerr << "an error occurred while running differential evolution" << std::endl;
+		return 1;
+	}
+	catch (const de::exception& e)
+	{
+		std::cerr << "an error occurred: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
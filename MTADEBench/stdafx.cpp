@@ -0,0 +1,5 @@
+// stdafx.cpp : 只包括标准包含文件的源文件
+// MTADEBench.pch 将作为预编译头
+// stdafx.obj 将包含预编译类型信息
+
+#include "stdafx.h"